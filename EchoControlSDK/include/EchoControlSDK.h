@@ -1,4 +1,4 @@
-﻿#pragma once
+#pragma once
 #include "EchoControlCode.h"
 
 // =======================================================================
@@ -90,6 +90,12 @@ extern "C" {
     // 频闪: 1=Open, 0=Close
     ECCS_API ECCS_Error ECCS_Light_SetStrobe(ECCS_HANDLE hDev, int isOpen);
 
+    // 以上设置与当前状态相同时不重复下发；此接口强制重发全部设置
+    ECCS_API ECCS_Error ECCS_Light_Refresh(ECCS_HANDLE hDev);
+
+    // 查询状态: 结果通过 ECCS_EVT_LIGHT_STATUS 事件返回
+    ECCS_API ECCS_Error ECCS_Light_QueryStatus(ECCS_HANDLE hDev);
+
     // =======================================================
     // 云台控制
     // =======================================================
@@ -104,6 +110,54 @@ extern "C" {
     // 预置位: action(1=Set, 2=Goto), index(1-255)
     ECCS_API ECCS_Error ECCS_PTZ_Preset(ECCS_HANDLE hDev, int action, int index);
 
+    /**
+     * @brief 云台连续速度控制 (适合摇杆高频调用)
+     * 两轴可同时运动 (斜向)，SDK 只在速度变化时下发指令，并按设备属性 VelMaxRate 限速、
+     * VelKeepalive 周期重发
+     * @param panSpeed  水平速度 (-64~64, 正=右, 负=左, 0=停止)
+     * @param tiltSpeed 俯仰速度 (-63~63, 正=上, 负=下, 0=停止)
+     */
+    ECCS_API ECCS_Error ECCS_PTZ_SetVelocity(ECCS_HANDLE hDev, int panSpeed, int tiltSpeed);
+
+    /**
+     * @brief 云台转到指定角度 (异步)
+     * 结束时触发 ECCS_EVT_PTZ_GOTO_DONE 事件, result: 0=到位, 1=超时, 2=被打断, 3=发送失败
+     * @param pan/tilt  目标角度 (度, 0-360)
+     * @param tolerance 到位判定误差 (度, <=0 使用默认 0.5)
+     */
+    ECCS_API ECCS_Error ECCS_PTZ_GotoAngle(ECCS_HANDLE hDev, float pan, float tilt, float tolerance);
+
+    /**
+     * @brief 地理指向: 所有已标定安装位置的云台转向同一世界坐标
+     * 安装位置由设备属性 InstallLat/InstallLon/InstallAlt/InstallHeading/InstallTilt 配置,
+     * 超出 GeoRange 的云台不参与; 每台云台的定位结果通过 ECCS_EVT_PTZ_GOTO_DONE 返回
+     * 云台登记表为进程全局，包含所有已启动系统中的云台 (hSystem 只用于检查 SDK 已初始化)
+     * @param hSystem 系统句柄 (不限定范围)
+     * @param group   分组号 (设备属性 Group, <0 表示全部)
+     * @param lat/lon 目标经纬度 (度)
+     * @param alt     目标海拔 (米)
+     * @param count   输出: 下发指令的云台数量, 可为 NULL
+     */
+    ECCS_API ECCS_Error ECCS_PTZ_PointAt(ECCS_HANDLE hSystem, int group, double lat, double lon, double alt, int* count);
+
+    /**
+     * @brief 开始预置位巡航 (SDK 侧定时调用预置位)
+     * 手动移动/停止/调用预置位会打断巡航，空闲 TourResume 秒后自动恢复
+     * @param steps 巡航定义 "预置位:停留秒数,...", 如 "1:10,2:10,3:15"; NULL 或空串使用配置属性 Tour
+     */
+    ECCS_API ECCS_Error ECCS_PTZ_TourStart(ECCS_HANDLE hDev, const char* steps);
+
+    ECCS_API ECCS_Error ECCS_PTZ_TourStop(ECCS_HANDLE hDev);
+
+    /**
+     * @brief 读取云台最新角度 (无锁读取，可高频调用)
+     * 角度事件 ECCS_EVT_PTZ_ANGLE 按设备属性 PosInterval/PosDeadband 限速推送，
+     * 此接口始终返回最近一次回报的值
+     * @param pan/tilt/zoom 输出 (度)，可为 NULL
+     * @return ECCS_ERR_DEV_BUSY 尚未收到角度回报
+     */
+    ECCS_API ECCS_Error ECCS_PTZ_GetPosition(ECCS_HANDLE hDev, float* pan, float* tilt, float* zoom);
+
     // =======================================================
     // 强声控制
     // =======================================================
@@ -129,6 +183,68 @@ extern "C" {
      */
     ECCS_API ECCS_Error ECCS_Sound_PushData(ECCS_HANDLE hDev, const char* data, int len);
 
+    /**
+     * @brief 设置 ECCS_Sound_PushData 推送的 PCM 格式 (16bit 交错)
+     * SDK 会重采样并下混到设备格式 (设备属性 AudioRate/AudioChannels) 后再发送
+     * @param sampleRate 采样率 (如 44100/48000)
+     * @param channels   声道数
+     */
+    ECCS_API ECCS_Error ECCS_Sound_SetInputFormat(ECCS_HANDLE hDev, int sampleRate, int channels);
+
+    /**
+     * @brief 注册一路混音源 (多路 PCM 在 SDK 侧叠加后推流, 喊话模式下生效)
+     * @param hDev     设备句柄
+     * @param priority 优先级 (0-255), 有数据的最高优先级源之外的源会被压低 (Ducking)
+     * @param gain     增益 (0.0-2.0, 1.0 为原音量)
+     * @return >=0 混音源ID, <0 失败
+     */
+    ECCS_API int ECCS_Sound_AddSource(ECCS_HANDLE hDev, int priority, float gain);
+
+    ECCS_API ECCS_Error ECCS_Sound_RemoveSource(ECCS_HANDLE hDev, int sourceId);
+
+    // 推送 PCM 数据到指定混音源 (格式与 ECCS_Sound_PushData 相同)
+    ECCS_API ECCS_Error ECCS_Sound_PushSource(ECCS_HANDLE hDev, int sourceId, const char* data, int len);
+
+    ECCS_API ECCS_Error ECCS_Sound_SetSourceGain(ECCS_HANDLE hDev, int sourceId, float gain);
+
+    /**
+     * @brief 推流播放本地 WAV 文件 (16bit PCM, 无需先上传到设备)
+     * 文件作为一路混音源按帧节拍发送, 未开启喊话模式时自动开启
+     * @param path 文件路径
+     * @param loop 1=循环播放
+     * @return >=0 混音源ID (可用 ECCS_Sound_RemoveSource 停止), <0 失败
+     */
+    ECCS_API int ECCS_Sound_StreamFile(ECCS_HANDLE hDev, const char* path, int loop);
+
+    /**
+     * @brief 采集音频回调 (设备麦克风, PCM 16bit, 每次一帧 20ms)
+     * @note 在 SDK 接收线程中调用，请勿在回调中阻塞
+     */
+    typedef void (*ECCS_AudioCallbackFunc)(ECCS_HANDLE hDev, const char* data, int len, void* userCtx);
+
+    // 注册采集音频回调 (需在设备配置中设置 CapturePort), cb 为 NULL 时取消
+    ECCS_API ECCS_Error ECCS_Sound_SetCaptureCallback(ECCS_HANDLE hDev, ECCS_AudioCallbackFunc cb, void* userCtx);
+
+    // 音频链路统计
+    typedef struct {
+        unsigned long long pushBytes;        // 推入字节数 (格式转换后)
+        unsigned long long overrunBytes;     // 缓冲区满被丢弃的字节数
+        unsigned long long underruns;        // 数据流中断次数 (推送速度跟不上播放)
+        unsigned long long framesSent;       // 已发送帧数 (每帧 20ms)
+        unsigned long long framesSuppressed; // 被静音抑制丢弃的帧数
+        unsigned long long sendErrors;       // UDP 发送失败次数
+        unsigned int bufferFill;             // 喊话缓冲当前占用 (字节)
+        unsigned int bufferFillMax;          // 喊话缓冲占用峰值 (字节)
+        unsigned int bufferSize;             // 喊话缓冲容量 (字节)
+        unsigned int latencyHist[12];        // 推送到发送的延迟直方图: [i] 为 2^i~2^(i+1) ms, [0] 含 <1ms
+    } ECCS_AudioStats;
+
+    // 读取音频链路统计 (无锁读取，可高频调用)
+    ECCS_API ECCS_Error ECCS_Sound_GetStats(ECCS_HANDLE hDev, ECCS_AudioStats* stats);
+
+    // 设置指定混音源的 PCM 格式 (同 ECCS_Sound_SetInputFormat)
+    ECCS_API ECCS_Error ECCS_Sound_SetSourceFormat(ECCS_HANDLE hDev, int sourceId, int sampleRate, int channels);
+
     // =======================================================
     // 超声控制
     // =======================================================
@@ -141,6 +257,80 @@ extern "C" {
      */
     ECCS_API ECCS_Error ECCS_Ultrasonic_SetSwitch(ECCS_HANDLE hSystem, int channel, int isOpen);
 
+    /**
+     * @brief 按位掩码一次设置所有超声通道 (单帧下发，状态未变化的通道不重复写入)
+     * @param hSystem 系统句柄
+     * @param mask    bit0=通道1, bit1=通道2... (1=开启, 0=关闭)
+     */
+    ECCS_API ECCS_Error ECCS_Ultrasonic_SetMask(ECCS_HANDLE hSystem, unsigned int mask);
+
+    /**
+     * @brief 读取超声通道状态 (设备应答与周期回读确认的值，可高频调用)
+     * 回读周期由设备属性 PollInterval 配置
+     * @param mask  输出通道状态 (bit0=通道1, 1=开启)，可为 NULL
+     * @param known 输出状态已知的通道掩码，可为 NULL
+     * @return ECCS_ERR_DEV_BUSY 尚无任何通道状态
+     */
+    ECCS_API ECCS_Error ECCS_Ultrasonic_GetState(ECCS_HANDLE hSystem, unsigned int* mask, unsigned int* known);
+
+    // =======================================================
+    // 远程控制网关
+    // =======================================================
+
+    /**
+     * @brief 启动远程控制网关 (TCP，PacketHeader 分帧的 RpcPacket 协议)
+     * 远程客户端发送 Rq* 包控制本机设备；Control/Setting 请求应答 Rp* (Result，cseq 与请求相同)，
+     * 设备推送 (Ow*) 广播给所有客户端。
+     * 每个连接按首帧协商编码: 定长帧，或低带宽链路用的紧凑帧 (varint/变长字符串，见 CompactCodec.h)
+     * 紧凑帧 v2 附带 CRC32C 帧尾，校验失败时断开该连接
+     * @param hSystem 系统句柄
+     * @param port    监听端口
+     * @return ECCS_ERR_DEV_BUSY 网关已启动
+     */
+    ECCS_API ECCS_Error ECCS_Gateway_Start(ECCS_HANDLE hSystem, int port);
+
+    // 停止远程控制网关并断开所有客户端 (ECCS_Release 时自动调用)
+    ECCS_API ECCS_Error ECCS_Gateway_Stop(ECCS_HANDLE hSystem);
+
+    // =======================================================
+    // 缓冲池
+    // =======================================================
+
+    // 收发/编码缓冲池统计 (进程内共享)；持续负载下 misses 不再增长即为无分配稳态
+    typedef struct {
+        unsigned long long hits;        // 复用空闲块
+        unsigned long long misses;      // 新分配
+        unsigned long long oversize;    // 超过 64KB，直接向堆申请
+        unsigned long long trimmed;     // 空闲过多时释放回堆
+        unsigned long long outstanding; // 正在使用的块
+        unsigned long long cachedBytes; // 池中空闲字节 (不含各线程缓存)
+    } ECCS_PoolStats;
+
+    ECCS_API ECCS_Error ECCS_GetPoolStats(ECCS_PoolStats* stats);
+
+    // =======================================================
+    // 日志
+    // =======================================================
+
+    /**
+     * @brief 切换文件日志的写入方式
+     * 异步模式下调用线程只把日志行写入本线程的缓冲，由后台线程成批写文件；
+     * 缓冲写满时调用线程等待，LOG_FATAL 返回前保证已落盘
+     * @param enable      1 异步 / 0 同步 (默认)
+     * @param flushMs     Debug/Info 日志写入文件的最长延迟 (毫秒)，<=0 使用默认 100
+     */
+    ECCS_API ECCS_Error ECCS_Log_SetAsync(int enable, int flushMs);
+
+    /**
+     * @brief 二进制日志 (SDK 内部高频日志点) 不在运行时还原为文本，
+     *        原样写入与日志文件同名的 .blog 文件，用 LogDecoder 离线还原；仅异步模式下生效
+     * @param enable      1 写 .blog / 0 还原后写入文本日志 (默认)
+     */
+    ECCS_API ECCS_Error ECCS_Log_SetBinary(int enable);
+
+    // 等待已提交的日志全部写入文件 (ECCS_Release 时自动调用)
+    ECCS_API ECCS_Error ECCS_Log_Flush();
+
 #ifdef __cplusplus
 }
 #endif
\ No newline at end of file
@@ -1,11 +1,17 @@
-﻿#include "../include/EchoControlSDK.h"
+#include "../include/EchoControlSDK.h"
 #include "../include/EchoControlCode.h"
 #include "debug/Logger.h"
 #include "Version.h"
 #include "config/ConfigManager.h"
 #include "device/DeviceBase.h"
 #include "device/Sound/ISound_Device.h" 
+#include "device/PTZ/IPTZ_Device.h"
+#include "device/PTZ/PtzGeoPointing.h"
+#include "device/Ultrasonic/IUltrasonic_Device.h"
 #include "protocol/Packet_Def.h"
+#include "net/RpcGateway.h"
+#include "utils/buffer_pool.h"
+#include <mutex>
 #include <string.h>
 
 USING_ECCS
@@ -64,6 +70,45 @@ ECCS_Error PostPkt(ECCS_HANDLE hDev, did::DeviceType type, const TVal& val)
     return ECCS_SUCCESS;
 }
 
+// 设备推送分发: 用户回调 + 远程网关
+// 设备只有一个状态回调，创建设备时统一安装 StatusFanoutCallback，此后不再替换
+// (回调会在设备线程和读取线程中调用)；注册/网关启停只在锁内修改 g_fanout
+struct StatusFanout {
+    std::mutex mtx;
+    DeviceBase::StatusCallback userCb;
+    std::shared_ptr<RpcGateway> gateway;
+};
+static StatusFanout g_fanout;
+
+static void StatusFanoutCallback(std::shared_ptr<rpc::RpcPacket> pkt)
+{
+    DeviceBase::StatusCallback userCb;
+    std::shared_ptr<RpcGateway> gateway;
+    {
+        std::lock_guard<std::mutex> lock(g_fanout.mtx);
+        userCb = g_fanout.userCb;
+        gateway = g_fanout.gateway;
+    }
+    if (userCb) userCb(pkt);
+    if (gateway) gateway->Publish(pkt);
+}
+
+// 远程请求路由: 按 Packet ID 中的设备类型投递
+static int RouteRemotePacket(ConfigManager* mgr, const rpc::RawPacketView& view)
+{
+    did::DeviceType type = (did::DeviceType)((view.Id() >> 24) & 0xFF);
+    DeviceBase* dev = InternalFindDevice(mgr, type);
+    if (!dev) return ECCS_ERR_DEV_NOT_FOUND;
+    if (!dev->IsOnline()) return ECCS_ERR_DEV_OFFLINE;
+
+    // 设备异步执行，包对象必须脱离网关的接收缓冲
+    std::shared_ptr<rpc::RpcPacket> pkt = view.Materialize();
+    if (!pkt) return ECCS_ERR_INVALID_PARAM;
+
+    dev->ExecutePacket(pkt);
+    return ECCS_SUCCESS;
+}
+
 // --- 接口实现 ---
 
 extern "C" {
@@ -77,6 +122,7 @@ extern "C" {
         try {
             // 使用默认路径
         	// 建议在 ConfigManager 内部处理路径检查，如果文件不存在抛出异常
+        	ConfigManager::getInstance()->SetGlobalCallback(StatusFanoutCallback);
         	ConfigManager::getInstance()->LoadSystem(DEFAULT_RULE_PATH, DEFAULT_DEV_PATH);
         	return ECCS_SUCCESS;
         }
@@ -88,7 +134,9 @@ extern "C" {
 
     ECCS_API void ECCS_Release() 
     {
+        ECCS_Gateway_Stop(ECCS_GetHandle());
         ConfigManager::getInstance()->Release();
+        Logger::getInstance()->flush();
     }
 
     ECCS_API ECCS_HANDLE ECCS_GetHandle() {
@@ -114,19 +162,23 @@ extern "C" {
                 auto p = std::dynamic_pointer_cast<rpc::OwPtzPosition>(pkt);
                 if (p) cb(hDev, ECCS_EVT_PTZ_ANGLE, &p->data, sizeof(p->data), userCtx);
             }
+            else if (id == rpc::OwPtzGotoDone::_FACTORY_ID_) {
+                auto p = std::dynamic_pointer_cast<rpc::OwPtzGotoDone>(pkt);
+                if (p) cb(hDev, ECCS_EVT_PTZ_GOTO_DONE, &p->data, sizeof(p->data), userCtx);
+            }
+            else if (id == rpc::OwLightStatus::_FACTORY_ID_) {
+                auto p = std::dynamic_pointer_cast<rpc::OwLightStatus>(pkt);
+                if (p) cb(hDev, ECCS_EVT_LIGHT_STATUS, &p->data, sizeof(p->data), userCtx);
+            }
             else if (id == rpc::OwSoundPlayEnd::_FACTORY_ID_) {
                 cb(hDev, ECCS_EVT_SOUND_FINISH, nullptr, 0, userCtx);
             }
         };
 
-        // 假设 ConfigManager 已经有了 SetGlobalCallback 遍历设置给所有设备
-        //mgr->SetGlobalCallback(internalCb);
-
-        // 临时实现：手动遍历设置
-        int count = mgr->GetDeviceCount();
-        for (int i = 0; i < count; ++i) {
-            DeviceBase* dev = mgr->GetDeviceByIndex(i);
-            if (dev) dev->SetStatusCallback(internalCb);
+        // 设备回调在 ECCS_Init 时已指向 g_fanout，这里只替换转发目标
+        {
+            std::lock_guard<std::mutex> lock(g_fanout.mtx);
+            g_fanout.userCb = internalCb;
         }
 
         return ECCS_SUCCESS;
@@ -156,6 +208,16 @@ extern "C" {
         return PostPkt<rpc::RqLightStrobe>(hDev, did::DEVICE_LIGHT, (bool)(isOpen != 0));
     }
 
+    ECCS_API ECCS_Error ECCS_Light_Refresh(ECCS_HANDLE hDev)
+    {
+        return PostPkt<rpc::RqLightRefresh>(hDev, did::DEVICE_LIGHT, rpc::NoneData());
+    }
+
+    ECCS_API ECCS_Error ECCS_Light_QueryStatus(ECCS_HANDLE hDev)
+    {
+        return PostPkt<rpc::RqQueryLightStatus>(hDev, did::DEVICE_LIGHT, rpc::NoneData());
+    }
+
     // --- PTZ ---
     ECCS_API ECCS_Error ECCS_PTZ_Move(ECCS_HANDLE hDev, int action, int speed) 
     {
@@ -175,6 +237,64 @@ extern "C" {
         return PostPkt<rpc::RqPtzPreset>(hDev, did::DEVICE_PTZ, data);
     }
 
+    ECCS_API ECCS_Error ECCS_PTZ_SetVelocity(ECCS_HANDLE hDev, int panSpeed, int tiltSpeed)
+    {
+        if (panSpeed < -64 || panSpeed > 64 || tiltSpeed < -63 || tiltSpeed > 63) return ECCS_ERR_INVALID_PARAM;
+
+        rpc::PtzVelocity data = { (i8)panSpeed, (i8)tiltSpeed };
+        return PostPkt<rpc::RqPtzVelocity>(hDev, did::DEVICE_PTZ, data);
+    }
+
+    ECCS_API ECCS_Error ECCS_PTZ_GotoAngle(ECCS_HANDLE hDev, float pan, float tilt, float tolerance)
+    {
+        rpc::PtzGoto data = { pan, tilt, tolerance };
+        return PostPkt<rpc::RqPtzGoto>(hDev, did::DEVICE_PTZ, data);
+    }
+
+    ECCS_API ECCS_Error ECCS_PTZ_PointAt(ECCS_HANDLE hSystem, int group, double lat, double lon, double alt, int* count)
+    {
+        if (!SafeCast(hSystem)) return ECCS_ERR_NOT_INIT;
+        if (lat < -90.0 || lat > 90.0 || lon < -180.0 || lon > 180.0) return ECCS_ERR_INVALID_PARAM;
+
+        int sent = PtzGeoRegistry::Instance().PointAt(group, lat, lon, alt);
+        if (count) *count = sent;
+        return sent > 0 ? ECCS_SUCCESS : ECCS_ERR_DEV_NOT_FOUND;
+    }
+
+    ECCS_API ECCS_Error ECCS_PTZ_TourStart(ECCS_HANDLE hDev, const char* steps)
+    {
+        rpc::PtzTourCtrl data;
+        memset(&data, 0, sizeof(data));
+        if (steps) {
+            if (strlen(steps) >= sizeof(data.steps)) return ECCS_ERR_INVALID_PARAM;
+            strncpy(data.steps, steps, sizeof(data.steps) - 1);
+        }
+        return PostPkt<rpc::RqPtzTourStart>(hDev, did::DEVICE_PTZ, data);
+    }
+
+    ECCS_API ECCS_Error ECCS_PTZ_TourStop(ECCS_HANDLE hDev)
+    {
+        return PostPkt<rpc::RqPtzTourStop>(hDev, did::DEVICE_PTZ, rpc::NoneData());
+    }
+
+    ECCS_API ECCS_Error ECCS_PTZ_GetPosition(ECCS_HANDLE hDev, float* pan, float* tilt, float* zoom)
+    {
+        ConfigManager* mgr = SafeCast(hDev);
+        auto ptzDev = dynamic_cast<IPTZ_Device*>(InternalFindDevice(mgr, did::DEVICE_PTZ));
+        if (!ptzDev) return ECCS_ERR_DEV_NOT_FOUND;
+
+        const PtzPositionState* state = ptzDev->GetPositionState();
+        if (!state) return ECCS_ERR_NOT_SUPPORTED;
+
+        rpc::PtzPosition pos;
+        if (state->Load(pos) == 0) return ECCS_ERR_DEV_BUSY;
+
+        if (pan) *pan = pos.pan;
+        if (tilt) *tilt = pos.tilt;
+        if (zoom) *zoom = pos.zoom;
+        return ECCS_SUCCESS;
+    }
+
     // --- Sound ---
     ECCS_API ECCS_Error ECCS_Sound_Play(ECCS_HANDLE hDev, const char* filename, int loop) 
     {
@@ -221,6 +341,110 @@ extern "C" {
         return ECCS_ERR_DEV_NOT_FOUND;
     }
 
+    ECCS_API ECCS_Error ECCS_Sound_SetInputFormat(ECCS_HANDLE hDev, int sampleRate, int channels) {
+        return ECCS_Sound_SetSourceFormat(hDev, -1, sampleRate, channels);
+    }
+
+    ECCS_API int ECCS_Sound_AddSource(ECCS_HANDLE hDev, int priority, float gain) {
+        if (priority < 0 || priority > 255) return -1;
+
+        ConfigManager* mgr = SafeCast(hDev);
+        auto soundDev = dynamic_cast<ISound_Device*>(InternalFindDevice(mgr, did::DEVICE_SOUND));
+        if (!soundDev) return -1;
+
+        return soundDev->AddMixSource((u8)priority, gain);
+    }
+
+    ECCS_API ECCS_Error ECCS_Sound_RemoveSource(ECCS_HANDLE hDev, int sourceId) {
+        ConfigManager* mgr = SafeCast(hDev);
+        auto soundDev = dynamic_cast<ISound_Device*>(InternalFindDevice(mgr, did::DEVICE_SOUND));
+        if (!soundDev) return ECCS_ERR_DEV_NOT_FOUND;
+
+        return soundDev->RemoveMixSource(sourceId) ? ECCS_SUCCESS : ECCS_ERR_INVALID_PARAM;
+    }
+
+    ECCS_API ECCS_Error ECCS_Sound_PushSource(ECCS_HANDLE hDev, int sourceId, const char* data, int len) {
+        if (!data || len <= 0) return ECCS_ERR_INVALID_PARAM;
+
+        ConfigManager* mgr = SafeCast(hDev);
+        auto soundDev = dynamic_cast<ISound_Device*>(InternalFindDevice(mgr, did::DEVICE_SOUND));
+        if (!soundDev) return ECCS_ERR_DEV_NOT_FOUND;
+
+        return soundDev->PushMixSource(sourceId, (const u8*)data, (u32)len) ? ECCS_SUCCESS : ECCS_ERR_INVALID_PARAM;
+    }
+
+    ECCS_API ECCS_Error ECCS_Sound_SetSourceGain(ECCS_HANDLE hDev, int sourceId, float gain) {
+        ConfigManager* mgr = SafeCast(hDev);
+        auto soundDev = dynamic_cast<ISound_Device*>(InternalFindDevice(mgr, did::DEVICE_SOUND));
+        if (!soundDev) return ECCS_ERR_DEV_NOT_FOUND;
+
+        return soundDev->SetMixSourceGain(sourceId, gain) ? ECCS_SUCCESS : ECCS_ERR_INVALID_PARAM;
+    }
+
+    ECCS_API int ECCS_Sound_StreamFile(ECCS_HANDLE hDev, const char* path, int loop) {
+        if (!path) return -1;
+
+        ConfigManager* mgr = SafeCast(hDev);
+        auto soundDev = dynamic_cast<ISound_Device*>(InternalFindDevice(mgr, did::DEVICE_SOUND));
+        if (!soundDev) return -1;
+
+        return soundDev->StreamFile(path, loop != 0);
+    }
+
+    ECCS_API ECCS_Error ECCS_Sound_SetCaptureCallback(ECCS_HANDLE hDev, ECCS_AudioCallbackFunc cb, void* userCtx) {
+        ConfigManager* mgr = SafeCast(hDev);
+        auto soundDev = dynamic_cast<ISound_Device*>(InternalFindDevice(mgr, did::DEVICE_SOUND));
+        if (!soundDev) return ECCS_ERR_DEV_NOT_FOUND;
+
+        if (!cb) {
+            soundDev->SetCaptureCallback(nullptr);
+        }
+        else {
+            soundDev->SetCaptureCallback([cb, userCtx, hDev](const u8* data, u32 len) {
+                cb(hDev, (const char*)data, (int)len, userCtx);
+            });
+        }
+        return ECCS_SUCCESS;
+    }
+
+    ECCS_API ECCS_Error ECCS_Sound_GetStats(ECCS_HANDLE hDev, ECCS_AudioStats* stats) {
+        if (!stats) return ECCS_ERR_INVALID_PARAM;
+
+        ConfigManager* mgr = SafeCast(hDev);
+        auto soundDev = dynamic_cast<ISound_Device*>(InternalFindDevice(mgr, did::DEVICE_SOUND));
+        if (!soundDev) return ECCS_ERR_DEV_NOT_FOUND;
+
+        const AudioStats* s = soundDev->GetAudioStats();
+        if (!s) return ECCS_ERR_NOT_SUPPORTED;
+
+        stats->pushBytes = s->pushBytes.load(std::memory_order_relaxed);
+        stats->overrunBytes = s->overrunBytes.load(std::memory_order_relaxed);
+        stats->underruns = s->underruns.load(std::memory_order_relaxed);
+        stats->framesSent = s->framesSent.load(std::memory_order_relaxed);
+        stats->framesSuppressed = s->framesSuppressed.load(std::memory_order_relaxed);
+        stats->sendErrors = s->sendErrors.load(std::memory_order_relaxed);
+        stats->bufferFill = s->fillBytes.load(std::memory_order_relaxed);
+        stats->bufferFillMax = s->fillMax.load(std::memory_order_relaxed);
+        stats->bufferSize = s->bufSize.load(std::memory_order_relaxed);
+
+        static_assert(sizeof(stats->latencyHist) / sizeof(stats->latencyHist[0]) == AudioStats::LATENCY_BUCKETS,
+            "latency bucket count mismatch");
+        for (int i = 0; i < AudioStats::LATENCY_BUCKETS; ++i) {
+            stats->latencyHist[i] = s->latency[i].load(std::memory_order_relaxed);
+        }
+        return ECCS_SUCCESS;
+    }
+
+    ECCS_API ECCS_Error ECCS_Sound_SetSourceFormat(ECCS_HANDLE hDev, int sourceId, int sampleRate, int channels) {
+        if (sampleRate <= 0 || channels <= 0) return ECCS_ERR_INVALID_PARAM;
+
+        ConfigManager* mgr = SafeCast(hDev);
+        auto soundDev = dynamic_cast<ISound_Device*>(InternalFindDevice(mgr, did::DEVICE_SOUND));
+        if (!soundDev) return ECCS_ERR_DEV_NOT_FOUND;
+
+        return soundDev->SetInputFormat(sourceId, (u32)sampleRate, (u32)channels) ? ECCS_SUCCESS : ECCS_ERR_INVALID_PARAM;
+    }
+
     ECCS_API ECCS_Error ECCS_Ultrasonic_SetSwitch(ECCS_HANDLE hSystem, int channel, int isOpen)
     {
         rpc::UltrasonicSwitch data;
@@ -229,4 +453,113 @@ extern "C" {
         return PostPkt<rpc::RqUltrasonicSwitch>(hSystem, did::DEVICE_ULTRASONIC, data);
     }
 
+    ECCS_API ECCS_Error ECCS_Ultrasonic_SetMask(ECCS_HANDLE hSystem, unsigned int mask)
+    {
+        rpc::UltrasonicMask data;
+        data.mask = (u32)mask;
+        return PostPkt<rpc::RqUltrasonicMask>(hSystem, did::DEVICE_ULTRASONIC, data);
+    }
+
+    ECCS_API ECCS_Error ECCS_Ultrasonic_GetState(ECCS_HANDLE hSystem, unsigned int* mask, unsigned int* known)
+    {
+        ConfigManager* mgr = SafeCast(hSystem);
+        auto ultrasonicDev = dynamic_cast<IUltrasonic_Device*>(InternalFindDevice(mgr, did::DEVICE_ULTRASONIC));
+        if (!ultrasonicDev) return ECCS_ERR_DEV_NOT_FOUND;
+
+        u32 state = 0;
+        u32 valid = ultrasonicDev->GetSwitchState(state);
+        if (valid == 0) return ECCS_ERR_DEV_BUSY;
+
+        if (mask) *mask = state;
+        if (known) *known = valid;
+        return ECCS_SUCCESS;
+    }
+
+    // --- Gateway ---
+    ECCS_API ECCS_Error ECCS_Gateway_Start(ECCS_HANDLE hSystem, int port)
+    {
+        ConfigManager* mgr = SafeCast(hSystem);
+        if (!mgr) return ECCS_ERR_NOT_INIT;
+        if (port < 0 || port > 65535) return ECCS_ERR_INVALID_PARAM;
+
+        {
+            std::lock_guard<std::mutex> lock(g_fanout.mtx);
+            if (g_fanout.gateway) return ECCS_ERR_DEV_BUSY; // 已启动
+        }
+
+        auto gateway = std::make_shared<RpcGateway>([mgr](const rpc::RawPacketView& view) {
+            return RouteRemotePacket(mgr, view);
+        });
+        if (!gateway->Start(port)) return ECCS_ERR_FAILED;
+
+        {
+            std::lock_guard<std::mutex> lock(g_fanout.mtx);
+            g_fanout.gateway = gateway;
+        }
+
+        return ECCS_SUCCESS;
+    }
+
+    ECCS_API ECCS_Error ECCS_Gateway_Stop(ECCS_HANDLE hSystem)
+    {
+        if (!SafeCast(hSystem)) return ECCS_ERR_NOT_INIT;
+
+        std::shared_ptr<RpcGateway> gateway;
+        {
+            std::lock_guard<std::mutex> lock(g_fanout.mtx);
+            gateway.swap(g_fanout.gateway);
+        }
+        if (gateway) gateway->Stop();
+
+        return ECCS_SUCCESS;
+    }
+
+    // ==========================================
+    // 缓冲池
+    // ==========================================
+
+    ECCS_API ECCS_Error ECCS_GetPoolStats(ECCS_PoolStats* stats)
+    {
+        if (!stats) return ECCS_ERR_INVALID_PARAM;
+
+        BufferPool::Stats s = BufferPool::Instance().GetStats();
+        stats->hits = s.hits;
+        stats->misses = s.misses;
+        stats->oversize = s.oversize;
+        stats->trimmed = s.trimmed;
+        stats->outstanding = s.outstanding;
+        stats->cachedBytes = s.cachedBytes;
+        return ECCS_SUCCESS;
+    }
+
+    // ==========================================
+    // 日志
+    // ==========================================
+
+    ECCS_API ECCS_Error ECCS_Log_SetAsync(int enable, int flushMs)
+    {
+        Logger* logger = Logger::getInstance();
+        if (enable) {
+            logger->startAsync(64 * 1024, flushMs > 0 ? (u32)flushMs : 100);
+        }
+        else {
+            logger->stopAsync();
+        }
+        return ECCS_SUCCESS;
+    }
+
+    ECCS_API ECCS_Error ECCS_Log_SetBinary(int enable)
+    {
+        if (!Logger::getInstance()->setBinaryOutput(enable != 0)) {
+            return ECCS_ERR_FAILED;
+        }
+        return ECCS_SUCCESS;
+    }
+
+    ECCS_API ECCS_Error ECCS_Log_Flush()
+    {
+        Logger::getInstance()->flush();
+        return ECCS_SUCCESS;
+    }
+
 }
\ No newline at end of file
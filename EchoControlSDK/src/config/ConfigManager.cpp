@@ -52,10 +52,10 @@ int ConfigManager::ParseSlotID(const str& sectionName) {
 
 void ConfigManager::LoadSystem(const str& rulePath, const str& paramPath)
 {
-    m_paramPath = paramPath; // ¼·
+    m_paramPath = paramPath; // 记录路径
     LOG_INFO("ConfigManager: Loading System... Rules: %s, Params: %s", rulePath.c_str(), paramPath.c_str());
 
-    // ع (system_rules.sys)
+    // 加载规则 (system_rules.sys)
     ConfigParser::ConfigParser ruleParser(rulePath);
     if (ruleParser.parseConfigFile()) {
         auto ruleSections = ruleParser.GetAllSections();
@@ -73,7 +73,7 @@ void ConfigManager::LoadSystem(const str& rulePath, const str& paramPath)
         }
     }
 
-    // ز (device_params.dev)
+    // 加载参数 (device_params.dev)
     ConfigParser::ConfigParser devParser(paramPath);
     if (!devParser.parseConfigFile()) {
         throw EIOException("Failed to load param file: %s", paramPath.c_str());
@@ -84,7 +84,7 @@ void ConfigManager::LoadSystem(const str& rulePath, const str& paramPath)
         int slotID = ParseSlotID(secName);
         if (slotID < 0) continue;
 
-        // ״̬
+        // 检查启用状态
         str enableStr = devParser.Get(secName, "Enable");
         if (enableStr != "true" && enableStr != "1") {
             if (m_rules[slotID].isMandatory) {
@@ -93,7 +93,7 @@ void ConfigManager::LoadSystem(const str& rulePath, const str& paramPath)
             continue;
         }
 
-        // ȡؼϢ
+        // 读取关键信息
         str modelName = devParser.Get(secName, "Model");
         str idStr = devParser.Get(secName, "ID");
 
@@ -102,47 +102,50 @@ void ConfigManager::LoadSystem(const str& rulePath, const str& paramPath)
             continue;
         }
 
-        // --- У߼ ---
+        // --- 核心校验逻辑 ---
 
-        // ȡ׼ OID
+        // 查表获取标准 OID
         u32 expectedOID = GetDeviceOIDByModelName(modelName);
         if (expectedOID == DeviceID::INVALID_ID) {
             LOG_ERROR("[ConfigManager] Slot %d Unknown Model: %s", slotID, modelName.c_str());
             continue;
         }
 
-        //  ID
+        // 解析配置 ID
         u32 configFullID = std::strtoul(idStr.c_str(), nullptr, 16);
 
-        // ˫֤ (Model vs ID)
+        // 双向验证 (Model vs ID)
         if (expectedOID != DeviceID::GetOID(configFullID)) {
             LOG_ERROR("[ConfigManager] Slot %d ID Mismatch! Model(%s) != ID(%s)", slotID, modelName.c_str(), idStr.c_str());
             continue;
         }
 
-        // Index ֤
+        // Index 验证
         if (DeviceID::GetIndex(configFullID) < 1) {
             LOG_ERROR("[ConfigManager] Slot %d Invalid Index in ID %s (Must >= 1)", slotID, idStr.c_str());
             continue;
         }
 
-        // --- 豸 ---
+        // --- 创建设备 ---
         DeviceBase* dev = FACTORY_CREATE(expectedOID, DeviceBase);
 
         if (dev) {
-            //  Map
+            // 构造配置 Map
             //std::map<str, str> confMap;
-            // ֶȡͨ
+            // 手动提取通用属性
             //confMap["ID"] = idStr;
             //confMap["IP"] = devParser.Get(secName, "IP");
             //confMap["Port"] = devParser.Get(secName, "Port");
             //confMap["Name"] = devParser.Get(secName, "Name");
             //confMap["Baud"] = devParser.Get(secName, "Baud");
-            //  Enable ״̬
+            // 传入 Enable 状态
             //confMap["Enable"] = enableStr;
-            // Զȡͨ
+            // 自动提取通用属性
             std::map<str, str> confMap = devParser.GetSection(secName);
 
+            // 状态回调在 Init 前安装: Init 中即可能推送状态，之后由设备线程/读取线程调用
+            if (m_globalCb) dev->SetStatusCallback(m_globalCb);
+
             if (dev->Init(slotID, confMap)) {
                 dev->Start();
                 m_devices[slotID] = dev;
@@ -162,13 +165,13 @@ void ConfigManager::LoadSystem(const str& rulePath, const str& paramPath)
 bool ConfigManager::UpdateConfig(int slotID, const str& key, const str& value) {
     if (m_paramPath.empty()) return false;
 
-    // ¼ؽ (߱һԱ)
+    // 重新加载解析器 (或者保持一个成员变量)
     ConfigParser::ConfigParser parser(m_paramPath);
     if (!parser.parseConfigFile()) return false;
 
     str section = "Slot_" + std::to_string(slotID);
 
-    // ڴļ
+    // 更新内存和文件
     if (parser.Set(section, key, value)) {
         return parser.writeValueToFile();
     }
@@ -177,12 +180,7 @@ bool ConfigManager::UpdateConfig(int slotID, const str& key, const str& value) {
 
 void ConfigManager::SetGlobalCallback(std::function<void(std::shared_ptr<rpc::RpcPacket>)> cb) 
 {
-    for (auto& pair : m_devices) {
-        if (pair.second) {
-            pair.second->SetStatusCallback(cb);
-        }
-    }
-    // TODO: 豸Ǻ̬ӵģҲҪ cb ֵ
+    m_globalCb = cb;
 }
 
 ECCS_END
\ No newline at end of file
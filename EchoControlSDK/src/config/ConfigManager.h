@@ -8,16 +8,16 @@
 
 ECCS_BEGIN
 
-// ǰѭ
+// 前置声明，避免循环引用
 class DeviceBase;
 
-// λṹ
+// 槽位规则结构
 struct SlotRule {
     bool isMandatory;
     std::vector<str> allowedTypes;
 };
 
-// ϵͳáУ򡢴豸ʵ
+// 负责加载系统配置、校验规则、创建并管理设备实例
 class ConfigManager : public Singleton<ConfigManager>
 {
     friend class Singleton<ConfigManager>;
@@ -29,36 +29,38 @@ private:
 public:
     ~ConfigManager();
 
-    // ڣع(.sys)  (.dev)豸
+    // 核心入口：加载规则(.sys) 和 参数(.dev)，创建设备
     void LoadSystem(const str& rulePath, const str& paramPath);
 
-    // ȡʱ豸ָ
+    // 获取运行时设备指针
     DeviceBase* GetDevice(int slotID);
 
-    //  ECCS_SetConfig Ľӿ
+    // 用于 ECCS_SetConfig 的接口
     bool UpdateConfig(int slotID, const str& key, const str& value);
 
-    // ͷ豸Դ
+    // 释放所有设备资源
     void Release();
 
     int GetDeviceCount() const { return m_devices.size(); }
 
-    // ȡ (ɨ mapȻЧʵ͵ڼʮ豸νұ֤˳ȶ)
+    // 按索引获取 (线性扫描 map，虽然效率低但对于几十个设备无所谓，且保证顺序稳定)
     DeviceBase* GetDeviceByIndex(int index);
 
-    // ȫֻص豸
+    // 设置设备状态回调，LoadSystem 创建设备时在 Init 前安装
+    // (需在 LoadSystem 前调用；设备运行后回调不可替换，更换目标应在回调内部完成)
     void SetGlobalCallback(std::function<void(std::shared_ptr<rpc::RpcPacket>)> cb);
 
 private:
     int ParseSlotID(const str& sectionName);
 
 private:
-    // ļ·ڻд
+    // 保存参数文件路径，用于回写
     str m_paramPath;
 
 private:
     std::map<int, SlotRule> m_rules;
-    std::map<int, DeviceBase*> m_devices; // ϵͳ豸ĳ
+    std::map<int, DeviceBase*> m_devices; // 系统中所有设备的持有者
+    std::function<void(std::shared_ptr<rpc::RpcPacket>)> m_globalCb;
 };
 
 ECCS_END
\ No newline at end of file
@@ -0,0 +1,240 @@
+#include "BinaryLog.h"
+#include <stdio.h>
+#include <time.h>
+#include "../time/sal_chrono.h"
+
+ECCS_BEGIN
+namespace binlog {
+
+// 带截断的追加输出
+class TextOut
+{
+public:
+    TextOut(char* out, size_t cap) : m_out(out), m_cap(cap), m_len(0) { if (cap) out[0] = 0; }
+
+    size_t Length() const { return m_len; }
+
+    void Append(const char* p, size_t n)
+    {
+        if (m_len + 1 >= m_cap) return;
+        if (n > m_cap - 1 - m_len) n = m_cap - 1 - m_len;
+        memcpy(m_out + m_len, p, n);
+        m_len += n;
+        m_out[m_len] = 0;
+    }
+
+    template<typename T>
+    void Print(const char* spec, T v)
+    {
+        if (m_len + 1 >= m_cap) return;
+        int n = snprintf(m_out + m_len, m_cap - m_len, spec, v);
+        if (n < 0) return;
+        m_len += (size_t)n < m_cap - m_len ? (size_t)n : m_cap - m_len - 1;
+    }
+
+private:
+    char*  m_out;
+    size_t m_cap;
+    size_t m_len;
+};
+
+// 按类型码顺序读取参数
+class ArgReader
+{
+public:
+    struct Arg {
+        char   type;    // 0 表示参数已读完或数据不足
+        i64    i;
+        u64    u;
+        double d;
+        char   s[MAX_STRING + 1];
+    };
+
+    ArgReader(const char* types, const u8* p, size_t len) : m_types(types), m_p(p), m_end(p + len) {}
+
+    bool Next(Arg& a)
+    {
+        a.type = 0;
+        if (!*m_types) return false;
+        char t = *m_types++;
+        if (t == 's') {
+            if (m_p >= m_end) return false;
+            size_t n = *m_p++;
+            if ((size_t)(m_end - m_p) < n) return false;
+            memcpy(a.s, m_p, n);
+            a.s[n] = 0;
+            m_p += n;
+        }
+        else {
+            if ((size_t)(m_end - m_p) < 8) return false;
+            if (t == 'd') memcpy(&a.d, m_p, 8);
+            else if (t == 'i') memcpy(&a.i, m_p, 8);
+            else memcpy(&a.u, m_p, 8);
+            m_p += 8;
+        }
+        a.type = t;
+        return true;
+    }
+
+private:
+    const char* m_types;
+    const u8*   m_p;
+    const u8*   m_end;
+};
+
+static i64 AsSigned(const ArgReader::Arg& a)
+{
+    return a.type == 'd' ? (i64)a.d : (a.type == 'i' ? a.i : (i64)a.u);
+}
+
+static u64 AsUnsigned(const ArgReader::Arg& a)
+{
+    return a.type == 'd' ? (u64)a.d : (a.type == 'i' ? (u64)a.i : a.u);
+}
+
+static double AsDouble(const ArgReader::Arg& a)
+{
+    return a.type == 'd' ? a.d : (a.type == 'i' ? (double)a.i : (double)a.u);
+}
+
+size_t FormatArgs(const FormatInfo& info, const u8* args, size_t len, char* out, size_t cap)
+{
+    TextOut w(out, cap);
+    if (info.function && info.function[0]) {
+        w.Print("%s:", info.function);
+        w.Print("%u  ", info.line);
+    }
+
+    ArgReader reader(info.types ? info.types : "", args, len);
+    ArgReader::Arg a;
+    const char* f = info.fmt;
+    while (*f) {
+        if (*f != '%') {
+            const char* run = f;
+            while (*f && *f != '%') ++f;
+            w.Append(run, f - run);
+            continue;
+        }
+        if (f[1] == '%') {
+            w.Append("%", 1);
+            f += 2;
+            continue;
+        }
+
+        // 重建转换说明: 保留标志/宽度/精度，去掉长度修饰后按参数的实际宽度输出
+        const char* start = f++;
+        char spec[48];
+        size_t sl = 0;
+        spec[sl++] = '%';
+        while (*f && strchr("-+ #0", *f) && sl < 16) spec[sl++] = *f++;
+        for (int part = 0; part < 2; ++part) {
+            if (part == 1) {
+                if (*f != '.') break;
+                spec[sl++] = *f++;
+            }
+            if (*f == '*') {
+                ++f;
+                int v = reader.Next(a) ? (int)AsSigned(a) : 0;
+                sl += snprintf(spec + sl, sizeof(spec) - sl, "%d", v);
+            }
+            else {
+                while (*f >= '0' && *f <= '9' && sl < 40) spec[sl++] = *f++;
+            }
+        }
+        while (*f && strchr("hljztLqI", *f)) ++f;
+        char conv = *f;
+        if (!conv) {
+            w.Append(start, f - start);
+            break;
+        }
+        ++f;
+
+        if (!strchr("diouxXcfFeEgGaAspn", conv)) {
+            w.Append(start, f - start);
+            continue;
+        }
+        if (!reader.Next(a)) {
+            w.Append("<?>", 3);
+            continue;
+        }
+
+        switch (conv) {
+        case 'd':
+        case 'i':
+            spec[sl++] = 'l'; spec[sl++] = 'l'; spec[sl++] = conv; spec[sl] = 0;
+            w.Print(spec, (long long)AsSigned(a));
+            break;
+        case 'o':
+        case 'u':
+        case 'x':
+        case 'X':
+            spec[sl++] = 'l'; spec[sl++] = 'l'; spec[sl++] = conv; spec[sl] = 0;
+            w.Print(spec, (unsigned long long)AsUnsigned(a));
+            break;
+        case 'c':
+            spec[sl++] = 'c'; spec[sl] = 0;
+            w.Print(spec, (int)AsSigned(a));
+            break;
+        case 's':
+            spec[sl++] = 's'; spec[sl] = 0;
+            if (a.type == 's') w.Print(spec, (const char*)a.s);
+            else w.Append("<?>", 3);
+            break;
+        case 'p':
+            spec[sl++] = 'p'; spec[sl] = 0;
+            w.Print(spec, (void*)(uintptr_t)AsUnsigned(a));
+            break;
+        case 'n':
+            // 不回写调用方内存
+            break;
+        default:
+            spec[sl++] = conv; spec[sl] = 0;
+            w.Print(spec, AsDouble(a));
+            break;
+        }
+    }
+    return w.Length();
+}
+
+static inline void PutDigits(char* p, int v, int width)
+{
+    for (int i = width - 1; i >= 0; --i) {
+        p[i] = (char)('0' + v % 10);
+        v /= 10;
+    }
+}
+
+void PrefixCache::Format(char* out, u64 stampUs, i32 tzSeconds, char level)
+{
+    i64 sec = (i64)(stampUs / 1000000) + tzSeconds;
+    if (sec != m_sec) {
+        struct tm t;
+        time_t secs = (time_t)sec;
+        gmtime_s(&t, &secs);
+        // "[YYYY-MM-DD HH:MM:SS."，定宽写入
+        m_head[0] = '[';
+        PutDigits(m_head + 1, t.tm_year + 1900, 4);
+        m_head[5] = '-';
+        PutDigits(m_head + 6, t.tm_mon + 1, 2);
+        m_head[8] = '-';
+        PutDigits(m_head + 9, t.tm_mday, 2);
+        m_head[11] = ' ';
+        PutDigits(m_head + 12, t.tm_hour, 2);
+        m_head[14] = ':';
+        PutDigits(m_head + 15, t.tm_min, 2);
+        m_head[17] = ':';
+        PutDigits(m_head + 18, t.tm_sec, 2);
+        m_head[20] = '.';
+        m_head[21] = 0;
+        m_sec = sec;
+    }
+    int ms = (int)((stampUs / 1000) % 1000);
+    memcpy(out, m_head, 21);
+    PutDigits(out + 21, ms, 3);
+    memcpy(out + 24, "] [", 3);
+    out[27] = level;
+    memcpy(out + 28, "] ", 2);
+}
+
+}
+ECCS_END
@@ -0,0 +1,183 @@
+#pragma once
+#include "../global.h"
+#include <atomic>
+#include <stdint.h>
+#include <string.h>
+#include <type_traits>
+
+ECCS_BEGIN
+namespace binlog {
+
+//------------------------------------------------------
+// 二进制日志
+// * 调用点用静态 Site 描述格式串/函数/行号 (常量初始化，无构造开销)，
+//   首次执行时登记得到格式 ID
+// * 热路径只写 ID、时间戳与原始参数: 整数/浮点/指针各 8 字节，
+//   C 字符串为 1 字节长度 + 内容 (最长 255)
+// * 由后台写线程按格式串还原成文本，或原样写入 .blog 文件，
+//   由 LogDecoder 离线还原
+//------------------------------------------------------
+
+static const u32 MAX_SITES = 4096;
+static const u32 NO_ID = 0xFFFFFFFF;        // 登记已满，该调用点改为即时格式化
+static const u32 MAX_ARGS = 16;
+static const u32 MAX_STRING = 255;
+static const size_t MAX_ARGS_BYTES = 768;
+static const int PREFIX_LEN = 30;           // "[YYYY-MM-DD HH:MM:SS.mmm] [L] "
+
+// 环形缓冲与 .blog 文件共用的记录格式
+enum RecordKind : u8 {
+    REC_PAD    = 0,     // 环尾不足以放下记录时的填充 (只出现在环形缓冲)
+    REC_TEXT   = 1,     // 已格式化的日志行
+    REC_BINARY = 2,     // u32 格式 ID + 参数
+    REC_FORMAT = 3,     // 格式定义: u32 ID, u32 行号, 格式串\0 参数类型\0 函数名\0
+};
+
+// 记录头，记录整体 8 字节对齐 (文件中紧密排列)
+struct RecordHead {
+    u64 stamp;      // 环形缓冲中为计数器值，写线程取出后改写为 system_clock 微秒
+    u32 size;       // 含记录头
+    u16 len;        // 正文长度
+    u8  kind;
+    u8  level;
+};
+
+// .blog 文件头
+struct FileHeader {
+    char magic[8];
+    u32  version;
+    i32  tzSeconds; // 写入时的时区偏移
+};
+static const char FILE_MAGIC[8] = { 'E', 'C', 'C', 'S', 'B', 'L', 'O', 'G' };
+static const u32 FILE_VERSION = 1;
+
+// 调用点描述，由 LOG_BIN_* 宏生成
+struct Site {
+    const char*      fmt;
+    const char*      function;  // NULL 表示不加 "函数:行号" 前缀
+    u32              line;
+    char             level;
+    std::atomic<u32> id;        // 0 表示尚未登记
+};
+
+// 还原文本所需的格式信息
+struct FormatInfo {
+    const char* fmt;
+    const char* types;          // 每个参数一个类型码
+    const char* function;
+    u32         line;
+    char        level;
+};
+
+// 参数类型码: i 有符号整数, u 无符号整数, d 浮点, s C 字符串, p 指针
+template<typename T>
+constexpr char TypeCode()
+{
+    return (std::is_same<T, const char*>::value || std::is_same<T, char*>::value) ? 's'
+         : (std::is_pointer<T>::value || std::is_same<T, std::nullptr_t>::value) ? 'p'
+         : std::is_floating_point<T>::value ? 'd'
+         : (std::is_signed<T>::value || std::is_enum<T>::value) ? 'i'
+         : 'u';
+}
+
+template<typename... Args>
+struct ArgTypes {
+    static constexpr char value[sizeof...(Args) + 1] = { TypeCode<Args>()..., 0 };
+};
+template<typename... Args>
+constexpr char ArgTypes<Args...>::value[sizeof...(Args) + 1];
+
+// 为尚未写入的参数预留的字节: 数值 8 字节，字符串至少 1 字节长度
+constexpr size_t ArgReserve(const char* types)
+{
+    return *types == 0 ? 0 : (*types == 's' ? 1 : 8) + ArgReserve(types + 1);
+}
+
+// 参数编码，字符串按剩余空间截断，数值总有空间
+class Encoder
+{
+public:
+    Encoder(u8* buf, size_t cap, size_t reserve) : m_buf(buf), m_cap(cap), m_size(0), m_reserve(reserve) {}
+
+    size_t Size() const { return m_size; }
+
+    void Put(const char* s)
+    {
+        m_reserve -= 1;
+        if (!s) s = "(null)";
+        size_t avail = m_cap - m_size - m_reserve - 1;
+        if (avail > MAX_STRING) avail = MAX_STRING;
+        size_t n = 0;
+        while (n < avail && s[n]) ++n;
+        m_buf[m_size++] = (u8)n;
+        memcpy(m_buf + m_size, s, n);
+        m_size += n;
+    }
+    void Put(char* s) { Put((const char*)s); }
+    void Put(std::nullptr_t) { u64 v = 0; Put8(&v); }
+
+    template<typename T>
+    void Put(T* p)
+    {
+        u64 v = (u64)(uintptr_t)p;
+        Put8(&v);
+    }
+
+    template<typename T>
+    void Put(T v)
+    {
+        static_assert(std::is_arithmetic<T>::value || std::is_enum<T>::value,
+            "binary log arguments must be numbers, pointers or C strings");
+        PutNumber(v, std::is_floating_point<T>());
+    }
+
+private:
+    template<typename T>
+    void PutNumber(T v, std::true_type)
+    {
+        double d = (double)v;
+        Put8(&d);
+    }
+    template<typename T>
+    void PutNumber(T v, std::false_type)
+    {
+        typedef typename std::conditional<std::is_signed<T>::value || std::is_enum<T>::value, i64, u64>::type Wide;
+        Wide w = (Wide)v;
+        Put8(&w);
+    }
+    void Put8(const void* p)
+    {
+        m_reserve -= 8;
+        memcpy(m_buf + m_size, p, 8);
+        m_size += 8;
+    }
+
+    u8*    m_buf;
+    size_t m_cap;
+    size_t m_size;
+    size_t m_reserve;
+};
+
+/**
+ * @brief FormatArgs 按格式串与编码后的参数还原一行文本 (与 printf 结果一致)
+ * @param info 格式信息；function 非空时先输出 "函数:行号  "
+ * @param args/len 参数编码 (不含格式 ID)
+ * @param out/cap 输出缓冲，总以 '\0' 结尾，超长截断
+ * @return 写入的字节数 (不含 '\0')
+ */
+size_t FormatArgs(const FormatInfo& info, const u8* args, size_t len, char* out, size_t cap);
+
+// 生成 PREFIX_LEN 字节的 "[YYYY-MM-DD HH:MM:SS.mmm] [L] "，日期部分按秒缓存
+class PrefixCache
+{
+public:
+    PrefixCache() : m_sec(-1) { m_head[0] = 0; }
+    void Format(char* out, u64 stampUs, i32 tzSeconds, char level);
+
+private:
+    i64  m_sec;
+    char m_head[24];
+};
+
+}
+ECCS_END
@@ -1,4 +1,4 @@
-﻿
+
 #include "Exceptions.h"
 #include <stdarg.h>
 #include <string.h>
@@ -1,19 +1,30 @@
-﻿
+
 #include "Logger.h"
 #include <assert.h>
 #include <stdarg.h>
 #include <stdio.h>
 #include <algorithm>
+#include <memory>
 #include "../global.h"
 #include "../time/time_utils.h"
 #include "../utils/utils.h"
 #include "../utils/file_system.h"
 
+#include <errno.h>
+#include "../utils/buffer_pool.h"
+
+#if defined(_M_X64) || defined(_M_IX86)
+#include <intrin.h>
+#elif defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#endif
+
 #ifdef _WIN32
 #include <direct.h>
 #include <io.h>
 #else
 #include <unistd.h>
+#include <sys/uio.h>
 #endif
 
 #define _INVALID_FILE_     -1
@@ -21,6 +32,257 @@
 
 ECCS_BEGIN
 
+#ifdef _WIN32
+struct iovec {
+    void*  iov_base;
+    size_t iov_len;
+};
+#endif
+
+//-----------------------------------------------
+// 异步模式的数据结构
+//-----------------------------------------------
+
+static const size_t ASYNC_LINE_BYTES = 1024;   // 单条日志上限，超长改走同步写 (二进制记录同样受限)
+static const size_t ASYNC_MIN_RING = 4096;
+static const i64    ASYNC_WAIT_MS = 200;       // 缓冲满/超长行时等待写线程的上限
+static const i64    ASYNC_COALESCE_MS = 1;     // W/E 等紧急级别的最短写出间隔
+
+// 唤醒写线程的原因，数值大者优先
+enum WakeReason {
+    WAKE_NONE   = 0,
+    WAKE_URGENT = 1,    // E/W/O/F/plain
+    WAKE_FULL   = 2,    // 线程缓冲过半或已满
+};
+using namespace binlog;
+
+static inline u32 AlignRecord(size_t n)
+{
+    return (u32)((n + 7) & ~(size_t)7);
+}
+
+static inline u64 StampNow()
+{
+    return (u64)std::chrono::duration_cast<std::chrono::microseconds>(
+        std::chrono::system_clock::now().time_since_epoch()).count();
+}
+
+static inline i64 SteadyNs()
+{
+    return (i64)std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+// 环形缓冲中的时间戳: 直接读计数器 (x86 TSC / ARMv8 虚拟计数器)，
+// 比 system_clock::now() 便宜得多；写线程取出时再换算为微秒
+static inline u64 Ticks()
+{
+#if defined(_M_X64) || defined(_M_IX86) || defined(__x86_64__) || defined(__i386__)
+    return __rdtsc();
+#elif defined(__aarch64__)
+    u64 v;
+    __asm__ __volatile__("mrs %0, cntvct_el0" : "=r"(v));
+    return v;
+#else
+    return (u64)SteadyNs();
+#endif
+}
+
+// O 写操作日志，R 写数据日志，其余写主日志
+static inline u32 TargetIndex(char level)
+{
+    return level == 'O' ? 1 : (level == 'R' ? 2 : 0);
+}
+
+// 需要尽快写出的级别 (同步模式下这些级别逐条 fflush)
+static inline bool IsUrgent(char level)
+{
+    return level == 'E' || level == 'W' || level == 'O' || level == 'F' || level == 'P';
+}
+
+// 单生产者 (所属线程) 单消费者 (写线程) 的字节环
+struct Logger::AsyncRing
+{
+    BufferPool::Lease storage;
+    u8*    data;
+    size_t cap;
+    size_t mask;
+    u64    reserveAt;               // 生产者私有: 本次预留的起点
+    char   pad0[64];
+    std::atomic<u64>  head;         // 生产者提交位置
+    char   pad1[64];
+    std::atomic<u64>  tail;         // 写线程释放位置
+    char   pad2[64];
+    u64    readAt;                  // 写线程私有: 已取出未释放的位置
+    u64    readEnd;
+    RecordHead* next;               // 写线程私有: 待归并的下一条
+    std::atomic<bool> closed;       // 所属线程已退出
+
+    explicit AsyncRing(size_t bytes)
+        : storage(BufferPool::Instance().Acquire(bytes)), data(storage.Data()), cap(bytes), mask(bytes - 1),
+          reserveAt(0), head(0), tail(0), readAt(0), readEnd(0), next(NULL), closed(false)
+    {
+    }
+
+    u64 Used() const
+    {
+        return head.load(std::memory_order_relaxed) - tail.load(std::memory_order_acquire);
+    }
+
+    // 预留 size 字节的连续空间；空间不足返回 NULL
+    u8* Reserve(u32 size)
+    {
+        u64 h = head.load(std::memory_order_relaxed);
+        size_t pos = (size_t)(h & mask);
+        size_t contig = cap - pos;
+        u64 need = size <= contig ? size : contig + size;
+        if (cap - (h - tail.load(std::memory_order_acquire)) < need) {
+            return NULL;
+        }
+        if (size > contig) {
+            // 不足一个记录头时消费者自行跳到环首
+            if (contig >= sizeof(RecordHead)) {
+                RecordHead* pad = (RecordHead*)(data + pos);
+                pad->size = (u32)contig;
+                pad->kind = REC_PAD;
+            }
+            h += contig;
+        }
+        reserveAt = h;
+        return data + (size_t)(h & mask);
+    }
+
+    void Commit(u32 size)
+    {
+        head.store(reserveAt + size, std::memory_order_release);
+    }
+
+    // 写线程: 定位 [readAt, readEnd) 中的下一条记录
+    RecordHead* Peek()
+    {
+        while (readAt < readEnd) {
+            size_t pos = (size_t)(readAt & mask);
+            size_t contig = cap - pos;
+            if (contig < sizeof(RecordHead)) {
+                readAt += contig;
+                continue;
+            }
+            RecordHead* h = (RecordHead*)(data + pos);
+            if (h->kind == REC_PAD) {
+                readAt += h->size;
+                continue;
+            }
+            return h;
+        }
+        return NULL;
+    }
+};
+
+// 一次写出的记录: 时间头与正文都以 iovec 引用，文本记录直接指向环形缓冲，
+// 二进制记录还原出的文本与格式定义放在 arena 中
+struct Logger::WriteBatch
+{
+    static const u32 MAX_RECORDS = 256;
+    static const u32 TARGETS = 4;               // 主日志/操作日志/数据日志/.blog
+    static const u32 TARGET_BINARY = 3;
+    static const size_t ARENA_BYTES = 64 * 1024;
+
+    char   prefix[MAX_RECORDS][32];
+    iovec  iov[TARGETS][MAX_RECORDS * 2];
+    u32    iovCount[TARGETS];
+    u32    count;
+    size_t bytes;
+    char   arena[ARENA_BYTES];
+    size_t arenaUsed;
+
+    WriteBatch() { Reset(); }
+
+    void Reset()
+    {
+        for (u32 i = 0; i < TARGETS; ++i) iovCount[i] = 0;
+        count = 0;
+        bytes = 0;
+        arenaUsed = 0;
+    }
+
+    void Add(u32 target, const void* p, size_t len)
+    {
+        iovec& v = iov[target][iovCount[target]++];
+        v.iov_base = (void*)p;
+        v.iov_len = len;
+        bytes += len;
+    }
+
+    // 一条记录在 arena 中最多占用的空间
+    bool ArenaFull() const { return ARENA_BYTES - arenaUsed < ASYNC_LINE_BYTES * 2; }
+};
+
+// 线程退出时标记缓冲，由写线程写完后回收
+struct RingHolder
+{
+    void* ring;
+    std::atomic<bool>* closed;
+    RingHolder() : ring(NULL), closed(NULL) {}
+    ~RingHolder();
+};
+
+// 0 未创建, 1 可用, 2 已析构 (线程退出阶段的日志直接同步写)
+static thread_local int t_ringState = 0;
+
+RingHolder::~RingHolder()
+{
+    if (closed) {
+        closed->store(true, std::memory_order_release);
+    }
+    ring = NULL;
+    closed = NULL;
+    t_ringState = 2;
+}
+
+// 逐段 writev，处理部分写入
+static bool WriteSpans(FILE* f, iovec* iov, u32 n)
+{
+#ifdef _WIN32
+    for (u32 i = 0; i < n; ++i) {
+        if (fwrite(iov[i].iov_base, 1, iov[i].iov_len, f) != iov[i].iov_len) {
+            return false;
+        }
+    }
+    fflush(f);
+    return true;
+#else
+    int fd = fileno(f);
+    while (n > 0) {
+        ssize_t w = writev(fd, iov, (int)n);
+        if (w < 0) {
+            if (errno == EINTR) continue;
+            return false;
+        }
+        while (n > 0 && (size_t)w >= iov->iov_len) {
+            w -= iov->iov_len;
+            ++iov;
+            --n;
+        }
+        if (n > 0) {
+            iov->iov_base = (char*)iov->iov_base + w;
+            iov->iov_len -= (size_t)w;
+        }
+    }
+    return true;
+#endif
+}
+
+static void SyncFile(FILE* f)
+{
+    if (!f) return;
+    fflush(f);
+#ifdef _WIN32
+    _commit(_fileno(f));
+#else
+    fsync(fileno(f));
+#endif
+}
+
 
 Logger::Logger()
 {
@@ -33,9 +295,35 @@ Logger::Logger()
     custom_buf.clear();
     is_write_custom=false;
     custom_log_path="";
+
+    m_async = false;
+    m_writer = NULL;
+    m_wakeReason = WAKE_NONE;
+    m_stopWriter = true;
+    m_flushRequest = 0;
+    m_flushDone = 0;
+    m_waiters = 0;
+    m_ringBytes = 64 * 1024;
+    m_flushMs = 100;
+    m_fout_bin = NULL;
+    m_binaryOutput = false;
+    m_binGeneration = 0;
+    m_binDefinedGen = 0;
+    m_sites = NULL;
+    m_siteCount = 0;
+    m_clockTick0 = 0;
+    m_clockSteady0 = 0;
+    m_ticksPerNs = 1.0;
+    m_statRecords = 0;
+    m_statBytes = 0;
+    m_statBatches = 0;
+    m_statBlocked = 0;
+    m_statFallback = 0;
 }
 Logger::~Logger()
 {
+    // 线程缓冲不释放: 其它线程此时可能仍持有
+    stopAsync();
     if (m_fout){
         fclose(m_fout);
         m_fout = NULL;
@@ -49,6 +337,10 @@ Logger::~Logger()
         fclose(m_fout_record);
         m_fout_record = NULL;
     }
+    if (m_fout_bin) {
+        fclose(m_fout_bin);
+        m_fout_bin = NULL;
+    }
 }
 Logger* Logger::getInstance()
 {
@@ -92,10 +384,12 @@ void Logger::logCustom(const char* fmt, ...){
     va_list args;
     va_start(args, fmt);
     char cmdStr[255];
-    memset(cmdStr,0,sizeof(cmdStr));
-    snprintf(cmdStr, sizeof(cmdStr), fmt, args);
+    int n = vsnprintf(cmdStr, sizeof(cmdStr), fmt, args);
     va_end(args);
-    str ss=str(cmdStr);
+    if (n <= 0) {
+        return;
+    }
+    size_t len = (size_t)n < sizeof(cmdStr) ? (size_t)n : sizeof(cmdStr) - 1;
 
     if(is_write_custom){
         std::ofstream ofs;
@@ -103,10 +397,11 @@ void Logger::logCustom(const char* fmt, ...){
         if (!ofs.is_open()){
             return ;
         }
-        ofs.write(ss.c_str(),ss.length());
+        ofs.write(cmdStr,len);
         ofs.close();
     }else{
-       custom_buf.push_back(ss.c_str(),ss.length());
+       // 缓存存储来自 BufferPool，writeCustom 清空后保留容量
+       custom_buf.push_back(cmdStr,len);
     }
 }
 
@@ -344,6 +639,11 @@ void Logger::initLogger(const char* log_path,const char* backup_path,const char*
     {
         printf("Create Log File :%s Failed !\n",buf);
     }
+    // 二进制日志与主日志同名，扩展名为 .blog
+    m_bin_path = str(buf, strlen(buf) - 4) + ".blog";
+    if (m_binaryOutput) {
+        openBinaryLog();
+    }
     memset(buf,0,512);
     if(have_sublog)
     {
@@ -371,22 +671,11 @@ void Logger::initLogger(const char* log_path,const char* backup_path,const char*
  */
 int Logger::plain(const char* fmt, ...)
 {
-    if (!m_fout) {
-        return _INVALID_FILE_;
-    }
-    SMART_LOCK(m_lock);
-    m_time_from_start_log += m_lastLog.elapsed();
-    m_lastLog.restart();
-
     va_list args;
     va_start(args, fmt);
-    int iRet = vfprintf(m_fout, fmt, args);
+    int iRet = m_async.load(std::memory_order_relaxed) ? logAsync('P', fmt, args) : logSync('P', m_fout, fmt, args);
     va_end(args);
-    if (iRet < 0){
-        return _FPRINTFS_FAILED_;
-    }
 
-    fflush(m_fout);
     return iRet;
 }
 /**
@@ -473,6 +762,24 @@ int Logger::recoder(const char* fmt, ...)
 
     return iRet;
 }
+/**
+ * @brief Logger::fatal 将提供的字符串写入log，并标记为fatal；返回前保证已写入文件并落盘
+ * @param fmt：日志内容
+ * @param ...：format格式字符串
+ * @return 失败返回错误码（_INVALID_FILE_ | _FPRINTFS_FAILED_），成功返回写入字节数
+ */
+int Logger::fatal(const char* fmt, ...)
+{
+    va_list args;
+    va_start(args, fmt);
+    int iRet = log('F', fmt, args);
+    va_end(args);
+
+    flush();
+    SMART_LOCK(m_lock);
+    SyncFile(m_fout);
+    return iRet;
+}
 /**
  * @brief Logger::log
  * @param level:希望记录的日志等级
@@ -490,21 +797,28 @@ int Logger::log(char level, const char* fmt, va_list args)
     return 1;
 #endif
 
-    // --- 统一选择目标文件指针，避免重复代码 ---
-    FILE* pTargetFile = NULL;
-    if (level == 'O')
-    {
-        pTargetFile = m_fout_operate;
+    if (m_async.load(std::memory_order_relaxed)) {
+        return logAsync(level, fmt, args);
     }
-    else if (level == 'R')
-    {
-        pTargetFile = m_fout_record;
+    return logSync(level, targetFile(level), fmt, args);
+}
+
+FILE* Logger::targetFile(char level) const
+{
+    if (level == 'O') {
+        return m_fout_operate;
     }
-    else
-    {
-        pTargetFile = m_fout;
+    if (level == 'R') {
+        return m_fout_record;
     }
+    return m_fout;
+}
 
+/**
+ * @brief Logger::logSync 在调用线程中直接写文件；level 为 'P' 时不加信息头
+ */
+int Logger::logSync(char level, FILE* pTargetFile, const char* fmt, va_list args)
+{
     // 检查文件指针是否有效
     if (!pTargetFile) {
         return _INVALID_FILE_;
@@ -515,23 +829,23 @@ int Logger::log(char level, const char* fmt, va_list args)
     m_time_from_start_log += m_lastLog.elapsed();
     m_lastLog.restart();
 
-    // 生成信息头并写入文件
-    char buf[32] = { 0 };
-    auto dt = now(m_time_zone);
-    tmpRet = snprintf(buf, sizeof(buf), "[%04d-%02d-%02d %02d:%02d:%02d.%03d] [%c] ", dt.year, dt.mon, dt.day,
-        dt.hour, dt.min, dt.sec, dt.ms, level);
-
-    // snprintf 可能因为截断返回更大的值，这里断言改成 >= 30 更安全
-    assert(tmpRet >= 30); 
+    if (level != 'P') {
+        // 生成信息头并写入文件
+        char buf[32] = { 0 };
+        auto dt = now(m_time_zone);
+        tmpRet = snprintf(buf, sizeof(buf), "[%04d-%02d-%02d %02d:%02d:%02d.%03d] [%c] ", dt.year, dt.mon, dt.day,
+            dt.hour, dt.min, dt.sec, dt.ms, level);
 
-    // --- 统一写入逻辑 ---
+        // snprintf 可能因为截断返回更大的值，这里断言改成 >= 30 更安全
+        assert(tmpRet >= PREFIX_LEN);
 
-    // 1. 写入时间头
-    tmpRet = fprintf(pTargetFile, "%s", buf);
-    if (tmpRet < 0) {
-        return _FPRINTFS_FAILED_;
+        // 1. 写入时间头
+        tmpRet = fprintf(pTargetFile, "%s", buf);
+        if (tmpRet < 0) {
+            return _FPRINTFS_FAILED_;
+        }
+        iRet += tmpRet;
     }
-    iRet += tmpRet;
 
     // 2. 写入日志内容
     tmpRet = vfprintf(pTargetFile, fmt, args);
@@ -541,9 +855,9 @@ int Logger::log(char level, const char* fmt, va_list args)
     iRet += tmpRet;
 
     // --- 性能优化：按需刷新 (Conditional Flush) ---
-    // 只有 Error(E), Warning(W) 或 操作日志(O) 才强制立即刷盘
+    // 只有 Error(E), Warning(W), Fatal(F), 操作日志(O) 与 plain 才强制立即刷盘
     // Debug(D), Info(I), Record(R) 依靠系统缓存，提高大量写入时的性能
-    if (level == 'E' || level == 'W' || level == 'O')
+    if (IsUrgent(level))
     {
         fflush(pTargetFile);
     }
@@ -551,6 +865,561 @@ int Logger::log(char level, const char* fmt, va_list args)
     return iRet;
 }
 
+//-----------------------------------------------
+// 异步模式
+//-----------------------------------------------
+
+void Logger::startAsync(size_t ring_bytes, u32 flush_ms)
+{
+    std::lock_guard<std::mutex> control(m_controlLock);
+    std::lock_guard<std::mutex> lk(m_wakeLock);
+    if (!m_stopWriter) {
+        return;
+    }
+
+    size_t bytes = ASYNC_MIN_RING;
+    while (bytes < ring_bytes) bytes <<= 1;
+    m_ringBytes = bytes;    // 只影响之后登记的线程
+    m_flushMs = flush_ms > 0 ? flush_ms : 1;
+
+    // 计数频率的初值，写线程随运行时间修正
+    m_clockTick0 = Ticks();
+    m_clockSteady0 = SteadyNs();
+    sleep_for(std::chrono::milliseconds(2));
+    m_ticksPerNs = (double)(Ticks() - m_clockTick0) / (double)(SteadyNs() - m_clockSteady0);
+
+    m_stopWriter = false;
+    m_async = true;
+    m_writer = new std::thread(&Logger::writerLoop, this);
+}
+
+void Logger::stopAsync()
+{
+    std::lock_guard<std::mutex> control(m_controlLock);
+    std::thread* writer = NULL;
+    {
+        std::lock_guard<std::mutex> lk(m_wakeLock);
+        if (m_stopWriter) {
+            return;
+        }
+        m_stopWriter = true;
+        m_async = false;
+        writer = m_writer;
+        m_writer = NULL;
+    }
+    m_wakeCond.notify_one();
+    deleteThread(writer);
+
+    // 写线程退出前后仍可能有线程提交了记录
+    std::unique_ptr<WriteBatch> batch(new WriteBatch());
+    drainRings(*batch);
+    {
+        std::lock_guard<std::mutex> lk(m_wakeLock);
+        m_flushDone = m_flushRequest;
+    }
+    m_doneCond.notify_all();
+
+    SMART_LOCK(m_lock);
+    if (m_fout) fflush(m_fout);
+    if (m_fout_operate) fflush(m_fout_operate);
+    if (m_fout_record) fflush(m_fout_record);
+}
+
+bool Logger::isAsync() const
+{
+    return m_async.load(std::memory_order_relaxed);
+}
+
+void Logger::flush()
+{
+    if (waitWriter(-1)) {
+        return;
+    }
+
+    SMART_LOCK(m_lock);
+    if (m_fout) fflush(m_fout);
+    if (m_fout_operate) fflush(m_fout_operate);
+    if (m_fout_record) fflush(m_fout_record);
+}
+
+bool Logger::waitWriter(i64 timeout_ms)
+{
+    std::unique_lock<std::mutex> lk(m_wakeLock);
+    if (m_stopWriter) {
+        return false;
+    }
+    u64 ticket = ++m_flushRequest;
+    m_wakeCond.notify_one();
+    auto done = [&]() { return m_flushDone >= ticket; };
+    if (timeout_ms < 0) {
+        m_doneCond.wait(lk, done);
+        return true;
+    }
+    return m_doneCond.wait_for(lk, std::chrono::milliseconds(timeout_ms), done);
+}
+
+Logger::AsyncStats Logger::getAsyncStats() const
+{
+    AsyncStats s;
+    s.records = m_statRecords.load(std::memory_order_relaxed);
+    s.bytes = m_statBytes.load(std::memory_order_relaxed);
+    s.batches = m_statBatches.load(std::memory_order_relaxed);
+    s.blocked = m_statBlocked.load(std::memory_order_relaxed);
+    s.fallback = m_statFallback.load(std::memory_order_relaxed);
+    std::lock_guard<std::mutex> lk(m_ringLock);
+    s.rings = (u32)m_rings.size();
+    return s;
+}
+
+Logger::AsyncRing* Logger::localRing()
+{
+    static thread_local RingHolder holder;
+    if (t_ringState == 2) {
+        return NULL;
+    }
+    if (!holder.ring) {
+        AsyncRing* ring = new AsyncRing(m_ringBytes);
+        {
+            std::lock_guard<std::mutex> lk(m_ringLock);
+            m_rings.push_back(ring);
+        }
+        holder.ring = ring;
+        holder.closed = &ring->closed;
+        t_ringState = 1;
+    }
+    return (AsyncRing*)holder.ring;
+}
+
+void Logger::wakeWriter(int reason)
+{
+    int cur = m_wakeReason.load(std::memory_order_relaxed);
+    while (cur < reason && !m_wakeReason.compare_exchange_weak(cur, reason)) {
+    }
+    if (cur >= reason) {
+        return;
+    }
+    // 经过互斥量再通知，避免写线程检查条件后、进入等待前丢失唤醒
+    { std::lock_guard<std::mutex> lk(m_wakeLock); }
+    m_wakeCond.notify_one();
+}
+
+int Logger::logAsync(char level, const char* fmt, va_list args)
+{
+    if (!targetFile(level)) {
+        return _INVALID_FILE_;
+    }
+
+    char line[ASYNC_LINE_BYTES];
+    va_list copy;
+    va_copy(copy, args);
+    int n = vsnprintf(line, sizeof(line), fmt, copy);
+    va_end(copy);
+    if (n < 0) {
+        return _FPRINTFS_FAILED_;
+    }
+
+    AsyncRing* ring = localRing();
+    if (!ring || (size_t)n >= sizeof(line)) {
+        // 超长行: 先等本线程已提交的记录写出，保持顺序
+        if (ring) {
+            ++m_statFallback;
+            waitWriter(ASYNC_WAIT_MS);
+        }
+        return logSync(level, targetFile(level), fmt, args);
+    }
+
+    u32 size = AlignRecord(sizeof(RecordHead) + n);
+    u8* p = reserveRecord(ring, size);
+    if (!p) {
+        return logSync(level, targetFile(level), fmt, args);
+    }
+
+    RecordHead* h = (RecordHead*)p;
+    h->stamp = Ticks();
+    h->size = size;
+    h->len = (u16)n;
+    h->kind = REC_TEXT;
+    h->level = (u8)level;
+    memcpy(h + 1, line, n);
+    commitRecord(ring, size, level);
+    return level == 'P' ? n : n + PREFIX_LEN;
+}
+
+u8* Logger::reserveRecord(AsyncRing* ring, u32 size)
+{
+    u8* p = ring->Reserve(size);
+    if (p) {
+        return p;
+    }
+
+    // 缓冲已满: 唤醒写线程并等待空间 (唯一的阻塞路径)；
+    // 调用方持有 m_lock (如 initLogger 内的日志) 时写线程无法写出，超时后由调用方改走同步写
+    ++m_statBlocked;
+    wakeWriter(WAKE_FULL);
+    std::unique_lock<std::mutex> lk(m_wakeLock);
+    ++m_waiters;
+    auto deadline = std::chrono::steady_clock::now() + std::chrono::milliseconds(ASYNC_WAIT_MS);
+    while (!(p = ring->Reserve(size)) && !m_stopWriter) {
+        if (m_doneCond.wait_until(lk, deadline) == std::cv_status::timeout) {
+            p = ring->Reserve(size);
+            break;
+        }
+    }
+    --m_waiters;
+    return p;
+}
+
+void Logger::commitRecord(AsyncRing* ring, u32 size, char level)
+{
+    ring->Commit(size);
+    if (ring->Used() > ring->cap / 2) {
+        wakeWriter(WAKE_FULL);
+    }
+    else if (IsUrgent(level)) {
+        wakeWriter(WAKE_URGENT);
+    }
+}
+
+//-----------------------------------------------
+// 二进制日志
+//-----------------------------------------------
+
+u32 Logger::registerSite(binlog::Site& site, const char* types)
+{
+    std::lock_guard<std::mutex> lk(m_siteLock);
+    u32 id = site.id.load(std::memory_order_acquire);
+    if (id != 0) {
+        return id;
+    }
+    if (!m_sites) {
+        // 与线程缓冲一样不释放: 写线程与退出中的线程可能仍在引用
+        m_sites = new FormatInfo[MAX_SITES];
+    }
+    if (m_siteCount >= MAX_SITES) {
+        id = NO_ID;
+    }
+    else {
+        FormatInfo& info = m_sites[m_siteCount];
+        info.fmt = site.fmt;
+        info.types = types;
+        info.function = site.function;
+        info.line = site.line;
+        info.level = site.level;
+        id = ++m_siteCount;
+    }
+    site.id.store(id, std::memory_order_release);
+    return id;
+}
+
+int Logger::logBinary(binlog::Site& site, const char* types, const u8* args, u32 len)
+{
+    if (!log_out) {
+        return 1;
+    }
+#if DISABLE_LOG
+    return 1;
+#endif
+
+    char level = site.level;
+    if (m_async.load(std::memory_order_relaxed) && len + 4 + sizeof(RecordHead) <= ASYNC_LINE_BYTES) {
+        // acquire 保证写线程能看到其它线程登记的格式信息
+        u32 id = site.id.load(std::memory_order_acquire);
+        if (id == 0) {
+            id = registerSite(site, types);
+        }
+        AsyncRing* ring = id != NO_ID ? localRing() : NULL;
+        if (ring) {
+            u32 size = AlignRecord(sizeof(RecordHead) + 4 + len);
+            u8* p = reserveRecord(ring, size);
+            if (p) {
+                RecordHead* h = (RecordHead*)p;
+                h->stamp = Ticks();
+                h->size = size;
+                h->len = (u16)(4 + len);
+                h->kind = REC_BINARY;
+                h->level = (u8)level;
+                memcpy(h + 1, &id, 4);
+                memcpy((u8*)(h + 1) + 4, args, len);
+                commitRecord(ring, size, level);
+                return (int)len;
+            }
+        }
+    }
+
+    // 同步模式或无法入队: 立即还原成文本
+    FormatInfo info = { site.fmt, types, site.function, site.line, level };
+    char text[ASYNC_LINE_BYTES];
+    FormatArgs(info, args, len, text, sizeof(text));
+    return logSyncf(level, targetFile(level), "%s", text);
+}
+
+int Logger::logSyncf(char level, FILE* target, const char* fmt, ...)
+{
+    va_list args;
+    va_start(args, fmt);
+    int iRet = logSync(level, target, fmt, args);
+    va_end(args);
+    return iRet;
+}
+
+bool Logger::setBinaryOutput(bool enable)
+{
+    if (!enable) {
+        // 先写完已入队的二进制记录
+        flush();
+    }
+    SMART_LOCK(m_lock);
+    m_binaryOutput = enable;
+    if (!enable) {
+        if (m_fout_bin) {
+            fclose(m_fout_bin);
+            m_fout_bin = NULL;
+        }
+        return true;
+    }
+    return m_fout_bin != NULL || openBinaryLog();
+}
+
+// 调用方持有 m_lock
+bool Logger::openBinaryLog()
+{
+    if (m_fout_bin) {
+        fclose(m_fout_bin);
+        m_fout_bin = NULL;
+    }
+    if (m_bin_path.empty()) {
+        return false;
+    }
+    m_fout_bin = fopen(m_bin_path.c_str(), "wb");
+    if (!m_fout_bin) {
+        return false;
+    }
+    FileHeader hdr;
+    memcpy(hdr.magic, FILE_MAGIC, sizeof(hdr.magic));
+    hdr.version = FILE_VERSION;
+    hdr.tzSeconds = static_cast<int>(m_time_zone) * 3600;
+    fwrite(&hdr, sizeof(hdr), 1, m_fout_bin);
+    fflush(m_fout_bin);
+    ++m_binGeneration;
+    return true;
+}
+
+void Logger::writerLoop()
+{
+    std::unique_ptr<WriteBatch> batch(new WriteBatch());
+    auto must = [&]() {
+        return m_stopWriter || m_flushRequest != m_flushDone || m_wakeReason.load() >= WAKE_FULL;
+    };
+    auto any = [&]() {
+        return must() || m_wakeReason.load() != WAKE_NONE;
+    };
+
+    std::unique_lock<std::mutex> lk(m_wakeLock);
+    std::chrono::steady_clock::time_point lastDrain = std::chrono::steady_clock::now();
+    while (true) {
+        // 距上次写出不足 ASYNC_COALESCE_MS 时只响应 flush/停止/缓冲过半，
+        // 使连续的 W/E 合并成批写出，而不是每条一次系统调用
+        m_wakeCond.wait_until(lk, lastDrain + std::chrono::milliseconds(ASYNC_COALESCE_MS), must);
+        m_wakeCond.wait_for(lk, std::chrono::milliseconds(m_flushMs), any);
+        bool stop = m_stopWriter;
+        u64 request = m_flushRequest;
+        m_wakeReason.store(WAKE_NONE);
+        lk.unlock();
+
+        drainRings(*batch);
+        lastDrain = std::chrono::steady_clock::now();
+        if (request != m_flushDone) {
+            // 时间头已随 writev 写出，这里只处理 initLogger 等直接写入 FILE 缓冲的内容
+            SMART_LOCK(m_lock);
+            if (m_fout) fflush(m_fout);
+            if (m_fout_operate) fflush(m_fout_operate);
+            if (m_fout_record) fflush(m_fout_record);
+        }
+
+        lk.lock();
+        m_flushDone = request;
+        m_doneCond.notify_all();
+        if (stop) {
+            break;
+        }
+    }
+}
+
+u64 Logger::drainRings(WriteBatch& batch)
+{
+    {
+        // 回收已退出且已写完的线程缓冲
+        std::lock_guard<std::mutex> lk(m_ringLock);
+        for (size_t i = 0; i < m_rings.size();) {
+            AsyncRing* r = m_rings[i];
+            if (r->closed.load(std::memory_order_acquire) &&
+                r->tail.load(std::memory_order_relaxed) == r->head.load(std::memory_order_acquire)) {
+                m_rings[i] = m_rings.back();
+                m_rings.pop_back();
+                delete r;
+            }
+            else {
+                ++i;
+            }
+        }
+        m_drainList = m_rings;
+    }
+
+    for (AsyncRing* r : m_drainList) {
+        r->readAt = r->tail.load(std::memory_order_relaxed);
+        r->readEnd = r->head.load(std::memory_order_acquire);
+        r->next = r->Peek();
+    }
+
+    // 计数器换算: 取出的记录都早于此刻，按稳定时钟修正计数频率 (基线越长越准)，
+    // 再以当前墙上时间倒推，系统校时后立即生效
+    u64 tickNow = Ticks();
+    i64 steadyNow = SteadyNs();
+    i64 wallNow = (i64)StampNow();
+    if (steadyNow - m_clockSteady0 > 1000000) {
+        m_ticksPerNs = (double)(tickNow - m_clockTick0) / (double)(steadyNow - m_clockSteady0);
+    }
+
+    // .blog 是否打开；文件换过则格式定义需要重新写
+    bool binary;
+    {
+        SMART_LOCK(m_lock);
+        binary = m_fout_bin != NULL;
+        if (binary && m_binDefinedGen != m_binGeneration) {
+            m_binDefined.assign(MAX_SITES, 0);
+            m_binDefinedGen = m_binGeneration;
+        }
+    }
+    i32 tzSeconds = static_cast<int>(m_time_zone) * 3600;
+
+    // 各线程内有序，跨线程按时间戳归并
+    u64 total = 0;
+    while (true) {
+        AsyncRing* best = NULL;
+        for (AsyncRing* r : m_drainList) {
+            if (r->next && (!best || r->next->stamp < best->next->stamp)) {
+                best = r;
+            }
+        }
+        if (!best) {
+            break;
+        }
+
+        RecordHead* h = best->next;
+        char level = (char)h->level;
+        // 原地改写为微秒，.blog 中的时间戳即为墙上时间
+        u64 age = tickNow > h->stamp ? tickNow - h->stamp : 0;
+        h->stamp = (u64)(wallNow - (i64)((double)age / m_ticksPerNs / 1000.0));
+        if (batch.ArenaFull()) {
+            writeBatch(batch);
+        }
+
+        if (h->kind == REC_BINARY) {
+            const u8* body = (const u8*)(h + 1);
+            u32 id;
+            memcpy(&id, body, 4);
+            const FormatInfo& info = m_sites[id - 1];
+            if (binary) {
+                // 原样写入 .blog，每个格式在文件中首次出现前写一次定义
+                if (!m_binDefined[id - 1]) {
+                    m_binDefined[id - 1] = 1;
+                    appendFormat(batch, id, info);
+                }
+                batch.Add(WriteBatch::TARGET_BINARY, h, sizeof(RecordHead) + h->len);
+            }
+            else {
+                u32 target = TargetIndex(level);
+                char* prefix = batch.prefix[batch.count];
+                m_prefix.Format(prefix, h->stamp, tzSeconds, level);
+                batch.Add(target, prefix, PREFIX_LEN);
+                char* text = batch.arena + batch.arenaUsed;
+                size_t n = FormatArgs(info, body + 4, h->len - 4, text, ASYNC_LINE_BYTES);
+                batch.arenaUsed += n;
+                batch.Add(target, text, n);
+            }
+        }
+        else {
+            u32 target = TargetIndex(level);
+            if (level != 'P') {
+                char* prefix = batch.prefix[batch.count];
+                m_prefix.Format(prefix, h->stamp, tzSeconds, level);
+                batch.Add(target, prefix, PREFIX_LEN);
+            }
+            batch.Add(target, h + 1, h->len);
+        }
+        ++batch.count;
+        ++total;
+
+        best->readAt += h->size;
+        best->next = best->Peek();
+
+        if (batch.count == WriteBatch::MAX_RECORDS) {
+            writeBatch(batch);
+        }
+    }
+    writeBatch(batch);
+    return total;
+}
+
+void Logger::appendFormat(WriteBatch& batch, u32 id, const FormatInfo& info)
+{
+    batch.arenaUsed = AlignRecord(batch.arenaUsed);
+    RecordHead* h = (RecordHead*)(batch.arena + batch.arenaUsed);
+    u8* body = (u8*)(h + 1);
+    size_t n = 0;
+    memcpy(body + n, &id, 4);
+    n += 4;
+    memcpy(body + n, &info.line, 4);
+    n += 4;
+    const char* strs[3] = { info.fmt, info.types, info.function ? info.function : "" };
+    for (const char* str : strs) {
+        // 格式串过长时截断，保证定义放得下
+        size_t len = std::min(strlen(str), (size_t)(ASYNC_LINE_BYTES / 2 - 1));
+        memcpy(body + n, str, len);
+        n += len;
+        body[n++] = 0;
+    }
+    h->stamp = 0;
+    h->size = (u32)(sizeof(RecordHead) + n);
+    h->len = (u16)n;
+    h->kind = REC_FORMAT;
+    h->level = (u8)info.level;
+    batch.arenaUsed += h->size;
+    batch.Add(WriteBatch::TARGET_BINARY, h, h->size);
+}
+
+void Logger::writeBatch(WriteBatch& batch)
+{
+    if (batch.count > 0) {
+        SMART_LOCK(m_lock);
+        m_time_from_start_log += m_lastLog.elapsed();
+        m_lastLog.restart();
+
+        FILE* files[WriteBatch::TARGETS] = { m_fout, m_fout_operate, m_fout_record, m_fout_bin };
+        for (u32 i = 0; i < WriteBatch::TARGETS; ++i) {
+            if (batch.iovCount[i] == 0 || !files[i]) {
+                continue;
+            }
+            // initLogger 的文件头等仍在 FILE 缓冲中，先写出以保证顺序
+            fflush(files[i]);
+            WriteSpans(files[i], batch.iov[i], batch.iovCount[i]);
+        }
+        m_statRecords += batch.count;
+        m_statBytes += batch.bytes;
+        ++m_statBatches;
+    }
+
+    // 写出后才释放环形缓冲空间
+    for (AsyncRing* r : m_drainList) {
+        r->tail.store(r->readAt, std::memory_order_release);
+    }
+    batch.Reset();
+
+    std::lock_guard<std::mutex> lk(m_wakeLock);
+    if (m_waiters > 0) {
+        m_doneCond.notify_all();
+    }
+}
 
 ECCS_END
 
@@ -1,4 +1,4 @@
-﻿
+
 #pragma once
 #include "../global.h"
 #include "../time/elapsed_timer.h"
@@ -6,7 +6,9 @@
 #include "limits.h"
 #include <iostream>
 #include <fstream>
+#include <vector>
 #include "../utils/buffer.h"
+#include "BinaryLog.h"
 
 ECCS_BEGIN
 
@@ -124,8 +126,59 @@ public:
      * @return 失败返回错误码（_INVALID_FILE_ | _FPRINTFS_FAILED_），成功返回写入字节数
      */
     int recoder(const char* fmt, ...);
+    /**
+     * @brief Logger::fatal 将提供的字符串写入log，并标记为fatal；返回前保证已写入文件并落盘
+     * @param fmt：日志内容
+     * @param ...：format格式字符串
+     * @return 失败返回错误码（_INVALID_FILE_ | _FPRINTFS_FAILED_），成功返回写入字节数
+     */
+    int fatal(const char* fmt, ...);
     void backupLogs();
 
+    //-----------------------------------------------
+    // 异步模式
+    // 调用线程只把日志行格式化进本线程的环形缓冲 (单生产者单消费者，无锁)，
+    // 由后台写线程合并各线程的记录，按时间/容量成批 writev 到文件；
+    // 时间头在写线程生成，同一文件内按时间戳归并
+    //-----------------------------------------------
+    struct AsyncStats {
+        u64 records;    // 已写出的记录
+        u64 bytes;      // 已写出的字节 (含时间头)
+        u64 batches;    // 写批次
+        u64 blocked;    // 环形缓冲已满、调用线程等待的次数
+        u64 fallback;   // 超长日志行改走同步写的次数
+        u32 rings;      // 已登记的线程缓冲
+    };
+    /**
+     * @brief Logger::startAsync 开启异步日志
+     * @param ring_bytes 每个线程的环形缓冲大小 (向上取 2 的幂，至少 4KB)
+     * @param flush_ms 写线程最长等待时间；E/W/O/F 及缓冲过半时立即唤醒写线程
+     */
+    void startAsync(size_t ring_bytes = 64 * 1024, u32 flush_ms = 100);
+    /**
+     * @brief Logger::stopAsync 写完已提交的日志后停止写线程，之后回到同步写
+     */
+    void stopAsync();
+    bool isAsync() const;
+    /**
+     * @brief Logger::flush 返回时调用前提交的日志均已写入文件 (异步模式下等待写线程)
+     */
+    void flush();
+    AsyncStats getAsyncStats() const;
+
+    //-----------------------------------------------
+    // 二进制日志 (LOG_BIN_*)
+    // 异步模式下调用线程只写格式 ID、时间戳与参数，由写线程还原成文本；
+    // 同步模式下立即还原，与 LOG_FILE_* 输出相同
+    //-----------------------------------------------
+    int logBinary(binlog::Site& site, const char* types, const u8* args, u32 len);
+    /**
+     * @brief Logger::setBinaryOutput 二进制记录不再还原，原样写入与主日志同名的 .blog 文件
+     *        (用 LogDecoder 离线还原)；仅异步模式下生效
+     * @return .blog 文件是否已打开
+     */
+    bool setBinaryOutput(bool enable);
+
     void logCustom(const char* fmt, ...);
     void setCustomPath(const char* path);
     bool writeCustom(bool mount);
@@ -138,6 +191,26 @@ private:
      * @return 失败返回错误码（_INVALID_FILE_ | _FPRINTFS_FAILED_），成功返回写入字节数
      */
     int log(char level, const char* fmt, va_list args);
+    int logSync(char level, FILE* target, const char* fmt, va_list args);
+    int logSyncf(char level, FILE* target, const char* fmt, ...);
+
+    struct AsyncRing;
+    struct WriteBatch;
+    AsyncRing* localRing();
+    int logAsync(char level, const char* fmt, va_list args);
+    u8* reserveRecord(AsyncRing* ring, u32 size);
+    void commitRecord(AsyncRing* ring, u32 size, char level);
+    u32 registerSite(binlog::Site& site, const char* types);
+    bool openBinaryLog();
+    void wakeWriter(int reason);
+    // 请求写线程写完当前已提交的记录；没有写线程时返回 false，timeout_ms < 0 表示一直等待
+    bool waitWriter(i64 timeout_ms);
+    void writerLoop();
+    // 取出各线程缓冲中已提交的记录并写入文件，返回写出的记录数
+    u64 drainRings(WriteBatch& batch);
+    void writeBatch(WriteBatch& batch);
+    void appendFormat(WriteBatch& batch, u32 id, const binlog::FormatInfo& info);
+    FILE* targetFile(char level) const;
 
 private:
     FILE*                    m_fout;//用于记录服务的代码日志，面向研发人员
@@ -153,6 +226,44 @@ private:
     Buffer                   custom_buf;     //客户LOG记录缓存
     bool                     is_write_custom;
 
+    // 异步模式
+    std::mutex               m_controlLock;  // 串行化 startAsync/stopAsync
+    std::atomic<bool>        m_async;
+    std::thread*             m_writer;
+    std::mutex               m_wakeLock;
+    std::condition_variable  m_wakeCond;     // 唤醒写线程
+    std::condition_variable  m_doneCond;     // 通知等待缓冲空间/flush 的线程
+    std::atomic<int>         m_wakeReason;
+    bool                     m_stopWriter;   // true 表示没有运行中的写线程
+    u64                      m_flushRequest; // 以下两项受 m_wakeLock 保护
+    u64                      m_flushDone;
+    u32                      m_waiters;
+    size_t                   m_ringBytes;
+    u32                      m_flushMs;
+    mutable std::mutex       m_ringLock;
+    std::vector<AsyncRing*>  m_rings;        // 仅写线程删除 (线程已退出且已写完)
+    std::vector<AsyncRing*>  m_drainList;    // 写线程的快照
+    binlog::PrefixCache      m_prefix;       // 写线程的时间头缓存
+    u64                      m_clockTick0;   // 记录时间戳 (计数器) 换算
+    i64                      m_clockSteady0;
+    double                   m_ticksPerNs;
+    std::atomic<u64>         m_statRecords;
+    std::atomic<u64>         m_statBytes;
+    std::atomic<u64>         m_statBatches;
+    std::atomic<u64>         m_statBlocked;
+    std::atomic<u64>         m_statFallback;
+
+    // 二进制日志
+    std::mutex               m_siteLock;
+    binlog::FormatInfo*      m_sites;        // 按格式 ID (从 1 开始) 登记
+    u32                      m_siteCount;
+    FILE*                    m_fout_bin;
+    str                      m_bin_path;
+    bool                     m_binaryOutput;
+    u32                      m_binGeneration;   // 每打开一次 .blog 加一
+    u32                      m_binDefinedGen;   // 以下仅写线程访问
+    std::vector<u8>          m_binDefined;      // 当前 .blog 已写出定义的格式
+
 public:
     str                      m_backup_path_str;//存放压缩日志的目录路径
     str                      m_log_path_str;//当前日志存放路径
@@ -169,6 +280,7 @@ public:
 #define LOG_FILE_INFO(fmt, ...)     ECCS Logger::getInstance()->info   ("%s:%d  " fmt "\n", __FUNCTION__, __LINE__, ##__VA_ARGS__)
 #define LOG_FILE_WARNING(fmt, ...)  ECCS Logger::getInstance()->warning("%s:%d  " fmt "\n", __FUNCTION__, __LINE__, ##__VA_ARGS__)
 #define LOG_FILE_ERROR(fmt, ...)    ECCS Logger::getInstance()->error  ("%s:%d  " fmt "\n", __FUNCTION__, __LINE__, ##__VA_ARGS__)
+#define LOG_FILE_FATAL(fmt, ...)    ECCS Logger::getInstance()->fatal  ("%s:%d  " fmt "\n", __FUNCTION__, __LINE__, ##__VA_ARGS__)
 #define LOG_FILE_OPERATION(fmt, ...)ECCS Logger::getInstance()->operate  ("%s:%d  " fmt "\n", __FUNCTION__, __LINE__, ##__VA_ARGS__)
 #define LOG_FILE_REPORT(fmt, ...)   ECCS Logger::getInstance()->recoder  (fmt "\n", ##__VA_ARGS__)
 #else
@@ -177,6 +289,7 @@ public:
 #define LOG_FILE_INFO(fmt, ...)     ECCS Logger::getInstance()->info   (fmt "\n", ##__VA_ARGS__)
 #define LOG_FILE_WARNING(fmt, ...)  ECCS Logger::getInstance()->warning(fmt "\n", ##__VA_ARGS__)
 #define LOG_FILE_ERROR(fmt, ...)    ECCS Logger::getInstance()->error  (fmt "\n", ##__VA_ARGS__)
+#define LOG_FILE_FATAL(fmt, ...)    ECCS Logger::getInstance()->fatal  (fmt "\n", ##__VA_ARGS__)
 #endif
 #else
 #define LOG_FILE_PLAIN(fmt, ...)
@@ -184,6 +297,7 @@ public:
 #define LOG_FILE_INFO(fmt, ...)
 #define LOG_FILE_WARNING(fmt, ...)
 #define LOG_FILE_ERROR(fmt, ...)
+#define LOG_FILE_FATAL(fmt, ...)
 #endif
 
 
@@ -195,12 +309,14 @@ public:
 #define LOG_CONSOLE_INFO(fmt, ...)     printf("[I] %s:%d  " fmt "\n", __FUNCTION__, __LINE__, ##__VA_ARGS__)
 #define LOG_CONSOLE_WARNING(fmt, ...)  printf("[W] %s:%d  " fmt "\n", __FUNCTION__, __LINE__, ##__VA_ARGS__)
 #define LOG_CONSOLE_ERROR(fmt, ...)    printf("[E] %s:%d  " fmt "\n", __FUNCTION__, __LINE__, ##__VA_ARGS__)
+#define LOG_CONSOLE_FATAL(fmt, ...)    printf("[F] %s:%d  " fmt "\n", __FUNCTION__, __LINE__, ##__VA_ARGS__)
 #else
 #define LOG_CONSOLE_PLAIN(fmt, ...)    printf(fmt, ##__VA_ARGS__)
 #define LOG_CONSOLE_DEBUG(fmt, ...)    printf("[D] " fmt "\n", ##__VA_ARGS__)
 #define LOG_CONSOLE_INFO(fmt, ...)     printf("[I] " fmt "\n", ##__VA_ARGS__)
 #define LOG_CONSOLE_WARNING(fmt, ...)  printf("[W] " fmt "\n", ##__VA_ARGS__)
 #define LOG_CONSOLE_ERROR(fmt, ...)    printf("[E] " fmt "\n", ##__VA_ARGS__)
+#define LOG_CONSOLE_FATAL(fmt, ...)    printf("[F] " fmt "\n", ##__VA_ARGS__)
 #endif
 #else
 #define LOG_CONSOLE_PLAIN(fmt, ...)
@@ -208,6 +324,7 @@ public:
 #define LOG_CONSOLE_INFO(fmt, ...)
 #define LOG_CONSOLE_WARNING(fmt, ...)
 #define LOG_CONSOLE_ERROR(fmt, ...)
+#define LOG_CONSOLE_FATAL(fmt, ...)
 #endif
 
 
@@ -219,6 +336,7 @@ public:
 #define LOG_INFO(fmt, ...)
 #define LOG_WARNING(fmt, ...)
 #define LOG_ERROR(fmt, ...)
+#define LOG_FATAL(fmt, ...)
 
 #elif ((ECCS_LOG & 0x00FF) == 0x01) // console only
 
@@ -227,6 +345,7 @@ public:
 #define LOG_INFO       LOG_CONSOLE_INFO
 #define LOG_WARNING    LOG_CONSOLE_WARNING
 #define LOG_ERROR      LOG_CONSOLE_ERROR
+#define LOG_FATAL      LOG_CONSOLE_FATAL
 
 #elif ((ECCS_LOG & 0x00FF) == 0x02) // file only
 
@@ -235,6 +354,7 @@ public:
 #define LOG_INFO       LOG_FILE_INFO
 #define LOG_WARNING    LOG_FILE_WARNING
 #define LOG_ERROR      LOG_FILE_ERROR
+#define LOG_FATAL      LOG_FILE_FATAL
 
 #elif ((ECCS_LOG & 0x00FF) == 0xFF) // console & file
 
@@ -243,6 +363,7 @@ public:
 #define LOG_INFO(fmt, ...)      LOG_CONSOLE_INFO(fmt, ##__VA_ARGS__);    LOG_FILE_INFO(fmt, ##__VA_ARGS__);
 #define LOG_WARNING(fmt, ...)   LOG_CONSOLE_WARNING(fmt, ##__VA_ARGS__); LOG_FILE_WARNING(fmt, ##__VA_ARGS__);
 #define LOG_ERROR(fmt, ...)     LOG_CONSOLE_ERROR(fmt, ##__VA_ARGS__);   LOG_FILE_ERROR(fmt, ##__VA_ARGS__);
+#define LOG_FATAL(fmt, ...)     LOG_CONSOLE_FATAL(fmt, ##__VA_ARGS__);   LOG_FILE_FATAL(fmt, ##__VA_ARGS__);
 
 #endif
 
@@ -275,4 +396,110 @@ public:
 #endif
 
 
+//-----------------------------------------------
+// 二进制日志: 用于每包/每帧的高频日志，控制台输出与 LOG_* 相同
+// 参数只能是数值、指针与 C 字符串 (最长 255 字节)，格式串按 printf 规则在编译期检查
+//-----------------------------------------------
+namespace binlog {
+
+#if defined(__GNUC__)
+inline void CheckFormat(const char*, ...) __attribute__((format(printf, 1, 2)));
+#endif
+inline void CheckFormat(const char*, ...) {}
+
+template<typename... Args>
+inline void Write(Site& site, Args... args)
+{
+    static_assert(sizeof...(Args) <= MAX_ARGS, "too many binary log arguments");
+    u8 buf[MAX_ARGS_BYTES];
+    Encoder e(buf, sizeof(buf), ArgReserve(ArgTypes<Args...>::value));
+    int expand[] = { 0, (e.Put(args), 0)... };
+    (void)expand;
+    Logger::getInstance()->logBinary(site, ArgTypes<Args...>::value, buf, (u32)e.Size());
+}
+
+}
+
+// log to file (binary): 异步模式下只写格式 ID 与参数，由写线程还原；
+// 同步模式下即时格式化更快，与 LOG_FILE_* 相同
+#if (ECCS_LOG & 0x0002)
+#if (ECCS_LOG & 0x0100)
+#define ECCS_BIN_FUNCTION   __FUNCTION__
+#else
+#define ECCS_BIN_FUNCTION   NULL
+#endif
+#define ECCS_LOG_BIN(level, fallback, fmt, ...) do { \
+    static ECCS binlog::Site eccs_bin_site_ = { fmt "\n", ECCS_BIN_FUNCTION, __LINE__, level, { 0 } }; \
+    if (ECCS Logger::getInstance()->isAsync()) { \
+        if (false) ECCS binlog::CheckFormat(fmt, ##__VA_ARGS__); \
+        ECCS binlog::Write(eccs_bin_site_, ##__VA_ARGS__); \
+    } \
+    else { \
+        fallback(fmt, ##__VA_ARGS__); \
+    } \
+} while (0)
+#define LOG_BIN_FILE_DEBUG(fmt, ...)    ECCS_LOG_BIN('D', LOG_FILE_DEBUG, fmt, ##__VA_ARGS__)
+#define LOG_BIN_FILE_INFO(fmt, ...)     ECCS_LOG_BIN('I', LOG_FILE_INFO, fmt, ##__VA_ARGS__)
+#define LOG_BIN_FILE_WARNING(fmt, ...)  ECCS_LOG_BIN('W', LOG_FILE_WARNING, fmt, ##__VA_ARGS__)
+#define LOG_BIN_FILE_ERROR(fmt, ...)    ECCS_LOG_BIN('E', LOG_FILE_ERROR, fmt, ##__VA_ARGS__)
+#else
+#define LOG_BIN_FILE_DEBUG(fmt, ...)
+#define LOG_BIN_FILE_INFO(fmt, ...)
+#define LOG_BIN_FILE_WARNING(fmt, ...)
+#define LOG_BIN_FILE_ERROR(fmt, ...)
+#endif
+
+
+// config binary log dest (同 LOG_*)
+#if ((ECCS_LOG & 0x00FF) == 0)     // disabled
+
+#define LOG_BIN_DEBUG(fmt, ...)
+#define LOG_BIN_INFO(fmt, ...)
+#define LOG_BIN_WARNING(fmt, ...)
+#define LOG_BIN_ERROR(fmt, ...)
+
+#elif ((ECCS_LOG & 0x00FF) == 0x01) // console only
+
+#define LOG_BIN_DEBUG      LOG_CONSOLE_DEBUG
+#define LOG_BIN_INFO       LOG_CONSOLE_INFO
+#define LOG_BIN_WARNING    LOG_CONSOLE_WARNING
+#define LOG_BIN_ERROR      LOG_CONSOLE_ERROR
+
+#elif ((ECCS_LOG & 0x00FF) == 0x02) // file only
+
+#define LOG_BIN_DEBUG      LOG_BIN_FILE_DEBUG
+#define LOG_BIN_INFO       LOG_BIN_FILE_INFO
+#define LOG_BIN_WARNING    LOG_BIN_FILE_WARNING
+#define LOG_BIN_ERROR      LOG_BIN_FILE_ERROR
+
+#elif ((ECCS_LOG & 0x00FF) == 0xFF) // console & file
+
+#define LOG_BIN_DEBUG(fmt, ...)     LOG_CONSOLE_DEBUG(fmt, ##__VA_ARGS__);   LOG_BIN_FILE_DEBUG(fmt, ##__VA_ARGS__);
+#define LOG_BIN_INFO(fmt, ...)      LOG_CONSOLE_INFO(fmt, ##__VA_ARGS__);    LOG_BIN_FILE_INFO(fmt, ##__VA_ARGS__);
+#define LOG_BIN_WARNING(fmt, ...)   LOG_CONSOLE_WARNING(fmt, ##__VA_ARGS__); LOG_BIN_FILE_WARNING(fmt, ##__VA_ARGS__);
+#define LOG_BIN_ERROR(fmt, ...)     LOG_CONSOLE_ERROR(fmt, ##__VA_ARGS__);   LOG_BIN_FILE_ERROR(fmt, ##__VA_ARGS__);
+
+#endif
+
+#if (ECCS_LOG & 0x0800) && defined(LOG_BIN_DEBUG)    // disable debug
+#undef LOG_BIN_DEBUG
+#define LOG_BIN_DEBUG(fmt, ...)
+#endif
+
+#if (ECCS_LOG & 0x1000) && defined(LOG_BIN_INFO)     // disable info
+#undef LOG_BIN_INFO
+#define LOG_BIN_INFO(fmt, ...)
+#endif
+
+#if (ECCS_LOG & 0x2000) && defined(LOG_BIN_WARNING)  // disable warning
+#undef LOG_BIN_WARNING
+#define LOG_BIN_WARNING(fmt, ...)
+#endif
+
+#if (ECCS_LOG & 0x4000) && defined(LOG_BIN_ERROR)    // disable error
+#undef LOG_BIN_ERROR
+#define LOG_BIN_ERROR(fmt, ...)
+#endif
+
+
 ECCS_END
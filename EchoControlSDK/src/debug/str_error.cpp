@@ -1,4 +1,4 @@
-﻿
+
 #include "str_error.h"
 #ifdef _WIN32
 #include <Windows.h>
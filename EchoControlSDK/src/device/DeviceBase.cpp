@@ -1,5 +1,6 @@
 #include "DeviceBase.h"
 #include "handler/EchoControlHandler.h"
+#include "utils/buffer_pool.h"
 #include <cstdlib> // for strtoul
 
 ECCS_BEGIN
@@ -16,7 +17,7 @@ DeviceBase::~DeviceBase() {
 bool DeviceBase::Init(int slotID, const std::map<str, str>& config) {
     m_slotID = slotID;
 
-    // עͨ (ֱʹõ RegisterProp)
+    // 注册通用属性 (直接使用内置的 RegisterProp)
     RegisterProp<int>("Transform", 1, "Transform"); // 0:Serial, 1:Net
     RegisterProp<str>("IP", "127.0.0.1", "IP");
     RegisterProp<int>("Port", 8000, "Port");
@@ -26,17 +27,17 @@ bool DeviceBase::Init(int slotID, const std::map<str, str>& config) {
     RegisterProp<str>("ID", "0x00000000", "Device ID");
     RegisterProp<bool>("Enable", false, "Enable");
 
-    // ๳ (עԣ PtzSpeed)
+    // 调用子类钩子 (子类注册特有属性，如 PtzSpeed)
     OnRegisterProperties();
 
-    //  (ֻע)
+    // 导入配置 (只导入已注册的属性)
     for (const auto& pair : config) {
         if (m_propMeta.count(pair.first)) {
             m_propValues[pair.first] = pair.second;
         }
     }
 
-    // У ID (жȡ)
+    // 解析并校验 ID (从属性中读取)
     str idStr = GetPropValue<str>("ID");
     u32 fullID = std::strtoul(idStr.c_str(), nullptr, 0);
     m_deviceID = DeviceID(fullID);
@@ -71,17 +72,17 @@ void DeviceBase::Stop() {
     LOG_INFO("[Slot %d] Device Thread Stopped.", m_slotID);
 }
 
-// ---  ---
+// --- 控制入口 ---
 
 void DeviceBase::ExecutePacket(std::shared_ptr<rpc::RpcPacket> pkt) {
     if (pkt) {
-        // ʹ new ָ룬 Thread ӹȨ
+        // 使用 new 创建裸指针，交给 Thread 接管所有权
         PacketEvent* e = new PacketEvent(pkt);
         postEvent(e);
     }
 }
 
-// --- Բѯ ---
+// --- 属性查询 ---
 
 str DeviceBase::GetProperty(const str& key) const {
     auto it = m_propValues.find(key);
@@ -102,7 +103,7 @@ void DeviceBase::SetStatusCallback(StatusCallback cb) {
 
 void DeviceBase::SetState(DevState newState, int errCode) 
 {
-    // 豸ڹرգֻ OFFLINE
+    // 设备正在关闭，只允许进入 OFFLINE
     if (m_shuttingDown && newState != STATE_OFFLINE)
     {
         LOG_WARNING("Reject state change during shutdown: {%s} -> {%s}",
@@ -110,7 +111,7 @@ void DeviceBase::SetState(DevState newState, int errCode)
             DevStateToStr(newState));
         return;
     }
-    // ״̬
+    // 构造状态包
     rpc::DeviceStatus status;
     if (!IsValidStateTransition(m_devState, newState))
     {
@@ -118,14 +119,14 @@ void DeviceBase::SetState(DevState newState, int errCode)
             DevStateToStr(m_devState),
             DevStateToStr(newState));
 
-        // һΡ״̬δ䣬д󡱵֪ͨ
+        // 发送一次“状态未变，但有错误”的通知
         status.deviceID = m_deviceID.Value();
         status.slotID = (u8)m_slotID;
         status.state = (u8)newState; // enum -> u8
         status.errorCode = (u32)errCode;
-        status.temperature = 0.0f; // չԻȡ
+        status.temperature = 0.0f; // 可扩展：从属性获取
 
-        //  OW 
+        // 推送 OW 包
         auto pkt = std::make_shared<rpc::OwDeviceStatus>(status);
         if (m_statusCb) m_statusCb(pkt);
 
@@ -142,9 +143,9 @@ void DeviceBase::SetState(DevState newState, int errCode)
     status.slotID = (u8)m_slotID;
     status.state = (u8)newState; // enum -> u8
     status.errorCode = (u32)errCode;
-    status.temperature = 0.0f; // չԻȡ
+    status.temperature = 0.0f; // 可扩展：从属性获取
 
-    //  OW 
+    // 推送 OW 包
     auto pkt = std::make_shared<rpc::OwDeviceStatus>(status);
     if (m_statusCb) m_statusCb(pkt);
 
@@ -158,15 +159,15 @@ void DeviceBase::run() {
 
         if (e->eId() == EventTypes::Quit) break;
 
-        // Packet ¼
+        // Packet 事件
         if (e->eId() == DeviceEventID::PacketArrival) {
             auto pe = std::dynamic_pointer_cast<PacketEvent>(e);
             if (!pe && !pe->GetPacket())
                 continue;
 
-            // ״̬
+            // 状态拦截
             if (!IsStateOnline(m_devState)) {
-                LOG_WARNING(
+                LOG_BIN_WARNING(
                     "[Slot %d] Packet rejected in state: %s",
                     m_slotID,
                     DevStateToStr(m_devState)
@@ -174,7 +175,7 @@ void DeviceBase::run() {
                 continue;
             }
 
-            // õ Handler зַ
+            // 调用单例 Handler 进行分发
             EchoControlHandler::Instance().Dispatch(this, pe->GetPacket());
         }
 
@@ -182,7 +183,7 @@ void DeviceBase::run() {
     }
 }
 
-// 麯Ĭʵ
+// 虚函数默认实现
 void DeviceBase::OnRegisterProperties() {}
 void DeviceBase::OnCustomEvent(Event_Ptr& e) {}
 
@@ -208,7 +209,7 @@ void DeviceBase::OnStateEnter(DevState state)
 
 void DeviceBase::OnStateExit(DevState)
 {
-    // ĿǰҪκ
+    // 目前不需要做任何事
 }
 
 void DeviceBase::StartReader() {
@@ -282,26 +283,26 @@ bool DeviceBase::IsStateOnline(DevState state) const
 }
 
 void DeviceBase::ReadLoop() {
-    //  1KB
-    std::vector<u8> buf(1024);
+    // 缓冲区 1KB (从缓冲池租用，设备重启时复用)
+    BufferPool::Lease buf = BufferPool::Instance().Acquire(1024);
 
     while (m_keepReading) {
-        // 豸ߣ΢ߣѭת
+        // 如果设备掉线，稍微休眠，避免死循环空转
         if (!IsOnline()) {
             msleep(200);
             continue;
         }
 
-        // ʵֵ ReadRaw (ʱĶȡ)
-        int len = ReadRaw(buf.data(), buf.size());
+        // 调用子类实现的 ReadRaw (阻塞或带超时的读取)
+        int len = ReadRaw(buf.Data(), (u32)buf.Capacity());
 
         if (len > 0) {
-            // յݣ
-            OnRawDataReceived(buf.data(), len);
+            // 收到数据，交给子类解析
+            OnRawDataReceived(buf.Data(), len);
         }
         else {
-            // ȡʱ΢
-            // ע⣺شϿ ReadRaw ڲӦô״̬
+            // 读取超时或错误，稍微休眠
+            // 注意：如果是严重错误（如断开），子类的 ReadRaw 内部应该处理连接状态
             msleep(10);
         }
     }
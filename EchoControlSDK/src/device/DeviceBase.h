@@ -16,12 +16,12 @@
 
 ECCS_BEGIN
 
-// ڲʹõԪݽṹ
+// 内部使用的属性元数据结构
 struct PropMeta {
     str key;
     str defaultValue;
     str description;
-    // bool readOnly; // ѡҪֻƿɼ
+    // bool readOnly; // 可选：如果需要只读控制可加上
 };
 
 // 
@@ -31,87 +31,87 @@ public:
     DeviceBase();
     virtual ~DeviceBase();
 
-    // 
+    // 工厂基类宏
     FACTORY_BASE()
 
     // ------------------------------------------------
-    // ӿ
+    // 公共接口
     // ------------------------------------------------
 
-    // ʼslotID  Map
+    // 初始化：slotID 和 配置Map
     virtual bool Init(int slotID, const std::map<str, str>& config);
 
-    // ڿ
+    // 生命周期控制
     virtual bool Start();
     virtual void Stop();
 
-    // Packet  ()
+    // Packet 控制入口 (核心)
     virtual void ExecutePacket(std::shared_ptr<rpc::RpcPacket> pkt);
 
     // ------------------------------------------------
-    // ״̬ѯ
+    // 属性与状态查询
     // ------------------------------------------------
 
-    // ȡֵַ
+    // 获取属性字符串值
     str GetProperty(const str& key) const;
 
-    // ͻȡֵ (ת)
+    // 泛型获取属性值 (内置类型转换)
     template <typename T>
     T GetPropValue(const str& key) const {
         str valStr = GetProperty(key);
-        if (valStr.empty()) return T(); // Ĭֵ
+        if (valStr.empty()) return T(); // 返回默认零值
         std::stringstream ss(valStr);
         T val;
         ss >> val;
         return val;
     }
 
-    // жǷ
+    // 判断是否在线
     virtual bool IsOnline() const;
 
-    // ȡ豸 ID
+    // 获取设备身份 ID
     DeviceID GetDeviceID() const;
 
-    //  SDK ڲʹã ConfigManager Ѱַ
+    // 供 SDK 内部使用，用于 ConfigManager 寻址
     int GetSlotID() const { return m_slotID; }
 
-    // ״̬صע
+    // 状态回调注册 (只能在 Init 前设置: 回调会在设备线程和读取线程中调用，运行中不可替换)
     using StatusCallback = std::function<void(std::shared_ptr<rpc::RpcPacket>)>;
     void SetStatusCallback(StatusCallback cb);
 
 protected:
     // ------------------------------------------------
-    // ʹõ API (Protected)
+    // 供子类使用的 API (Protected)
     // ------------------------------------------------
 
-    // ע
+    // 注册属性
     template <typename T>
     void RegisterProp(const str& key, T defaultVal, const str& desc = "") {
         std::stringstream ss;
         ss << defaultVal;
         m_propMeta[key] = { key, ss.str(), desc };
-        m_propValues[key] = ss.str(); // óʼĬֵ
+        m_propValues[key] = ss.str(); // 设置初始默认值
     }
 
-    // [״̬] л״̬
+    // [状态] 切换状态并推送
     void SetState(DevState newState, int errCode = 0);
 
     DevState GetState() const { return m_devState; }
 
     // ------------------------------------------------
-    // 麯 (Hooks)
+    // 子类虚函数钩子 (Hooks)
     // ------------------------------------------------
 
-    // ڴע
+    // 子类在此注册特有属性
     virtual void OnRegisterProperties();
 
-    // Զ¼
+    // 自定义事件处理
     virtual void OnCustomEvent(Event_Ptr& e);
 
-    // ߳ѭʵ
+    // 线程循环实现
     virtual void run() override;
 
-    // /ֹͣȡ߳ ( Start/Stop е)
+    // 启动/停止读取线程 (供子类在 Start/Stop 中调用)
     void StartReader();
     void StopReader();
 
@@ -119,22 +119,22 @@ protected:
 
     bool IsStateOnline(DevState state) const;
 
-    // ԭʼݽչ
+    // 原始数据接收钩子
     virtual void OnRawDataReceived(const u8* data, u32 len);
 
-    // ײȡӿ (ʵ֣ΪTCP/UDP/ڶȡʽͬ)
-    // ضȡֽ<=0 ʾʱ
+    // 底层读取接口 (子类必须实现，因为TCP/UDP/串口读取方式不同)
+    // 返回读取的字节数，<=0 表示错误或超时
     virtual int ReadRaw(u8* buf, u32 maxLen) { return 0; }
 
     virtual void OnStateEnter(DevState state);
     virtual void OnStateExit(DevState state);
 
 private:
-    // ȡ̺߳
+    // 读取线程函数
     void ReadLoop();
 
 private:
-    // ȡ߳
+    // 读取线程相关
     std::thread* m_readThread = nullptr;
     std::atomic<bool> m_keepReading = { false };
 
@@ -145,9 +145,9 @@ protected:
     StatusCallback m_statusCb;
     std::atomic<bool> m_shuttingDown{ false };
 
-    // Դ洢
-    std::map<str, PropMeta> m_propMeta;   // 
-    std::map<str, str>      m_propValues; // ֵ
+    // 内置属性存储
+    std::map<str, PropMeta> m_propMeta;   // 定义
+    std::map<str, str>      m_propValues; // 值
 };
 
 ECCS_END
\ No newline at end of file
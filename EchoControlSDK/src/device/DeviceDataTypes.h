@@ -4,18 +4,18 @@
 ECCS_BEGIN
 
 // =======================
-// ģʽ
+// 播放模式
 // =======================
 enum SoundStatus
 {
-    Idle,           //  / ֹͣ
-    Player,         // MP3 б
-    OneKey,         // һɢ
-    MicBroadcast    // ʵʱ
+    Idle,           // 空闲 / 停止
+    Player,         // 播放器（MP3 列表）
+    OneKey,         // 一键驱散
+    MicBroadcast    // 实时喊话
 };
 
 // =======================
-// ״̬¼
+// 播放状态事件
 // =======================
 enum SoundPlayState
 {
@@ -26,13 +26,13 @@ enum SoundPlayState
 };
 
 // =======================
-// ƵļϢ
+// 音频文件信息
 // =======================
 struct SoundFileInfo
 {
     int index;
     str name;
-    u32 duration;   // 
+    u32 duration;   // 秒
 };
 
 ECCS_END
\ No newline at end of file
@@ -7,26 +7,45 @@
 ECCS_BEGIN
 
 // -----------------------------------------------------------
-// ¼ ID 
+// 事件 ID 定义
 // -----------------------------------------------------------
 namespace DeviceEventID {
-    // ϵͳ¼ (EventTypes::Quit = 0) ͻ
-    // EventTypes::User ͨ 512
+    // 避免与系统事件 (EventTypes::Quit = 0) 冲突
+    // EventTypes::User 通常是 512
 
-    // ǿЭ¼
+    // 强类型协议包到达事件
     const int PacketArrival = EventTypes::User + 1;
 
-    // ø¼ ( IP )
+    // 配置更新事件 (例如 IP 变更)
     const int ConfigUpdate = EventTypes::User + 2;
+
+    // 云台巡航定时器到期 (由 TimerService 投递)
+    const int PtzTourTimer = EventTypes::User + 3;
+
+    // 云台定位: 收到角度回报 / 定位超时
+    const int PtzGotoFeedback = EventTypes::User + 4;
+    const int PtzGotoTimeout = EventTypes::User + 5;
+
+    // 云台速度控制: 限速延迟发送 / 保活重发
+    const int PtzVelocityTimer = EventTypes::User + 6;
+
+    // Modbus-TCP: 收到应答 (读取线程投递) / 请求超时 / 轮询定时器
+    const int ModbusResponse = EventTypes::User + 7;
+    const int ModbusTimeout = EventTypes::User + 8;
+    const int ModbusPoll = EventTypes::User + 9;
+
+    // 强声 JSON 协议: 收到应答/推送 (读取线程投递) / 指令超时
+    const int SpeakerReply = EventTypes::User + 10;
+    const int SpeakerTimeout = EventTypes::User + 11;
 }
 
 
 // -----------------------------------------------------------
-// Э¼ ()
+// 协议包事件 (核心)
 // -----------------------------------------------------------
 class PacketEvent : public Event {
 public:
-    // ָ룬Զ
+    // 接收智能指针，生命周期自动管理
     PacketEvent(std::shared_ptr<rpc::RpcPacket> pkt)
         : Event(DeviceEventID::PacketArrival), m_packet(pkt) {}
 
@@ -38,7 +57,7 @@ private:
 
 
 // -----------------------------------------------------------
-// ø¼ (ѡ)
+// 配置更新事件 (可选)
 // -----------------------------------------------------------
 struct ConfigUpdateData {
     str key;
@@ -46,4 +65,34 @@ struct ConfigUpdateData {
 };
 typedef EventTemplateEx<DeviceEventID::ConfigUpdate, ConfigUpdateData> ConfigUpdateEvent;
 
+// 巡航定时器事件 (数据为定时器代数，用于丢弃过期事件)
+typedef EventTemplateEx<DeviceEventID::PtzTourTimer, u32> PtzTourTimerEvent;
+
+// 定位事件 (超时事件数据为定位代数)
+typedef EventTemplate<DeviceEventID::PtzGotoFeedback> PtzGotoFeedbackEvent;
+typedef EventTemplateEx<DeviceEventID::PtzGotoTimeout, u32> PtzGotoTimeoutEvent;
+typedef EventTemplateEx<DeviceEventID::PtzVelocityTimer, u32> PtzVelocityTimerEvent;
+
+// Modbus 应答事件 (func 含异常标志 0x80，data 为功能码之后的数据)
+struct ModbusResponse {
+    u16 tid;
+    u8  unit;
+    u8  func;
+    u8  len;
+    u8  data[252];
+};
+typedef EventTemplateEx<DeviceEventID::ModbusResponse, ModbusResponse> ModbusResponseEvent;
+typedef EventTemplateEx<DeviceEventID::ModbusTimeout, u32> ModbusTimeoutEvent;   // 数据为请求序号
+typedef EventTemplateEx<DeviceEventID::ModbusPoll, u32> ModbusPollEvent;         // 数据为轮询代数
+
+// 强声应答事件 (读取线程从 JSON 中提取的字段)
+struct SpeakerReply {
+    int  cseq;          // -1 = 无 (设备主动推送)
+    int  result;        // 0 = 成功
+    int  playState;     // -1 = 不含播放状态，否则为 SoundPlayState
+    char command[32];
+};
+typedef EventTemplateEx<DeviceEventID::SpeakerReply, SpeakerReply> SpeakerReplyEvent;
+typedef EventTemplateEx<DeviceEventID::SpeakerTimeout, int> SpeakerTimeoutEvent; // 数据为 cseq
+
 ECCS_END
\ No newline at end of file
@@ -4,14 +4,14 @@
 
 ECCS_BEGIN
 
-// ǰ Device ࣬ѭ
+// 前置声明 Device 类，避免循环引用
 class DeviceBase;
 
-// Key=std::string (Model Name), Base=Device
+// 声明工厂：Key=std::string (Model Name), Base=Device
 FACTORY_DECL_EXTERN(u32, DeviceBase)
 
-// ص OID (Type + Model, IndexΪ0)
-//  "HL-525" -> 0x10020000
+// 返回的是 OID (Type + Model, Index为0)
+// 例如 "HL-525" -> 0x10020000
 u32 GetDeviceOIDByModelName(const str& modelName);
 
 ECCS_END
\ No newline at end of file
@@ -66,7 +66,7 @@ namespace did {
 
 str DeviceID::ToHexString() const {
     char buf[16] = { 0 };
-    // ʽ0x01000100 (Type 01, Model 0001, Index 00)
+    // 输出格式：0x01000100 (Type 01, Model 0001, Index 00)
     snprintf(buf, sizeof(buf), "0x%08X", m_id);
     return str(buf);
 }
@@ -101,7 +101,7 @@ str DeviceID::ToString() const {
     }
 
     char buf[128] = { 0 };
-    // ʽ: Light/HL-525-4W[0]
+    // 格式: Light/HL-525-4W[0]
     snprintf(buf, sizeof(buf), "%s/%s[%d]", catStr.c_str(), modelStr.c_str(), idx);
     return str(buf);
 }
@@ -3,14 +3,14 @@
 
 ECCS_BEGIN
 
-// ꣺ٹ ID
+// 宏：快速构建 ID
 // Type (8bit) | Model (16bit) | Index (8bit)
 #define MAKE_DEV_OID(type, model)      u32( (u8(type) << 24) | (u16(model) << 8) )
 #define MAKE_DEV_SID(type, model, idx) u32( MAKE_DEV_OID(type, model) | u8(idx) )
 
 namespace did {
     // -------------------------------------------------
-    // 豸 (DeviceType) - 8 Bit (1~255)
+    // 设备大类 (DeviceType) - 8 Bit (1~255)
     // -------------------------------------------------
     enum DeviceType
     {
@@ -24,7 +24,7 @@ namespace did {
     };
 
     // -------------------------------------------------
-    // ͺ (Model) - 16 Bit (1~65535)
+    // 具体型号 (Model) - 16 Bit (1~65535)
     // -------------------------------------------------
     enum LightModel
     {
@@ -68,81 +68,81 @@ namespace did {
 
 
 // -----------------------------------------------------
-// DeviceID ඨ (32λ)
+// DeviceID 类定义 (32位)
 // Layout: [Type 8bit] [Model 16bit] [Index 8bit]
 // -----------------------------------------------------
 class DeviceID {
 public:
     static const u32 INVALID_ID = 0xFFFFFFFF;
 
-    // 붨
+    // 掩码定义
     static const u32 MASK_TYPE = 0xFF000000;
     static const u32 MASK_MODEL = 0x00FFFF00;
     static const u32 MASK_INDEX = 0x000000FF;
 
 public:
-    // 캯
+    // 构造函数
     DeviceID() : m_id(0) {}
     DeviceID(u32 id) : m_id(id) {}
-    // ù죺ָͺͺţIndexĬΪ0
+    // 常用构造：指定类型和型号，Index默认为0
     DeviceID(did::DeviceType type, u16 model, u8 index = 0) {
         m_id = MAKE_DEV_SID(type, model, index);
     }
 
-    // ȡ OID (Object ID, ȥ Indexƥ)
-    // ֵ磺0x10020000
+    // 获取 OID (Object ID, 去掉 Index，用于类型匹配)
+    // 返回值如：0x10020000
     u32 GetOID() const {
         return (m_id & (MASK_TYPE | MASK_MODEL));
     }
 
-    // ̬IDȡOID
+    // 静态辅助：从完整ID中提取OID
     static u32 GetOID(u32 fullID) {
         return (fullID & (MASK_TYPE | MASK_MODEL));
     }
 
-    // ̬IDȡIndex
+    // 静态辅助：从完整ID中提取Index
     static u8 GetIndex(u32 fullID) {
         return static_cast<u8>(fullID & MASK_INDEX);
     }
 
-    // ֤ Index ǷЧ ( >= 1)
+    // 验证 Index 是否有效 (必须 >= 1)
     bool IsIndexValid() const {
         u8 idx = GetIndex();
         return idx >= 1;
     }
 
-    // ֵȽ
+    // 赋值与比较
     DeviceID& operator=(const u32& val) { m_id = val; return *this; }
     bool operator==(const DeviceID& other) const { return m_id == other.m_id; }
     bool operator!=(const DeviceID& other) const { return m_id != other.m_id; }
-    bool operator<(const DeviceID& other) const { return m_id < other.m_id; } //  std::map key
+    bool operator<(const DeviceID& other) const { return m_id < other.m_id; } // 用于 std::map key
 
-    // ȡԭʼֵ
+    // 获取原始值
     u32 Value() const { return m_id; }
 
-    // --- ֶη ---
+    // --- 字段访问器 ---
 
-    // ȡ (8λ)
+    // 获取大类 (高8位)
     did::DeviceType GetDeviceType() const {
         return static_cast<did::DeviceType>((m_id & MASK_TYPE) >> 24);
     }
 
-    // ȡͺ (м16λ)
+    // 获取型号 (中间16位)
     u16 GetModel() const {
         return static_cast<u16>((m_id & MASK_MODEL) >> 8);
     }
 
-    // ȡ (8λ)
+    // 获取索引 (低8位)
     u8 GetIndex() const {
         return static_cast<u8>(m_id & MASK_INDEX);
     }
 
-    // ȡIndexID (ͱȽ)
+    // 获取不带Index的ID (用于类型比较)
     u32 GetObjectID() const {
         return (m_id & (MASK_TYPE | MASK_MODEL));
     }
 
-    // --- ޸ ---
+    // --- 修改器 ---
     void SetDeviceType(did::DeviceType type) {
         m_id = (m_id & ~MASK_TYPE) | (u32(type) << 24);
     }
@@ -153,7 +153,7 @@ public:
         m_id = (m_id & ~MASK_INDEX) | u32(idx);
     }
 
-    // --- ж ---
+    // --- 类型判断助手 ---
     bool IsLight()          const { return GetDeviceType() == did::DEVICE_LIGHT; }
     bool IsSound()          const { return GetDeviceType() == did::DEVICE_SOUND; }
     bool IsPTZ()            const { return GetDeviceType() == did::DEVICE_PTZ; }
@@ -161,12 +161,12 @@ public:
     bool IsCamera()         const { return GetDeviceType() == did::DEVICE_CAMERA; }
     bool IsValid()          const { return m_id != 0; }
 
-    // Ƿͬͺ (Index)
+    // 检查是否同型号 (忽略Index)
     bool IsSameModel(const DeviceID& other) const {
         return GetObjectID() == other.GetObjectID();
     }
 
-    // --- ַ ---
+    // --- 字符串输出 ---
     str ToString() const;
     str ToHexString() const;
 
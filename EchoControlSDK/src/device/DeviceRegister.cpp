@@ -1,8 +1,8 @@
 #include "DeviceFactory.h"
 #include "DeviceID.h"
-#include "DeviceBase.h" // 
+#include "DeviceBase.h" // 包含基类
 
-// 豸ͷļ
+// 引入具体设备头文件
 #include "Light/Light_HL_525_4W/Light_HL_525_4W.h"
 #include "PTZ/PTZ_YZ_BY010W/PTZ_YZ_BY010W.h"
 #include "Sound/Sound_NetSpeaker_V2/Sound_NetSpeaker_V2.h"
@@ -13,11 +13,11 @@
 ECCS_BEGIN
 
 // --------------------------------------------------------------------------
-// ȫӳModelName (String) -> DeviceOID (u32)
+// 全局映射表：ModelName (String) -> DeviceOID (u32)
 // --------------------------------------------------------------------------
 static std::map<str, u32> g_ModelToIDMap;
 
-// ʼӳϵĸ
+// 初始化映射关系的辅助函数
 void InitModelMapping() {
     if (!g_ModelToIDMap.empty()) return;
 
@@ -31,7 +31,7 @@ void InitModelMapping() {
     g_ModelToIDMap["NETSPEAKER-V2"] = Sound_NetSpeaker_V2::ID;
 }
 
-// ʵ DeviceFactory.h ĲҺ
+// 实现 DeviceFactory.h 中声明的查找函数
 u32 GetDeviceOIDByModelName(const str& modelName) {
     InitModelMapping(); 
 
@@ -43,11 +43,11 @@ u32 GetDeviceOIDByModelName(const str& modelName) {
 }
 
 // --------------------------------------------------------------------------
-// ע (Key  u32 ͵ ID)
+// 工厂注册 (Key 是 u32 类型的 ID)
 // --------------------------------------------------------------------------
 FACTORY_BEGIN(u32, DeviceBase)
 
-// ʹþ ID ע
+// 使用具体类的 ID 常量进行注册
 FACTORY_APPEND(Light_HL_525_4W::ID,         Light_HL_525_4W,            DeviceBase)
 
 
@@ -6,14 +6,14 @@ ECCS_BEGIN
 enum DevState : u8 {
     STATE_UNKNOWN       = 0,
     STATE_INITIALIZED   = 1,
-    STATE_OFFLINE       = 2, // /
-    STATE_CONNECTING    = 3, // 
-    STATE_ONLINE        = 4, // /
-    STATE_WORKING       = 5, //  (ڲšת)
-    STATE_ERROR         = 6  // 
+    STATE_OFFLINE       = 2, // 离线/断连
+    STATE_CONNECTING    = 3, // 连接中
+    STATE_ONLINE        = 4, // 在线/空闲
+    STATE_WORKING       = 5, // 工作中 (如正在播放、正在转动)
+    STATE_ERROR         = 6  // 故障
 };
 
-// ״̬תַ (־)
+// 状态转字符串 (方便日志)
 inline const char* DevStateToStr(DevState s) {
     switch (s) {
     case DevState::STATE_OFFLINE:       return "Offline";
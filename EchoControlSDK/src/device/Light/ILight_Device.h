@@ -7,18 +7,34 @@ ECCS_BEGIN
 class ILight_Device : public DeviceBase
 {
 public:
-    // === ӿڣɾʵ ===
+    // === 纯虚接口：由具体驱动实现 ===
     virtual void SetSwitch(bool isOpen) = 0;
     virtual void SetBrightness(u8 level) = 0;
     /**
-     * @brief Ƶ (չ)
-     * @param isOpen true=Ƶ, false=ر
-     * @note ĬʵΪ֧֡豸֧Ƶд˺
+     * @brief 设置频闪 (扩展功能)
+     * @param isOpen true=开启频闪, false=关闭
+     * @note 默认实现为不支持。如果设备支持频闪，请在子类中重写此函数。
      */
     virtual void SetStrobe(bool isOpen) {
         LOG_WARNING("[Slot %d] Device (Model: %s) does not support Strobe.",
             m_slotID, GetProperty("Model").c_str());
     }
+
+    /**
+     * @brief 强制重发当前全部设置 (不做重复指令抑制)
+     */
+    virtual void Refresh() {
+        LOG_WARNING("[Slot %d] Device (Model: %s) does not support Refresh.",
+            m_slotID, GetProperty("Model").c_str());
+    }
+
+    /**
+     * @brief 查询状态：核对缓存后通过 OwLightStatus 推送
+     */
+    virtual void QueryStatus() {
+        LOG_WARNING("[Slot %d] Device (Model: %s) does not support QueryStatus.",
+            m_slotID, GetProperty("Model").c_str());
+    }
 };
 
 ECCS_END
\ No newline at end of file
@@ -1,9 +1,15 @@
 #include "Light_HL_525_4W.h"
 #include "../../../debug/Exceptions.h"
+#include "../../../utils/checksum.h"
 
 ECCS_BEGIN
 
-Light_HL_525_4W::Light_HL_525_4W() {
+Light_HL_525_4W::Light_HL_525_4W()
+    : m_port(0), m_refreshMs(0) {
+    for (int i = 0; i < FIELD_COUNT; ++i) {
+        m_fields[i].desired = -1;
+        m_fields[i].actual = -1;
+    }
 }
 
 Light_HL_525_4W::~Light_HL_525_4W() {
@@ -11,71 +17,158 @@ Light_HL_525_4W::~Light_HL_525_4W() {
 }
 
 bool Light_HL_525_4W::Init(int slotID, const std::map<str, str>& config) {
-    // ʼ
+    // 基类初始化
     if (!DeviceBase::Init(slotID, config)) return false;
 
-    // ȡ
+    // 获取配置
     m_ip = GetPropValue<str>("IP");
     m_port = GetPropValue<int>("Port");
 
+    int refresh = GetPropValue<int>("RefreshInterval");
+    m_refreshMs = (refresh > 0) ? (u32)refresh * 1000 : 0;
+
     if (!Connect()) {
         LOG_WARNING("[Slot %d] Start: Connect failed, will retry in run loop.", m_slotID);
-        // ע⣺ﷵ true߳Ա߳
+        // 注意：这里返回 true，允许线程启动，以便在线程里重连
     }
 
     return true;
 }
 
+void Light_HL_525_4W::OnRegisterProperties() {
+    ILight_Device::OnRegisterProperties();
+
+    RegisterProp<int>("RefreshInterval", 0, "Resend Unchanged Setting After (s, 0=Never)");
+}
+
 void Light_HL_525_4W::SetSwitch(bool isOpen) {
-    // 0x1F:, 0x2F:
-    SendHexCmd(isOpen ? 0x1F : 0x2F, 0x00, 0x00);
+    Apply(FIELD_SWITCH, isOpen ? 1 : 0, false);
 }
 
 void Light_HL_525_4W::SetBrightness(u8 level) {
-    // 0x9F: ڵ
-    u16 current = (u16)level * 255 / 100;
-    SendHexCmd(0x9F, (current >> 8) & 0xFF, current & 0xFF);
+    Apply(FIELD_LEVEL, (level > 100) ? 100 : level, false);
 }
 
 void Light_HL_525_4W::SetStrobe(bool isOpen) {
-    // 0x3F: ˸, 0x4F: ˸
-    SendHexCmd(isOpen ? 0x3F : 0x4F, 0x00, 0x00);
+    Apply(FIELD_STROBE, isOpen ? 1 : 0, false);
 }
 
-void Light_HL_525_4W::SendHexCmd(u8 cmd, u8 vh, u8 vl) {
-    if (!Connect()) return;
+void Light_HL_525_4W::Refresh() {
+    for (int i = 0; i < FIELD_COUNT; ++i) {
+        if (m_fields[i].desired >= 0) Apply((Field)i, m_fields[i].desired, true);
+    }
+}
+
+void Light_HL_525_4W::QueryStatus() {
+    // 设备无状态回读，核对缓存: 重发未确认 (失败/重连后) 的设置
+    for (int i = 0; i < FIELD_COUNT; ++i) {
+        const FieldState& fs = m_fields[i];
+        if (fs.desired >= 0 && fs.actual != fs.desired) Apply((Field)i, fs.desired, true);
+    }
+    PushStatus();
+}
+
+void Light_HL_525_4W::Apply(Field f, int value, bool force) {
+    FieldState& fs = m_fields[f];
+    fs.desired = value;
+
+    auto now = steady_clock::now();
+    if (!force && fs.actual == value) {
+        bool stale = (m_refreshMs > 0) && (now - fs.sent >= duration_ms(m_refreshMs));
+        if (!stale) return;
+    }
+
+    int prev = fs.actual;
+    if (SendField(f, value)) {
+        fs.actual = value;
+        fs.sent = now;
+        if (prev != value) PushStatus();
+    }
+    else {
+        fs.actual = -1;
+    }
+}
+
+bool Light_HL_525_4W::SendField(Field f, int value) {
+    switch (f) {
+    case FIELD_SWITCH:
+        // 0x1F:开, 0x2F:关
+        return SendHexCmd(value ? 0x1F : 0x2F, 0x00, 0x00);
+
+    case FIELD_LEVEL: {
+        // 0x9F: 调节电流
+        u16 current = (u16)value * 255 / 100;
+        return SendHexCmd(0x9F, (current >> 8) & 0xFF, current & 0xFF);
+    }
+
+    case FIELD_STROBE:
+        // 0x3F: 开闪烁, 0x4F: 关闪烁
+        return SendHexCmd(value ? 0x3F : 0x4F, 0x00, 0x00);
+
+    default:
+        return false;
+    }
+}
+
+void Light_HL_525_4W::PushStatus() {
+    // 未知的字段按最近一次设置上报
+    auto value = [this](Field f) {
+        const FieldState& fs = m_fields[f];
+        int v = (fs.actual >= 0) ? fs.actual : fs.desired;
+        return (u8)((v >= 0) ? v : 0);
+    };
+
+    rpc::LightStatus status;
+    status.isOpen = value(FIELD_SWITCH);
+    status.brightness = value(FIELD_LEVEL);
+    status.strobeFreq = value(FIELD_STROBE);
+    status.temperature = 0.0f;
+
+    auto pkt = std::make_shared<rpc::OwLightStatus>(status);
+    if (m_statusCb) m_statusCb(pkt);
+}
+
+bool Light_HL_525_4W::SendHexCmd(u8 cmd, u8 vh, u8 vl) {
+    if (!Connect()) return false;
 
     u8 buf[7];
     buf[0] = 0xFF; // Header
-    buf[1] = 0x01; // HL-525 ̶ַ 0x01 (̨ͬĶַ̬)
+    buf[1] = 0x01; // HL-525 固定地址 0x01 (不同于云台的动态地址)
     buf[2] = 0x00;
     buf[3] = cmd;
     buf[4] = vh;
     buf[5] = vl;
 
     // Checksum
-    u32 sum = 0;
-    for (int i = 1; i <= 5; i++) sum += buf[i];
-    buf[6] = (u8)(sum & 0xFF);
+    buf[6] = checksum::Sum8(buf + 1, 5);
 
     try {
         m_socket->write(buf, 7);
+        return true;
     }
     catch (std::exception& e) {
         LOG_ERROR("[Slot %d] Send failed: %s", m_slotID, e.what());
         SetState(STATE_ERROR, 101);
         m_socket->close();
+        return false;
     }
 }
 
 bool Light_HL_525_4W::Connect() {
     if (IsOnline() && m_socket && m_socket->isOpen()) return true;
 
+    // 出错状态需先回到离线才能重连
+    if (GetState() == STATE_ERROR) SetState(STATE_OFFLINE);
+
     try {
         SetState(STATE_CONNECTING);
         m_socket = std::make_shared<TcpSocket>(m_ip, m_port);
         m_socket->setConnTimeout(500);
         m_socket->open();
+
+        // 断线期间灯的状态未知，已有设置在下次写入/查询时重发
+        for (int i = 0; i < FIELD_COUNT; ++i) m_fields[i].actual = -1;
+
         SetState(STATE_ONLINE);
         return true;
     }
@@ -2,6 +2,7 @@
 #include "../ILight_Device.h"
 #include "net/TCPSocket.h"
 #include "debug/Logger.h"
+#include "time/sal_chrono.h"
 
 ECCS_BEGIN
 
@@ -10,32 +11,52 @@ class Light_HL_525_4W : public ILight_Device
 public:
 
     using Self = Light_HL_525_4W;
-    // עID
+    // 注册ID
     static const u32 ID = MAKE_DEV_OID(did::DEVICE_LIGHT, did::LIGHT_HL_525_4W);
-    // עṤ
+    // 注册工厂宏
     FACTORY_ID_CHILD_WITH_SPEC_NAME(u32, ID, DeviceBase, Self, "HL-525")
 
     Light_HL_525_4W();
     virtual ~Light_HL_525_4W();
 
-    // ǳʼ
+    // 覆盖初始化
     virtual bool Init(int slotID, const std::map<str, str>& config) override;
+    virtual void OnRegisterProperties() override;
 
 public:
-    // --- ʵ ILight_Device Ĵӿ ---
+    // --- 实现 ILight_Device 的纯虚接口 ---
     virtual void SetSwitch(bool isOpen) override;
     virtual void SetBrightness(u8 level) override;
     virtual void SetStrobe(bool isOpen) override;
+    virtual void Refresh() override;
+    virtual void QueryStatus() override;
 
 private:
-    // ˽и
-    void SendHexCmd(u8 cmd, u8 vh, u8 vl);
+    // 状态缓存: desired 为最近一次设置，actual 为最近一次成功下发的值
+    enum Field { FIELD_SWITCH, FIELD_LEVEL, FIELD_STROBE, FIELD_COUNT };
+    struct FieldState {
+        int desired;    // -1 = 未设置
+        int actual;     // -1 = 未知 (未下发/下发失败/重连后)
+        steady_clock::time_point sent;
+    };
+
+    // 设置字段，与 actual 相同时不下发 (force 或超过刷新周期除外)
+    void Apply(Field f, int value, bool force);
+    bool SendField(Field f, int value);
+    void PushStatus();
+
+    // 私有辅助方法
+    bool SendHexCmd(u8 cmd, u8 vh, u8 vl);
     bool Connect();
 
 private:
     str m_ip;
     int m_port;
     TcpSocket_Ptr m_socket;
+
+    // 只在设备线程中访问
+    FieldState m_fields[FIELD_COUNT];
+    u32 m_refreshMs;        // 相同设置的最短重发周期 (0 = 始终抑制)
 };
 
 ECCS_END
\ No newline at end of file
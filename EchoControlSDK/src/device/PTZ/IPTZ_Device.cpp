@@ -0,0 +1,115 @@
+#include "IPTZ_Device.h"
+#include "PtzGeoPointing.h"
+#include <stdlib.h>
+
+ECCS_BEGIN
+
+IPTZ_Device::IPTZ_Device()
+    : m_hasInstall(false)
+{
+    m_tour.Bind(
+        [this](u8 preset) { PtzPreset(2, preset); },  // 2 = Goto
+        [this](Event* e) { postEvent(e); });
+}
+
+IPTZ_Device::~IPTZ_Device()
+{
+    // 正常流程已在 Stop 中注销，此处兜底
+    PtzGeoRegistry::Instance().Unregister(this);
+}
+
+void IPTZ_Device::OnRegisterProperties()
+{
+    RegisterProp<str>("Tour", "", "Preset Tour, e.g. 1:10,2:10 (Preset:Dwell Seconds)");
+    RegisterProp<bool>("TourAutoStart", false, "Start Tour When Device Starts");
+    RegisterProp<int>("TourResume", 30, "Resume Tour After Manual Idle (s, 0=Stop Tour)");
+
+    // 安装信息 (地理指向)，经纬度为空表示未标定
+    RegisterProp<str>("InstallLat", "", "Install Latitude (deg)");
+    RegisterProp<str>("InstallLon", "", "Install Longitude (deg)");
+    RegisterProp<float>("InstallAlt", 0.0f, "Install Altitude (m)");
+    RegisterProp<float>("InstallHeading", 0.0f, "Bearing Of Pan 0 From North (deg, Clockwise)");
+    RegisterProp<float>("InstallTilt", 0.0f, "Mounting Tilt Offset (deg, Up Positive)");
+    RegisterProp<float>("GeoRange", 0.0f, "Max Geo Pointing Range (m, 0=Unlimited)");
+    RegisterProp<int>("Group", 0, "PTZ Group For Geo Pointing");
+}
+
+bool IPTZ_Device::Init(int slotID, const std::map<str, str>& config)
+{
+    if (!DeviceBase::Init(slotID, config)) return false;
+
+    int resume = GetPropValue<int>("TourResume");
+    m_tour.SetResumeIdle(resume > 0 ? (u32)resume * 1000 : 0);
+
+    str lat = GetProperty("InstallLat");
+    str lon = GetProperty("InstallLon");
+    m_hasInstall = !lat.empty() && !lon.empty();
+    if (m_hasInstall) {
+        m_install.lat = strtod(lat.c_str(), nullptr);
+        m_install.lon = strtod(lon.c_str(), nullptr);
+        m_install.alt = GetPropValue<float>("InstallAlt");
+        m_install.heading = GetPropValue<float>("InstallHeading");
+        m_install.tiltOffset = GetPropValue<float>("InstallTilt");
+        m_install.maxRange = GetPropValue<float>("GeoRange");
+        m_install.group = GetPropValue<int>("Group");
+    }
+    return true;
+}
+
+bool IPTZ_Device::Start()
+{
+    // 在设备线程启动前开始巡航，之后巡航状态只由设备线程访问
+    str autoStart = GetProperty("TourAutoStart");
+    if (autoStart == "true" || autoStart == "1") {
+        TourStart("");
+    }
+
+    if (!DeviceBase::Start()) return false;
+
+    // 设备线程运行期间才参与地理指向
+    if (m_hasInstall) {
+        PtzGeoRegistry::Instance().Register(this, m_install);
+    }
+    return true;
+}
+
+void IPTZ_Device::Stop()
+{
+    // 先注销: 返回后 PointAt 不会再访问本设备 (子类随后开始释放资源)
+    PtzGeoRegistry::Instance().Unregister(this);
+
+    DeviceBase::Stop();
+
+    // 设备线程已退出，可直接停止
+    m_tour.Stop();
+}
+
+bool IPTZ_Device::TourStart(const str& def)
+{
+    str tourDef = def.empty() ? GetProperty("Tour") : def;
+
+    std::vector<PtzTourStep> steps;
+    if (!PtzTour::Parse(tourDef, steps)) {
+        LOG_WARNING("[Slot %d] Invalid tour definition: '%s'", m_slotID, tourDef.c_str());
+        return false;
+    }
+
+    LOG_INFO("[Slot %d] PTZ tour started (%d presets)", m_slotID, (int)steps.size());
+    return m_tour.Start(steps);
+}
+
+void IPTZ_Device::TourStop()
+{
+    if (m_tour.IsActive()) {
+        LOG_INFO("[Slot %d] PTZ tour stopped", m_slotID);
+    }
+    m_tour.Stop();
+}
+
+void IPTZ_Device::OnCustomEvent(Event_Ptr& e)
+{
+    if (m_tour.OnEvent(e)) return;
+    DeviceBase::OnCustomEvent(e);
+}
+
+ECCS_END
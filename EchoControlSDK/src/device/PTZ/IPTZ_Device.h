@@ -1,13 +1,16 @@
 #pragma once
 #include "../DeviceBase.h"
+#include "PtzGeoPointing.h"
+#include "PtzPositionState.h"
+#include "PtzTour.h"
 
 ECCS_BEGIN
 
 class IPTZ_Device : public DeviceBase
 {
 public:
-    // === ӿ ===
-    // action ο PacketDef.h (1=Up, 2=Down...)
+    // === 纯虚接口 ===
+    // action 定义参考 PacketDef.h (1=Up, 2=Down...)
     virtual void PtzMove(u8 action, u8 speed) = 0;
     virtual void PtzStop() = 0;
     virtual void PtzPreset(u8 action, u8 index) {
@@ -18,6 +21,52 @@ public:
         LOG_WARNING("[Slot %d] Device (Model: %s) does not support ZoomIn.",
             m_slotID, GetProperty("Model").c_str());
     }
+    // 连续速度 (正: 右/上，负: 左/下，0 停止该轴)，两轴可同时运动
+    virtual bool PtzSetVelocity(i8 pan, i8 tilt) {
+        LOG_WARNING("[Slot %d] Device (Model: %s) does not support SetVelocity.",
+            m_slotID, GetProperty("Model").c_str());
+        return false;
+    }
+    // 绝对定位结果 (OwPtzGotoDone.result)
+    enum GotoResult {
+        GOTO_REACHED = 0,
+        GOTO_TIMEOUT = 1,
+        GOTO_ABORTED = 2,
+        GOTO_SEND_FAILED = 3
+    };
+    // 绝对定位 (度)，到位/超时/被打断时推送 OwPtzGotoDone
+    virtual bool PtzGotoAngle(float pan, float tilt, float tolerance) {
+        LOG_WARNING("[Slot %d] Device (Model: %s) does not support GotoAngle.",
+            m_slotID, GetProperty("Model").c_str());
+        return false;
+    }
+    // 最新合并位置 (不支持角度回传时返回 nullptr)
+    virtual const PtzPositionState* GetPositionState() const { return nullptr; }
+
+    // =================================================
+    // 预置位巡航 (基于 PtzPreset，需在设备线程中调用)
+    // =================================================
+    // def 为空时使用配置属性 Tour
+    bool TourStart(const str& def);
+    void TourStop();
+    // 手动控制打断巡航 (由 Handler 在移动/停止/预置位前调用)
+    void TourNotifyManual() { m_tour.OnManualControl(); }
+
+protected:
+    IPTZ_Device();
+    virtual ~IPTZ_Device();
+
+    // 子类覆盖时需先调用基类实现
+    virtual bool Init(int slotID, const std::map<str, str>& config) override;
+    virtual bool Start() override;
+    virtual void Stop() override;
+    virtual void OnRegisterProperties() override;
+    virtual void OnCustomEvent(Event_Ptr& e) override;
+
+protected:
+    PtzTour m_tour;
+    PtzInstall m_install;       // 安装信息，运行期间登记到 PtzGeoRegistry
+    bool m_hasInstall;
 };
 
 ECCS_END
\ No newline at end of file
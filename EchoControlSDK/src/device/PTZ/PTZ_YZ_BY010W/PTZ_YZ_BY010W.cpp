@@ -1,57 +1,133 @@
 #include "PTZ_YZ_BY010W.h"
 #include "debug/Exceptions.h"
+#include "utils/checksum.h"
+#include <math.h>
+#include <string.h>
 
 ECCS_BEGIN
 
-PTZ_YZ_BY010W::PTZ_YZ_BY010W() : m_addr(1) {
+// 闭环定位: 误差不小于该角度时全速，以下线性减速
+static const float LOOP_FULL_SPEED_DEG = 20.0f;
+static const u8    LOOP_MIN_SPEED = 0x02;
+static const u8    PELCO_MAX_SPEED = 0x3F;
+static const float DEFAULT_GOTO_TOLERANCE = 0.5f;
+// Pelco-D 水平速度 0x40 为 Turbo，俯仰最大 0x3F
+static const u8    PELCO_PAN_TURBO = 0x40;
+
+// 角度归一化到 [0, 360)
+static float WrapAngle(float a)
+{
+    a = fmodf(a, 360.0f);
+    return a < 0.0f ? a + 360.0f : a;
+}
+
+// 最短路径误差 (-180, 180]
+static float AngleError(float target, float current)
+{
+    float e = WrapAngle(target - current);
+    return e > 180.0f ? e - 360.0f : e;
+}
+
+static u8 LoopSpeed(float err)
+{
+    float a = fabsf(err);
+    if (a >= LOOP_FULL_SPEED_DEG) return PELCO_MAX_SPEED;
+    u8 s = (u8)(a * PELCO_MAX_SPEED / LOOP_FULL_SPEED_DEG);
+    return s < LOOP_MIN_SPEED ? LOOP_MIN_SPEED : s;
+}
+
+PTZ_YZ_BY010W::PTZ_YZ_BY010W()
+    : m_addr(1), m_gotoMode(GOTO_MODE_ABSOLUTE), m_gotoTimeoutMs(20000), m_gotoActive(false),
+      m_velMinIntervalMs(50), m_velKeepaliveMs(1000)
+{
+    memset(&m_goto, 0, sizeof(m_goto));
+    m_vel.pan = m_vel.tilt = 0;
+    m_vel.cmd2 = m_vel.panSpeed = m_vel.tiltSpeed = 0;
+    m_vel.sent = false;
+    m_vel.timer = TimerService::INVALID_TIMER;
+    m_vel.gen = 0;
+    m_parser.SetHandler([this](const u8* frame) {
+        if (frame[1] != m_addr) return; // 不是我的地址
+        ParsePelcoResponse(frame, PelcoFrameParser::FRAME_LEN);
+    });
 }
 
 PTZ_YZ_BY010W::~PTZ_YZ_BY010W() {
+    CancelGotoTimer();
+    CancelVelocityTimer();
     if (m_socket) m_socket->close();
 }
 
+void PTZ_YZ_BY010W::OnRegisterProperties()
+{
+    IPTZ_Device::OnRegisterProperties();
+
+    RegisterProp<int>("PosInterval", 100, "Min Position Report Interval (ms, 0=Unlimited)");
+    RegisterProp<float>("PosDeadband", 0.05f, "Position Report Deadband (deg)");
+    RegisterProp<int>("GotoMode", 0, "GotoAngle Mode (0=Pelco Absolute, 1=Closed Loop)");
+    RegisterProp<int>("GotoTimeout", 20000, "GotoAngle Timeout (ms)");
+    RegisterProp<int>("VelMaxRate", 20, "Max Motion Command Rate (Hz)");
+    RegisterProp<int>("VelKeepalive", 1000, "Resend Motion Command While Moving (ms, 0=Off)");
+}
+
 bool PTZ_YZ_BY010W::Init(int slotID, const std::map<str, str>& config) {
-    // ûʼ ( ID, IP, Port, У Index )
-    if (!DeviceBase::Init(slotID, config)) return false;
+    // 调用基类初始化 (解析 ID, IP, Port, 校验 Index 等)
+    if (!IPTZ_Device::Init(slotID, config)) return false;
 
-    // ȡ
-    m_ip = GetPropValue<str>("IP");   // ʹûĸ
+    // 获取缓存配置
+    m_ip = GetPropValue<str>("IP");   // 使用基类的辅助函数更方便
     m_port = GetPropValue<int>("Port");
 
-    // ȡַ
-    // Ȼ ID  0x30010001ô Index(01) ͨ RS485/Pelco-D ַ
+    int interval = GetPropValue<int>("PosInterval");
+    m_position.Configure(interval > 0 ? (u32)interval : 0, GetPropValue<float>("PosDeadband"));
+
+    m_gotoMode = GetPropValue<int>("GotoMode");
+    int timeout = GetPropValue<int>("GotoTimeout");
+    m_gotoTimeoutMs = timeout > 0 ? (u32)timeout : 20000;
+
+    int rate = GetPropValue<int>("VelMaxRate");
+    m_velMinIntervalMs = rate > 0 ? 1000 / (u32)rate : 0;
+    int keepalive = GetPropValue<int>("VelKeepalive");
+    m_velKeepaliveMs = keepalive > 0 ? (u32)keepalive : 0;
+
+    // 获取物理地址
+    // 既然 ID 是 0x30010001，那么 Index(01) 通常就是 RS485/Pelco-D 的物理地址
     //m_addr = m_deviceID.GetIndex();
 
     return true;
 }
 
 void PTZ_YZ_BY010W::PtzMove(u8 action, u8 speed) {
-    u8 cmd2 = 0x00;
-    u8 d1 = 0x00; // Pan Speed
-    u8 d2 = 0x00; // Tilt Speed
+    i8 v = (i8)(speed > PELCO_PAN_TURBO ? PELCO_PAN_TURBO : speed);
 
-    // action  Packet_Def.h (1=Up, 2=Down, 3=Left, 4=Right)
+    // action 定义在 Packet_Def.h (1=Up, 2=Down, 3=Left, 4=Right)，统一走速度通道
     switch (action) {
-    case 1: cmd2 = 0x08; d2 = speed; break; // Up
-    case 2: cmd2 = 0x10; d2 = speed; break; // Down
-    case 3: cmd2 = 0x04; d1 = speed; break; // Left
-    case 4: cmd2 = 0x02; d1 = speed; break; // Right
+    case 1: PtzSetVelocity(0, v); break;   // Up
+    case 2: PtzSetVelocity(0, -v); break;  // Down
+    case 3: PtzSetVelocity(-v, 0); break;  // Left
+    case 4: PtzSetVelocity(v, 0); break;   // Right
+    default: PtzStop(); break;
     }
-    SendPelcoD(0x00, cmd2, d1, d2);
 }
 
 void PTZ_YZ_BY010W::PtzStop() {
-    SendPelcoD(0x00, 0x00, 0x00, 0x00);
+    // 显式停止总是下发
+    m_vel.sent = false;
+    PtzSetVelocity(0, 0);
 }
 
 void PTZ_YZ_BY010W::PtzPreset(u8 action, u8 index) {
-    // 1=Set, 2=Goto (Э鶨)
+    // 1=Set, 2=Goto (假设协议定义)
+    if (action == 2) {
+        if (m_gotoActive) FinishGoto(GOTO_ABORTED);
+        ResetVelocity();
+    }
     if (action == 2) SendPelcoD(0x00, 0x07, 0x00, index);      // Call
     else if (action == 1) SendPelcoD(0x00, 0x03, 0x00, index); // Set
 }
 
-void PTZ_YZ_BY010W::SendPelcoD(u8 cmd1, u8 cmd2, u8 d1, u8 d2) {
-    if (!Connect()) return;
+bool PTZ_YZ_BY010W::SendPelcoD(u8 cmd1, u8 cmd2, u8 d1, u8 d2) {
+    if (!Connect()) return false;
 
     u8 buf[7];
     buf[0] = 0xFF;
@@ -61,16 +137,17 @@ void PTZ_YZ_BY010W::SendPelcoD(u8 cmd1, u8 cmd2, u8 d1, u8 d2) {
     buf[4] = d1;
     buf[5] = d2;
 
-    u32 sum = buf[1] + buf[2] + buf[3] + buf[4] + buf[5];
-    buf[6] = (u8)(sum % 256);
+    buf[6] = checksum::Sum8(buf + 1, 5);
 
     try {
         m_socket->write(buf, 7);
+        return true;
     }
     catch (std::exception& e) {
         LOG_ERROR("[Slot %d] PTZ Send failed: %s", m_slotID, e.what());
         SetState(STATE_ERROR);
         m_socket->close();
+        return false;
     }
 }
 
@@ -95,16 +172,16 @@ bool PTZ_YZ_BY010W::Start() {
 
     if (!Connect()) {
         LOG_WARNING("[Slot %d] Start: Connect failed, will retry in run loop.", m_slotID);
-        // ע⣺ﷵ true߳Ա߳
+        // 注意：这里返回 true，允许线程启动，以便在线程里重连
     }
 
-    if (!DeviceBase::Start()) return false;
+    if (!IPTZ_Device::Start()) return false;
 
-    // ȡ߳ (෽)
+    // 启动读取线程 (基类方法)
     StartReader();
 
-    // 򿪽Ƕʵʱش
-    // Э: FF Addr 00 09 00 05 CS
+    // 打开角度实时回传
+    // 协议: FF Addr 00 09 00 05 CS
     LOG_INFO("[Slot %d] PTZ: Enable Real-time Angle Report", m_slotID);
     SendPelcoD(0x00, 0x09, 0x00, 0x05);
 
@@ -112,49 +189,47 @@ bool PTZ_YZ_BY010W::Start() {
 }
 
 void PTZ_YZ_BY010W::Stop() {
-    // رսǶʵʱش
-    // Э: FF Addr 00 0B 00 05 CS
+    // 关闭角度实时回传
+    // 协议: FF Addr 00 0B 00 05 CS
     if (IsOnline()) {
         SendPelcoD(0x00, 0x0B, 0x00, 0x05);
     }
 
-    // ֹͣȡ
+    // 停止读取
     StopReader();
+    CancelGotoTimer();
+    m_gotoActive = false;
+    CancelVelocityTimer();
+    m_vel.sent = false;
 
-    DeviceBase::Stop();
+    IPTZ_Device::Stop();
 }
 
 int PTZ_YZ_BY010W::ReadRaw(u8* buf, u32 maxLen) {
-    if (!m_socket || !m_socket->isOpen()) return -1;
+    if (!m_socket || !m_socket->isOpen()) {
+        m_parser.Reset(); // 连接断开，丢弃残留的半帧
+        return -1;
+    }
     try {
         return m_socket->read(buf, maxLen);
     }
+    catch (ETimeout&) {
+        PublishPosition(); // 限速期间缓存的最终位置
+        return 0; // 读超时，保留半帧
+    }
     catch (...) {
+        m_parser.Reset();
         return -1;
     }
 }
 
 void PTZ_YZ_BY010W::OnRawDataReceived(const u8* data, u32 len) {
-    // Pelco-D ذ̶ 7 ֽ
-    // 򵥴ճֻҵĵһ
-    // ʵʹӦ RingBuffer ְʾ
-
-    if (len < 7) return;
-
-    for (u32 i = 0; i <= len - 7; ++i) {
-        if (data[i] == 0xFF) { // ֡ͷ
-            // У Checksum
-            u8 addr = data[i + 1];
-            if (addr != m_addr) continue; // ҵĵַ
-
-            u32 sum = data[i + 1] + data[i + 2] + data[i + 3] + data[i + 4] + data[i + 5];
-            if ((u8)(sum % 256) == data[i + 6]) {
-                // Уͨ
-                ParsePelcoResponse(data + i, 7);
-                i += 6; 
-            }
-        }
-    }
+    // Pelco-D 回包固定 7 字节，可能被拆分到多次读取或多帧粘连
+    // 由 m_parser 保留半帧并逐帧回调 ParsePelcoResponse
+    m_parser.Feed(data, len);
+
+    // 同一次读取中的水平/俯仰回包合并后最多推送一次
+    PublishPosition();
 }
 
 void PTZ_YZ_BY010W::ParsePelcoResponse(const u8* data, u32 len) 
@@ -162,36 +237,259 @@ void PTZ_YZ_BY010W::ParsePelcoResponse(const u8* data, u32 len)
     u8 cmd2 = data[3];
     u16 val = (data[4] << 8) | data[5];
 
-    if (cmd2 == 0x59) 
-    { 
-        // 0-35999 (0.01)
-        float panAngle = val / 100.0f;
+    // 0-35999 (0.01度)
+    if (cmd2 == 0x59) {
+        m_position.Update(PtzPositionState::AXIS_PAN, val / 100.0f);
+    }
+    else if (cmd2 == 0x5B) {
+        m_position.Update(PtzPositionState::AXIS_TILT, val / 100.0f);
+    }
+    else {
+        return;
+    }
+
+    // 定位中: 转交设备线程判断是否到位 (不经过限速推送)
+    if (m_gotoActive.load(std::memory_order_relaxed)) {
+        postEvent(new PtzGotoFeedbackEvent());
+    }
+}
+
+void PTZ_YZ_BY010W::PublishPosition()
+{
+    rpc::PtzPosition pos;
+    if (!m_position.PollPublish(pos)) return;
+
+    // 构造 OW 包推送到上层
+    auto pkt = std::make_shared<rpc::OwPtzPosition>(pos);
+    if (m_statusCb) m_statusCb(pkt);
+}
+
+// =======================================================
+// 连续速度控制
+// =======================================================
+
+bool PTZ_YZ_BY010W::PtzSetVelocity(i8 pan, i8 tilt)
+{
+    if (m_gotoActive) FinishGoto(GOTO_ABORTED);
+
+    m_vel.pan = pan;
+    m_vel.tilt = tilt;
+    FlushVelocity(false);
+    return true;
+}
+
+void PTZ_YZ_BY010W::FlushVelocity(bool timerFired)
+{
+    // 目标速度编码为 Pelco-D 组合方向位: Right=0x02, Left=0x04, Up=0x08, Down=0x10
+    u8 cmd2 = 0x00, panSpeed = 0x00, tiltSpeed = 0x00;
+    if (m_vel.pan != 0) {
+        int s = m_vel.pan > 0 ? m_vel.pan : -m_vel.pan;
+        cmd2 |= (m_vel.pan > 0) ? 0x02 : 0x04;
+        panSpeed = (u8)(s > PELCO_PAN_TURBO ? PELCO_PAN_TURBO : s);
+    }
+    if (m_vel.tilt != 0) {
+        int s = m_vel.tilt > 0 ? m_vel.tilt : -m_vel.tilt;
+        cmd2 |= (m_vel.tilt > 0) ? 0x08 : 0x10;
+        tiltSpeed = (u8)(s > PELCO_MAX_SPEED ? PELCO_MAX_SPEED : s);
+    }
+
+    bool moving = (cmd2 != 0x00);
+    bool same = m_vel.sent && cmd2 == m_vel.cmd2 &&
+        panSpeed == m_vel.panSpeed && tiltSpeed == m_vel.tiltSpeed;
+
+    // 未变化: 仅在保活定时器到期且仍在运动时重发
+    if (same && (!timerFired || !moving)) return;
+
+    // 运动指令限速，多余的中间值合并为最后一次；停止指令立即下发
+    std::chrono::steady_clock::time_point now = std::chrono::steady_clock::now();
+    if (moving && !same && m_vel.sent && m_velMinIntervalMs > 0) {
+        u32 elapsed = (u32)std::chrono::duration_cast<std::chrono::milliseconds>(now - m_vel.lastSend).count();
+        if (elapsed < m_velMinIntervalMs) {
+            ArmVelocityTimer(m_velMinIntervalMs - elapsed);
+            return;
+        }
+    }
+
+    m_vel.sent = SendPelcoD(0x00, cmd2, panSpeed, tiltSpeed);
+    m_vel.cmd2 = cmd2;
+    m_vel.panSpeed = panSpeed;
+    m_vel.tiltSpeed = tiltSpeed;
+    m_vel.lastSend = now;
+
+    if (moving && m_velKeepaliveMs > 0) {
+        ArmVelocityTimer(m_velKeepaliveMs);
+    }
+    else {
+        CancelVelocityTimer();
+    }
+}
+
+void PTZ_YZ_BY010W::ArmVelocityTimer(u32 ms)
+{
+    CancelVelocityTimer();
+
+    u32 gen = m_vel.gen;
+    m_vel.timer = TimerService::instance().schedule(ms, [this, gen]() {
+        postEvent(new PtzVelocityTimerEvent(gen));
+    });
+}
 
-        //  OW ͵ϲ
-        rpc::PtzPosition pos;
-        pos.pan = panAngle;
-        pos.tilt = 0;
-        pos.zoom = 0;
+void PTZ_YZ_BY010W::CancelVelocityTimer()
+{
+    if (m_vel.timer != TimerService::INVALID_TIMER) {
+        TimerService::instance().cancel(m_vel.timer);
+        m_vel.timer = TimerService::INVALID_TIMER;
+    }
+    ++m_vel.gen;
+}
 
-        //  Packet
-        auto pkt = std::make_shared<rpc::OwPtzPosition>(pos);
-        // ûص
-        if (m_statusCb) m_statusCb(pkt);
+void PTZ_YZ_BY010W::ResetVelocity()
+{
+    // 云台将执行其他动作 (预置位/定位)，停止保活并使已下发帧失效
+    CancelVelocityTimer();
+    m_vel.pan = m_vel.tilt = 0;
+    m_vel.sent = false;
+}
 
-        // LOG_DEBUG("[PTZ] Pan Angle: %.2f", panAngle);
-    } else if (cmd2 == 0x5B) 
-    {
-        float tiltAngle = val / 100.0f;
-        rpc::PtzPosition pos;
-        pos.pan = 0;
-        pos.tilt = tiltAngle;
-        pos.zoom = 0;
+// =======================================================
+// 绝对定位
+// =======================================================
 
-        auto pkt = std::make_shared<rpc::OwPtzPosition>(pos);
-        if (m_statusCb) m_statusCb(pkt);
+bool PTZ_YZ_BY010W::PtzGotoAngle(float pan, float tilt, float tolerance)
+{
+    if (m_gotoActive) FinishGoto(GOTO_ABORTED);
+    ResetVelocity();
+
+    m_goto.pan = WrapAngle(pan);
+    m_goto.tilt = WrapAngle(tilt);
+    m_goto.tolerance = tolerance > 0.0f ? tolerance : DEFAULT_GOTO_TOLERANCE;
+    m_goto.cmd2 = m_goto.panSpeed = m_goto.tiltSpeed = 0;
+
+    if (m_gotoMode == GOTO_MODE_ABSOLUTE) {
+        // 协议: FF Addr 00 4B PanH PanL CS / FF Addr 00 4D TiltH TiltL CS (0.01度)
+        u16 panVal = (u16)(m_goto.pan * 100.0f + 0.5f) % 36000;
+        u16 tiltVal = (u16)(m_goto.tilt * 100.0f + 0.5f) % 36000;
+        if (!SendPelcoD(0x00, 0x4B, panVal >> 8, panVal & 0xFF) ||
+            !SendPelcoD(0x00, 0x4D, tiltVal >> 8, tiltVal & 0xFF)) {
+            m_gotoActive = true;
+            FinishGoto(GOTO_SEND_FAILED);
+            return false;
+        }
+    }
+
+    // 超时定时器到期后投递到设备线程，代数不符的事件直接丢弃
+    u32 gen = ++m_goto.gen;
+    m_goto.timer = TimerService::instance().schedule(m_gotoTimeoutMs, [this, gen]() {
+        postEvent(new PtzGotoTimeoutEvent(gen));
+    });
+
+    m_gotoActive = true;
+    CheckGoto();
+    return true;
+}
+
+void PTZ_YZ_BY010W::CheckGoto()
+{
+    rpc::PtzPosition pos;
+    u32 valid = m_position.Load(pos);
+    if ((valid & (PtzPositionState::AXIS_PAN | PtzPositionState::AXIS_TILT)) !=
+        (PtzPositionState::AXIS_PAN | PtzPositionState::AXIS_TILT)) {
+        return; // 等待两轴角度回报
+    }
+
+    float panErr = AngleError(m_goto.pan, pos.pan);
+    float tiltErr = AngleError(m_goto.tilt, pos.tilt);
+    if (fabsf(panErr) <= m_goto.tolerance && fabsf(tiltErr) <= m_goto.tolerance) {
+        FinishGoto(GOTO_REACHED);
+        return;
+    }
+
+    if (m_gotoMode == GOTO_MODE_CLOSED_LOOP) {
+        DriveGoto(panErr, tiltErr);
+    }
+}
 
-        // LOG_DEBUG("[PTZ] Tilt Angle: %.2f", tiltAngle);
+void PTZ_YZ_BY010W::DriveGoto(float panErr, float tiltErr)
+{
+    // 水平角增大为右转，俯仰角增大为上仰；到位的轴单独停止
+    u8 cmd2 = 0x00, panSpeed = 0x00, tiltSpeed = 0x00;
+    if (fabsf(panErr) > m_goto.tolerance) {
+        cmd2 |= (panErr > 0.0f) ? 0x02 : 0x04;
+        panSpeed = LoopSpeed(panErr);
+    }
+    if (fabsf(tiltErr) > m_goto.tolerance) {
+        cmd2 |= (tiltErr > 0.0f) ? 0x08 : 0x10;
+        tiltSpeed = LoopSpeed(tiltErr);
+    }
+
+    // 指令不变时不重复下发
+    if (cmd2 == m_goto.cmd2 && panSpeed == m_goto.panSpeed && tiltSpeed == m_goto.tiltSpeed) return;
+
+    if (!SendPelcoD(0x00, cmd2, panSpeed, tiltSpeed)) {
+        FinishGoto(GOTO_SEND_FAILED);
+        return;
+    }
+    m_goto.cmd2 = cmd2;
+    m_goto.panSpeed = panSpeed;
+    m_goto.tiltSpeed = tiltSpeed;
+}
+
+void PTZ_YZ_BY010W::FinishGoto(u8 result)
+{
+    if (!m_gotoActive) return;
+    m_gotoActive = false;
+    CancelGotoTimer();
+    ++m_goto.gen;
+
+    if (m_gotoMode == GOTO_MODE_CLOSED_LOOP && m_goto.cmd2 != 0x00) {
+        SendPelcoD(0x00, 0x00, 0x00, 0x00);
+    }
+
+    rpc::PtzPosition pos;
+    m_position.Load(pos);
+
+    rpc::PtzGotoResult done;
+    done.pan = pos.pan;
+    done.tilt = pos.tilt;
+    done.result = result;
+
+    LOG_BIN_DEBUG("[Slot %d] PTZ goto (%.2f, %.2f) finished: %d", m_slotID, m_goto.pan, m_goto.tilt, (int)result);
+
+    auto pkt = std::make_shared<rpc::OwPtzGotoDone>(done);
+    if (m_statusCb) m_statusCb(pkt);
+}
+
+void PTZ_YZ_BY010W::CancelGotoTimer()
+{
+    if (m_goto.timer != TimerService::INVALID_TIMER) {
+        TimerService::instance().cancel(m_goto.timer);
+        m_goto.timer = TimerService::INVALID_TIMER;
+    }
+}
+
+void PTZ_YZ_BY010W::OnCustomEvent(Event_Ptr& e)
+{
+    if (e->eId() == DeviceEventID::PtzGotoFeedback) {
+        if (m_gotoActive) CheckGoto();
+        return;
+    }
+    if (e->eId() == DeviceEventID::PtzVelocityTimer) {
+        auto te = std::dynamic_pointer_cast<PtzVelocityTimerEvent>(e);
+        if (te && te->Dat == m_vel.gen) {
+            m_vel.timer = TimerService::INVALID_TIMER;
+            FlushVelocity(true);
+        }
+        return;
+    }
+    if (e->eId() == DeviceEventID::PtzGotoTimeout) {
+        auto te = std::dynamic_pointer_cast<PtzGotoTimeoutEvent>(e);
+        if (te && te->Dat == m_goto.gen) {
+            m_goto.timer = TimerService::INVALID_TIMER; // 已触发，无需取消
+            FinishGoto(GOTO_TIMEOUT);
+        }
+        return;
     }
+    IPTZ_Device::OnCustomEvent(e);
 }
 
 ECCS_END
\ No newline at end of file
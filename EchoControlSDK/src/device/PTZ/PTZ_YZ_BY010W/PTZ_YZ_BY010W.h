@@ -1,7 +1,10 @@
 #pragma once
 #include "../IPTZ_Device.h"
 #include "net/TCPSocket.h"
+#include "protocol/PelcoFrameParser.h"
 #include "debug/Logger.h"
+#include "thread/timer_service.h"
+#include <atomic>
 
 ECCS_BEGIN
 
@@ -9,11 +12,11 @@ class PTZ_YZ_BY010W : public IPTZ_Device
 {
 public:
 
-    using Self = PTZ_YZ_BY010W; // ʹñ
-    // 徲̬ ID 
+    using Self = PTZ_YZ_BY010W; // 使用别名，避免编译出错
+    // 定义静态 ID 常量
     static const u32 ID = MAKE_DEV_OID(did::DEVICE_PTZ, did::PTZ_YZ_BY010W);
 
-    // ʹ 5 ꣬Key Ϊ u32
+    // 使用 5 参数宏，Key 类型为 u32
     FACTORY_ID_CHILD_WITH_SPEC_NAME(u32, ID, DeviceBase, Self, "YZ-BY010W")
 
     PTZ_YZ_BY010W();
@@ -25,31 +28,84 @@ public:
     virtual void PtzMove(u8 action, u8 speed) override;
     virtual void PtzStop() override;
     virtual void PtzPreset(u8 action, u8 index) override;
+    virtual bool PtzGotoAngle(float pan, float tilt, float tolerance) override;
+    virtual bool PtzSetVelocity(i8 pan, i8 tilt) override;
+    virtual const PtzPositionState* GetPositionState() const override { return &m_position; }
 
 private:
-    void SendPelcoD(u8 cmd1, u8 cmd2, u8 d1, u8 d2);
+    bool SendPelcoD(u8 cmd1, u8 cmd2, u8 d1, u8 d2);
     bool Connect();
 
 protected:
-    // ʵֻ IO ӿ
+    virtual void OnRegisterProperties() override;
+    virtual void OnCustomEvent(Event_Ptr& e) override;
+
+    // 实现基类的 IO 接口
     virtual int ReadRaw(u8* buf, u32 maxLen) override;
 
-    // ʵЭ
+    // 实现协议解析
     virtual void OnRawDataReceived(const u8* data, u32 len) override;
 
-    //  Start/Stop ȡ߳
+    // 覆盖 Start/Stop 以启动读取线程
     virtual bool Start() override;
     virtual void Stop() override;
 
 private:
-    // ǶȰ
+    // 辅助：解析角度包
     void ParsePelcoResponse(const u8* data, u32 len);
+    // 辅助：按限速/死区推送合并后的位置
+    void PublishPosition();
+
+    // 辅助：绝对定位
+    void CheckGoto();
+    void DriveGoto(float panErr, float tiltErr);
+    void FinishGoto(u8 result);
+    void CancelGotoTimer();
+
+    // 辅助：速度控制
+    void FlushVelocity(bool timerFired);
+    void ArmVelocityTimer(u32 ms);
+    void CancelVelocityTimer();
+    void ResetVelocity();
 
 private:
     str m_ip;
     int m_port;
     u8  m_addr;
     TcpSocket_Ptr m_socket;
+
+    // 回包流式分帧 (仅在读取线程中使用)
+    PelcoFrameParser m_parser;
+    PtzPositionState m_position;
+
+    // 绝对定位 (状态只在设备线程中访问，m_gotoActive 供读取线程判断是否转发角度回报)
+    enum GotoMode {
+        GOTO_MODE_ABSOLUTE = 0,     // Pelco-D 0x4B/0x4D 绝对位置指令
+        GOTO_MODE_CLOSED_LOOP = 1   // 驱动侧按角度回报调速
+    };
+    struct GotoState {
+        float pan, tilt, tolerance;
+        u32   gen;
+        TimerService::TimerId timer;
+        u8    cmd2, panSpeed, tiltSpeed;  // 闭环: 上次下发的运动指令
+    };
+    int       m_gotoMode;
+    u32       m_gotoTimeoutMs;
+    GotoState m_goto;
+    std::atomic<bool> m_gotoActive;
+
+    // 连续速度控制 (设备线程)
+    struct VelocityState {
+        i8    pan, tilt;                    // 目标速度
+        u8    cmd2, panSpeed, tiltSpeed;    // 上次下发的帧
+        bool  sent;                         // 上次下发的帧仍代表云台当前动作
+        std::chrono::steady_clock::time_point lastSend;
+        TimerService::TimerId timer;
+        u32   gen;
+    };
+    u32 m_velMinIntervalMs;
+    u32 m_velKeepaliveMs;
+    VelocityState m_vel;
 };
 
 ECCS_END
\ No newline at end of file
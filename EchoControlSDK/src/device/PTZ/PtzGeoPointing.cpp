@@ -0,0 +1,172 @@
+#include "PtzGeoPointing.h"
+#include "IPTZ_Device.h"
+#include "utils/utils.h"
+#include <math.h>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#  include <emmintrin.h>
+#  define ECCS_GEO_SSE2 1
+#endif
+
+ECCS_BEGIN
+
+// WGS84 椭球
+static const double WGS84_A = 6378137.0;
+static const double WGS84_E2 = 6.69437999014e-3;
+
+static void GeodeticToEcef(double lat, double lon, double alt, double& x, double& y, double& z)
+{
+    double sLat = sin(deg2rad(lat)), cLat = cos(deg2rad(lat));
+    double sLon = sin(deg2rad(lon)), cLon = cos(deg2rad(lon));
+    double n = WGS84_A / sqrt(1.0 - WGS84_E2 * sLat * sLat);
+    x = (n + alt) * cLat * cLon;
+    y = (n + alt) * cLat * sLon;
+    z = (n * (1.0 - WGS84_E2) + alt) * sLat;
+}
+
+static float WrapDeg(double a)
+{
+    a = fmod(a, 360.0);
+    return (float)(a < 0.0 ? a + 360.0 : a);
+}
+
+
+void PtzGeoRegistry::Register(IPTZ_Device* dev, const PtzInstall& install)
+{
+    Unregister(dev);
+
+    double x, y, z;
+    GeodeticToEcef(install.lat, install.lon, install.alt, x, y, z);
+
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_devs.push_back(dev);
+    m_x.push_back(x);
+    m_y.push_back(y);
+    m_z.push_back(z);
+    m_sinLat.push_back(sin(deg2rad(install.lat)));
+    m_cosLat.push_back(cos(deg2rad(install.lat)));
+    m_sinLon.push_back(sin(deg2rad(install.lon)));
+    m_cosLon.push_back(cos(deg2rad(install.lon)));
+    m_heading.push_back(install.heading);
+    m_tiltOffset.push_back(install.tiltOffset);
+    m_maxRange.push_back(install.maxRange);
+    m_group.push_back(install.group);
+}
+
+void PtzGeoRegistry::Unregister(IPTZ_Device* dev)
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    for (size_t i = 0; i < m_devs.size(); ++i) {
+        if (m_devs[i] != dev) continue;
+
+        // 与末尾交换后删除
+        size_t last = m_devs.size() - 1;
+        m_devs[i] = m_devs[last];             m_devs.pop_back();
+        m_x[i] = m_x[last];                   m_x.pop_back();
+        m_y[i] = m_y[last];                   m_y.pop_back();
+        m_z[i] = m_z[last];                   m_z.pop_back();
+        m_sinLat[i] = m_sinLat[last];         m_sinLat.pop_back();
+        m_cosLat[i] = m_cosLat[last];         m_cosLat.pop_back();
+        m_sinLon[i] = m_sinLon[last];         m_sinLon.pop_back();
+        m_cosLon[i] = m_cosLon[last];         m_cosLon.pop_back();
+        m_heading[i] = m_heading[last];       m_heading.pop_back();
+        m_tiltOffset[i] = m_tiltOffset[last]; m_tiltOffset.pop_back();
+        m_maxRange[i] = m_maxRange[last];     m_maxRange.pop_back();
+        m_group[i] = m_group[last];           m_group.pop_back();
+        return;
+    }
+}
+
+void PtzGeoRegistry::SolveLocked(double lat, double lon, double alt)
+{
+    const size_t count = m_devs.size();
+    m_pan.resize(count);
+    m_tilt.resize(count);
+    m_range.resize(count);
+
+    double tx, ty, tz;
+    GeodeticToEcef(lat, lon, alt, tx, ty, tz);
+
+    // 1. ECEF 差值旋转到各云台的 ENU (东/北/天) 坐标
+    //    e = -sinLon*dx + cosLon*dy
+    //    n = -sinLat*cosLon*dx - sinLat*sinLon*dy + cosLat*dz
+    //    u =  cosLat*cosLon*dx + cosLat*sinLon*dy + sinLat*dz
+    size_t i = 0;
+#if defined(ECCS_GEO_SSE2)
+    const __m128d vtx = _mm_set1_pd(tx), vty = _mm_set1_pd(ty), vtz = _mm_set1_pd(tz);
+    for (; i + 2 <= count; i += 2) {
+        __m128d dx = _mm_sub_pd(vtx, _mm_loadu_pd(&m_x[i]));
+        __m128d dy = _mm_sub_pd(vty, _mm_loadu_pd(&m_y[i]));
+        __m128d dz = _mm_sub_pd(vtz, _mm_loadu_pd(&m_z[i]));
+        __m128d sLat = _mm_loadu_pd(&m_sinLat[i]), cLat = _mm_loadu_pd(&m_cosLat[i]);
+        __m128d sLon = _mm_loadu_pd(&m_sinLon[i]), cLon = _mm_loadu_pd(&m_cosLon[i]);
+
+        __m128d e = _mm_sub_pd(_mm_mul_pd(cLon, dy), _mm_mul_pd(sLon, dx));
+        __m128d h = _mm_add_pd(_mm_mul_pd(cLon, dx), _mm_mul_pd(sLon, dy)); // 水平面内沿经线方向的分量
+        __m128d n = _mm_sub_pd(_mm_mul_pd(cLat, dz), _mm_mul_pd(sLat, h));
+        __m128d u = _mm_add_pd(_mm_mul_pd(cLat, h), _mm_mul_pd(sLat, dz));
+
+        double es[2], ns[2], us[2];
+        _mm_storeu_pd(es, e);
+        _mm_storeu_pd(ns, n);
+        _mm_storeu_pd(us, u);
+        for (int k = 0; k < 2; ++k) {
+            double horiz = sqrt(es[k] * es[k] + ns[k] * ns[k]);
+            m_pan[i + k] = (float)(atan2(es[k], ns[k]) * 180.0 / M_PI);
+            m_tilt[i + k] = (float)(atan2(us[k], horiz) * 180.0 / M_PI);
+            m_range[i + k] = (float)sqrt(horiz * horiz + us[k] * us[k]);
+        }
+    }
+#endif
+    for (; i < count; ++i) {
+        double dx = tx - m_x[i], dy = ty - m_y[i], dz = tz - m_z[i];
+        double h = m_cosLon[i] * dx + m_sinLon[i] * dy;
+        double e = m_cosLon[i] * dy - m_sinLon[i] * dx;
+        double n = m_cosLat[i] * dz - m_sinLat[i] * h;
+        double u = m_cosLat[i] * h + m_sinLat[i] * dz;
+        double horiz = sqrt(e * e + n * n);
+        m_pan[i] = (float)(atan2(e, n) * 180.0 / M_PI);
+        m_tilt[i] = (float)(atan2(u, horiz) * 180.0 / M_PI);
+        m_range[i] = (float)sqrt(horiz * horiz + u * u);
+    }
+
+    // 2. 方位/仰角 -> 云台坐标 (扣除安装朝向与俯仰偏移)
+    for (i = 0; i < count; ++i) {
+        m_pan[i] = WrapDeg((double)m_pan[i] - m_heading[i]);
+        m_tilt[i] = WrapDeg((double)m_tilt[i] - m_tiltOffset[i]);
+        if (m_maxRange[i] > 0.0f && m_range[i] > m_maxRange[i]) {
+            m_range[i] = -m_range[i];
+        }
+    }
+}
+
+void PtzGeoRegistry::Solve(double lat, double lon, double alt,
+    std::vector<float>& pan, std::vector<float>& tilt, std::vector<float>& range)
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    SolveLocked(lat, lon, alt);
+    pan = m_pan;
+    tilt = m_tilt;
+    range = m_range;
+}
+
+int PtzGeoRegistry::PointAt(int group, double lat, double lon, double alt)
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    SolveLocked(lat, lon, alt);
+
+    // 统一下发: 每台只投递一个定位包，不等待执行
+    int sent = 0;
+    for (size_t i = 0; i < m_devs.size(); ++i) {
+        if (group >= 0 && m_group[i] != group) continue;
+        if (m_range[i] < 0.0f) continue;
+
+        rpc::PtzGoto data = { m_pan[i], m_tilt[i], 0.0f };
+        m_devs[i]->ExecutePacket(std::make_shared<rpc::RqPtzGoto>(data));
+        ++sent;
+    }
+    return sent;
+}
+
+
+ECCS_END
@@ -0,0 +1,71 @@
+#pragma once
+#include "../../global.h"
+#include <mutex>
+#include <vector>
+
+ECCS_BEGIN
+
+class IPTZ_Device;
+
+//------------------------------------------------------
+// PtzGeoRegistry: 云台安装位置登记与批量指向解算
+// * 各云台 Start 时按安装属性 (经纬高/朝向/俯仰偏移) 登记、Stop 时注销，预先计算 ECEF 坐标与 ENU 旋转
+// * PointAt 对一个世界坐标一次解算所有登记云台的水平/俯仰角 (SoA 布局，SSE2 两路并行)，
+//   再统一下发绝对定位指令
+//------------------------------------------------------
+
+struct PtzInstall {
+    double lat, lon;        // 安装位置 (度)
+    double alt;             // 海拔 (米)
+    float  heading;         // 水平 0 度方向相对正北的角度 (顺时针，度)
+    float  tiltOffset;      // 安装俯仰偏移 (度，上仰为正)
+    float  maxRange;        // 作用距离 (米，0 = 不限)
+    int    group;           // 分组号
+};
+
+class PtzGeoRegistry
+{
+    NON_COPYABLE(PtzGeoRegistry);
+
+public:
+    static PtzGeoRegistry& Instance() {
+        static PtzGeoRegistry instance;
+        return instance;
+    }
+
+    void Register(IPTZ_Device* dev, const PtzInstall& install);
+    void Unregister(IPTZ_Device* dev);
+
+    /**
+     * @brief PointAt 指向世界坐标
+     * @param group：分组号 (<0 表示全部)
+     * @param lat/lon/alt：目标位置 (度/度/米)
+     * @return 下发指令的云台数量
+     */
+    int PointAt(int group, double lat, double lon, double alt);
+
+    // 仅解算不下发 (输出与登记顺序一致，超出作用距离的 range 为负)
+    void Solve(double lat, double lon, double alt,
+        std::vector<float>& pan, std::vector<float>& tilt, std::vector<float>& range);
+
+private:
+    PtzGeoRegistry() {}
+
+    void SolveLocked(double lat, double lon, double alt);
+
+private:
+    std::mutex m_mutex;
+
+    // SoA: 每个数组下标对应一个云台
+    std::vector<IPTZ_Device*> m_devs;
+    std::vector<double> m_x, m_y, m_z;              // ECEF (米)
+    std::vector<double> m_sinLat, m_cosLat, m_sinLon, m_cosLon;
+    std::vector<float>  m_heading, m_tiltOffset, m_maxRange;
+    std::vector<int>    m_group;
+
+    // 解算结果
+    std::vector<float>  m_pan, m_tilt, m_range;
+};
+
+
+ECCS_END
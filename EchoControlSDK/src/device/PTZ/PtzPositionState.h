@@ -0,0 +1,151 @@
+#pragma once
+#include "../../global.h"
+#include "protocol/Packet_Def.h"
+#include <atomic>
+#include <chrono>
+#include <math.h>
+
+ECCS_BEGIN
+
+//------------------------------------------------------
+// PtzPositionState: 云台合并位置状态
+// * 水平/俯仰/变倍分别回报，在此合并为一份完整位置
+// * 写入方只有读取线程；任意线程可通过 Load 无锁读取 (seqlock)
+// * PollPublish 决定是否推送: 水平/俯仰都已回报，距上次推送不少于最小间隔，且变化超过死区
+//------------------------------------------------------
+
+class PtzPositionState
+{
+public:
+    enum Axis {
+        AXIS_PAN  = 0x01,
+        AXIS_TILT = 0x02,
+        AXIS_ZOOM = 0x04
+    };
+
+    PtzPositionState()
+        : m_seq(0), m_pan(0.0f), m_tilt(0.0f), m_zoom(0.0f), m_valid(0),
+          m_minIntervalMs(100), m_deadband(0.05f), m_dirty(false), m_everPublished(false)
+    {
+        m_local.pan = m_local.tilt = m_local.zoom = 0.0f;
+        m_published = m_local;
+    }
+
+    /**
+     * @brief Configure 推送策略
+     * @param minIntervalMs：两次推送的最小间隔 (0 = 不限速)
+     * @param deadband：任一轴变化超过该值 (度) 才推送
+     */
+    void Configure(u32 minIntervalMs, float deadband)
+    {
+        m_minIntervalMs = minIntervalMs;
+        m_deadband = deadband < 0.0f ? 0.0f : deadband;
+    }
+
+    // ------------------------------------------------
+    // 写入方 (读取线程)
+    // ------------------------------------------------
+
+    void Update(Axis axis, float value)
+    {
+        switch (axis) {
+        case AXIS_PAN:  m_local.pan = value; break;
+        case AXIS_TILT: m_local.tilt = value; break;
+        case AXIS_ZOOM: m_local.zoom = value; break;
+        }
+        m_dirty = true;
+
+        // seqlock 写: 奇数表示写入中
+        u32 seq = m_seq.load(std::memory_order_relaxed);
+        m_seq.store(seq + 1, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_release);
+        m_pan.store(m_local.pan, std::memory_order_relaxed);
+        m_tilt.store(m_local.tilt, std::memory_order_relaxed);
+        m_zoom.store(m_local.zoom, std::memory_order_relaxed);
+        m_valid.store(m_valid.load(std::memory_order_relaxed) | axis, std::memory_order_relaxed);
+        m_seq.store(seq + 2, std::memory_order_release);
+    }
+
+    /**
+     * @brief PollPublish 判断当前位置是否需要推送
+     * @param pos：需要推送时输出合并后的位置
+     * @return true 表示需要推送
+     */
+    bool PollPublish(rpc::PtzPosition& pos)
+    {
+        if (!m_dirty) return false;
+
+        // 水平/俯仰都回报过才推送，否则未回报的轴会以 0 度发出
+        const u32 both = AXIS_PAN | AXIS_TILT;
+        if ((m_valid.load(std::memory_order_relaxed) & both) != both) return false;
+
+        std::chrono::steady_clock::time_point now = std::chrono::steady_clock::now();
+        if (m_everPublished && m_minIntervalMs > 0 &&
+            now - m_lastPublish < std::chrono::milliseconds(m_minIntervalMs)) {
+            return false; // 限速，保留 dirty 等待下次
+        }
+
+        if (m_everPublished &&
+            AngleDiff(m_local.pan, m_published.pan) <= m_deadband &&
+            AngleDiff(m_local.tilt, m_published.tilt) <= m_deadband &&
+            fabsf(m_local.zoom - m_published.zoom) <= m_deadband) {
+            m_dirty = false; // 死区内的抖动
+            return false;
+        }
+
+        m_published = m_local;
+        m_lastPublish = now;
+        m_everPublished = true;
+        m_dirty = false;
+        pos = m_local;
+        return true;
+    }
+
+    // ------------------------------------------------
+    // 读取方 (任意线程，无锁)
+    // ------------------------------------------------
+
+    // 返回已收到回报的轴 (Axis 位掩码)，0 表示尚无数据
+    u32 Load(rpc::PtzPosition& pos) const
+    {
+        u32 s1, s2, valid;
+        do {
+            s1 = m_seq.load(std::memory_order_acquire);
+            pos.pan = m_pan.load(std::memory_order_relaxed);
+            pos.tilt = m_tilt.load(std::memory_order_relaxed);
+            pos.zoom = m_zoom.load(std::memory_order_relaxed);
+            valid = m_valid.load(std::memory_order_relaxed);
+            std::atomic_thread_fence(std::memory_order_acquire);
+            s2 = m_seq.load(std::memory_order_relaxed);
+        } while ((s1 & 1) || s1 != s2);
+        return valid;
+    }
+
+private:
+    // 角度差 (水平角 0/360 度处回绕)
+    static float AngleDiff(float a, float b)
+    {
+        float d = fabsf(a - b);
+        return d > 180.0f ? 360.0f - d : d;
+    }
+
+private:
+    // 共享状态 (seqlock 保护)
+    std::atomic<u32>   m_seq;
+    std::atomic<float> m_pan;
+    std::atomic<float> m_tilt;
+    std::atomic<float> m_zoom;
+    std::atomic<u32>   m_valid;
+
+    // 写入方私有
+    u32   m_minIntervalMs;
+    float m_deadband;
+    rpc::PtzPosition m_local;
+    rpc::PtzPosition m_published;
+    std::chrono::steady_clock::time_point m_lastPublish;
+    bool  m_dirty;
+    bool  m_everPublished;
+};
+
+
+ECCS_END
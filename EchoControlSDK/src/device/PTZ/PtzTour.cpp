@@ -0,0 +1,140 @@
+#include "PtzTour.h"
+#include "debug/Logger.h"
+#include <stdlib.h>
+
+ECCS_BEGIN
+
+static const u32 DEFAULT_DWELL_MS = 10000;
+static const u32 MIN_DWELL_MS = 1000;
+
+
+PtzTour::PtzTour()
+    : m_index(0), m_mode(MODE_IDLE), m_resumeIdleMs(30000),
+      m_timer(TimerService::INVALID_TIMER), m_gen(0)
+{
+}
+
+PtzTour::~PtzTour()
+{
+    Disarm();
+}
+
+void PtzTour::Bind(GotoFunc gotoPreset, PostFunc post)
+{
+    m_goto = gotoPreset;
+    m_post = post;
+}
+
+bool PtzTour::Parse(const str& def, std::vector<PtzTourStep>& steps)
+{
+    steps.clear();
+    const char* p = def.c_str();
+    while (*p) {
+        while (*p == ' ' || *p == ',') ++p;
+        if (!*p) break;
+
+        char* end = nullptr;
+        long preset = strtol(p, &end, 10);
+        if (end == p || preset < 1 || preset > 255) return false;
+        p = end;
+
+        double dwell = DEFAULT_DWELL_MS / 1000.0;
+        if (*p == ':') {
+            ++p;
+            dwell = strtod(p, &end);
+            if (end == p) return false;
+            p = end;
+        }
+        while (*p == ' ') ++p;
+        if (*p && *p != ',') return false;
+
+        PtzTourStep step;
+        step.preset = (u8)preset;
+        step.dwellMs = (u32)(dwell * 1000.0);
+        if (step.dwellMs < MIN_DWELL_MS) step.dwellMs = MIN_DWELL_MS;
+        steps.push_back(step);
+    }
+    return !steps.empty();
+}
+
+bool PtzTour::Start(const std::vector<PtzTourStep>& steps)
+{
+    if (steps.empty() || !m_goto || !m_post) return false;
+
+    Disarm();
+    m_steps = steps;
+    m_index = 0;
+    m_mode = MODE_RUNNING;
+    RunStep();
+    return true;
+}
+
+void PtzTour::Stop()
+{
+    Disarm();
+    m_mode = MODE_IDLE;
+}
+
+void PtzTour::OnManualControl()
+{
+    if (m_mode == MODE_IDLE) return;
+
+    if (m_resumeIdleMs == 0) {
+        Stop();
+        return;
+    }
+
+    // 每次手动操作都重新计时
+    m_mode = MODE_PAUSED;
+    Arm(m_resumeIdleMs);
+}
+
+bool PtzTour::OnEvent(Event_Ptr& e)
+{
+    if (e->eId() != DeviceEventID::PtzTourTimer) return false;
+
+    auto te = std::dynamic_pointer_cast<PtzTourTimerEvent>(e);
+    if (!te || te->Dat != m_gen) return true; // 已被取消或重新计时
+
+    m_timer = TimerService::INVALID_TIMER;
+    if (m_mode == MODE_RUNNING) {
+        m_index = (m_index + 1) % m_steps.size();
+        RunStep();
+    }
+    else if (m_mode == MODE_PAUSED) {
+        // 空闲超时，回到被打断的预置位继续
+        m_mode = MODE_RUNNING;
+        RunStep();
+    }
+    return true;
+}
+
+void PtzTour::RunStep()
+{
+    const PtzTourStep& step = m_steps[m_index];
+    m_goto(step.preset);
+    Arm(step.dwellMs);
+}
+
+void PtzTour::Arm(u32 ms)
+{
+    Disarm();
+
+    u32 gen = m_gen;
+    PostFunc post = m_post;
+    m_timer = TimerService::instance().schedule(ms, [post, gen]() {
+        post(new PtzTourTimerEvent(gen));
+    });
+}
+
+void PtzTour::Disarm()
+{
+    if (m_timer != TimerService::INVALID_TIMER) {
+        TimerService::instance().cancel(m_timer);
+        m_timer = TimerService::INVALID_TIMER;
+    }
+    ++m_gen;
+}
+
+
+ECCS_END
@@ -0,0 +1,74 @@
+#pragma once
+#include "../../global.h"
+#include "../DeviceEvents.h"
+#include "thread/timer_service.h"
+#include <functional>
+#include <vector>
+
+ECCS_BEGIN
+
+//------------------------------------------------------
+// PtzTour: 预置位巡航
+// * 巡航定义: "预置位:停留秒数,..."，如 "1:10,2:10,3:15" (秒数省略时为 10)
+// * 定时由共享的 TimerService 负责，到期后向设备线程投递事件，
+//   所有巡航状态只在设备线程中访问
+// * 手动控制 (移动/停止/预置位) 打断巡航，空闲 resumeIdle 后从当前点恢复
+//------------------------------------------------------
+
+struct PtzTourStep {
+    u8  preset;
+    u32 dwellMs;
+};
+
+class PtzTour
+{
+    NON_COPYABLE(PtzTour);
+
+public:
+    using GotoFunc = std::function<void(u8 preset)>;
+    using PostFunc = std::function<void(Event* e)>;   // 投递到设备线程 (接管所有权)
+
+    PtzTour();
+    ~PtzTour();
+
+    void Bind(GotoFunc gotoPreset, PostFunc post);
+
+    // 手动控制后的恢复等待时间 (0 = 手动控制后结束巡航)
+    void SetResumeIdle(u32 ms) { m_resumeIdleMs = ms; }
+
+    static bool Parse(const str& def, std::vector<PtzTourStep>& steps);
+
+    bool Start(const std::vector<PtzTourStep>& steps);
+    void Stop();
+
+    // 手动控制通知
+    void OnManualControl();
+
+    // 设备线程事件入口，返回 true 表示已处理
+    bool OnEvent(Event_Ptr& e);
+
+    bool IsRunning() const { return m_mode == MODE_RUNNING; }
+    bool IsActive() const { return m_mode != MODE_IDLE; }
+
+private:
+    void RunStep();
+    void Arm(u32 ms);
+    void Disarm();
+
+private:
+    enum Mode { MODE_IDLE, MODE_RUNNING, MODE_PAUSED };
+
+    GotoFunc m_goto;
+    PostFunc m_post;
+
+    std::vector<PtzTourStep> m_steps;
+    size_t m_index;
+    Mode   m_mode;
+    u32    m_resumeIdleMs;
+
+    TimerService::TimerId m_timer;
+    u32    m_gen;      // 每次 Arm/Disarm 递增，旧定时器事件据此丢弃
+};
+
+
+ECCS_END
@@ -0,0 +1,134 @@
+#include "AudioJitterBuffer.h"
+#include <string.h>
+
+ECCS_BEGIN
+
+
+AudioJitterBuffer::AudioJitterBuffer(u32 slots, u32 maxPayload, u32 depth, u32 frameBytes)
+    : m_maxPayload(maxPayload), m_depth(depth ? depth : 1), m_frame(frameBytes)
+{
+    // 槽位数取 2 的幂，保证 16 位序号回绕时映射连续
+    u32 n = 1;
+    while (n < slots) n <<= 1;
+    slots = n;
+
+    m_pool.resize((size_t)slots * maxPayload);
+    m_slots.resize(slots);
+    if (m_depth > slots) m_depth = slots;
+    for (u32 i = 0; i < slots; ++i) {
+        m_slots[i].data = &m_pool[(size_t)i * maxPayload];
+    }
+    Reset();
+}
+
+void AudioJitterBuffer::Reset()
+{
+    for (size_t i = 0; i < m_slots.size(); ++i) {
+        m_slots[i].used = false;
+    }
+    m_count = 0;
+    m_started = false;
+    m_nextSeq = 0;
+    m_lastLen = 0;
+    m_frameFill = 0;
+    m_lost = 0;
+    m_late = 0;
+}
+
+void AudioJitterBuffer::Push(u16 seq, const u8* payload, u32 len, const FrameCallback& cb)
+{
+    if (len == 0) return;
+    if (len > m_maxPayload) len = m_maxPayload;
+
+    const u32 n = (u32)m_slots.size();
+    if (!m_started && m_count == 0) {
+        m_nextSeq = seq;
+    }
+
+    i16 ahead = (i16)(u16)(seq - m_nextSeq);
+    if (ahead < 0) {
+        if (!m_started) {
+            m_nextSeq = seq;    // 起播前收到更早的报文，前移起点
+        }
+        else {
+            ++m_late;           // 已经输出过的位置，丢弃
+            return;
+        }
+    }
+    else if ((u32)ahead >= n) {
+        // 序号跳变超出窗口 (对端重启等)，清空重新同步
+        for (u32 i = 0; i < n; ++i) m_slots[i].used = false;
+        m_count = 0;
+        m_started = false;
+        m_nextSeq = seq;
+    }
+
+    Slot& s = m_slots[seq % n];
+    if (s.used && s.seq == seq) {
+        return;                 // 重复报文
+    }
+    if (!s.used) ++m_count;
+    s.used = true;
+    s.seq = seq;
+    s.len = len;
+    memcpy(s.data, payload, len);
+
+    if (!m_started && m_count >= m_depth) {
+        m_started = true;
+    }
+    if (m_started) {
+        Drain(cb);
+    }
+}
+
+void AudioJitterBuffer::Drain(const FrameCallback& cb)
+{
+    const u32 n = (u32)m_slots.size();
+    while (m_count > 0) {
+        Slot& s = m_slots[m_nextSeq % n];
+        if (s.used && s.seq == m_nextSeq) {
+            Emit(s.data, s.len, cb);
+            m_lastLen = s.len;
+            s.used = false;
+            --m_count;
+            ++m_nextSeq;
+            continue;
+        }
+
+        // 缺包: 后续报文已积累到抖动深度，不再等待，补静音
+        if (m_count >= m_depth) {
+            Emit(NULL, m_lastLen, cb);
+            ++m_lost;
+            ++m_nextSeq;
+            continue;
+        }
+        break;
+    }
+}
+
+void AudioJitterBuffer::Emit(const u8* data, u32 len, const FrameCallback& cb)
+{
+    const u32 frameBytes = (u32)m_frame.size();
+    while (len > 0) {
+        u32 n = frameBytes - m_frameFill;
+        if (n > len) n = len;
+
+        if (data) {
+            memcpy(&m_frame[m_frameFill], data, n);
+            data += n;
+        }
+        else {
+            memset(&m_frame[m_frameFill], 0, n);
+        }
+        m_frameFill += n;
+        len -= n;
+
+        if (m_frameFill == frameBytes) {
+            if (cb) cb(m_frame.data(), frameBytes);
+            m_frameFill = 0;
+        }
+    }
+}
+
+
+ECCS_END
@@ -0,0 +1,69 @@
+#pragma once
+#include "../../global.h"
+#include <functional>
+#include <vector>
+
+ECCS_BEGIN
+
+//------------------------------------------------------
+// AudioJitterBuffer: 接收侧重排 / 抖动缓冲
+// * 按 16 位序号 (RTP seq) 重排乱序报文，迟到报文丢弃
+// * 缓存达到 depth 个报文后开始输出；缺包且后续报文已足够时判为丢包，以静音填补
+// * 输出按固定帧长重新切分，所有缓存在构造时一次性分配
+// * 非线程安全，由接收线程独占使用
+//------------------------------------------------------
+
+class AudioJitterBuffer
+{
+    NON_COPYABLE(AudioJitterBuffer);
+
+public:
+    using FrameCallback = std::function<void(const u8*, u32)>;
+
+    /**
+     * @param slots：可缓存的报文数 (重排窗口，向上取 2 的幂)
+     * @param maxPayload：单个报文最大负载字节数
+     * @param depth：开始输出前的缓冲报文数 (抖动深度)
+     * @param frameBytes：输出帧字节数
+     */
+    AudioJitterBuffer(u32 slots, u32 maxPayload, u32 depth, u32 frameBytes);
+
+    // 写入一个报文，并输出所有可输出的完整帧
+    void Push(u16 seq, const u8* payload, u32 len, const FrameCallback& cb);
+
+    void Reset();
+
+    u64 LostPackets() const { return m_lost; }
+    u64 LatePackets() const { return m_late; }
+
+private:
+    struct Slot {
+        bool used;
+        u16  seq;
+        u32  len;
+        u8*  data;
+    };
+
+    void Drain(const FrameCallback& cb);
+    void Emit(const u8* data, u32 len, const FrameCallback& cb);
+
+private:
+    u32 m_maxPayload;
+    u32 m_depth;
+
+    std::vector<u8>   m_pool;     // slots * maxPayload
+    std::vector<Slot> m_slots;
+    u32  m_count;                 // 已缓存报文数
+    bool m_started;
+    u16  m_nextSeq;
+    u32  m_lastLen;               // 最近报文长度，丢包时按此长度补静音
+
+    std::vector<u8> m_frame;
+    u32 m_frameFill;
+
+    u64 m_lost;
+    u64 m_late;
+};
+
+
+ECCS_END
@@ -0,0 +1,337 @@
+#include "AudioMixer.h"
+#include <string.h>
+
+#if defined(__AVX2__)
+#  include <immintrin.h>
+#  define ECCS_MIX_AVX2 1
+#elif defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#  include <emmintrin.h>
+#  define ECCS_MIX_SSE2 1
+#endif
+
+ECCS_BEGIN
+
+
+//------------------------------------------------------
+// 混音内核
+// acc[i] += (src[i] * gain) >> 14
+// out[i]  = saturate16(acc[i])
+// 单源贡献最多 17 位，16 路累加不会溢出 32 位
+//------------------------------------------------------
+
+static void AccumulateScaled(i32* acc, const i16* src, u32 n, i16 gain)
+{
+    u32 i = 0;
+#if defined(ECCS_MIX_AVX2)
+    const __m256i g = _mm256_set1_epi32(gain);
+    for (; i + 8 <= n; i += 8) {
+        __m256i x = _mm256_cvtepi16_epi32(_mm_loadu_si128((const __m128i*)(src + i)));
+        __m256i p = _mm256_srai_epi32(_mm256_mullo_epi32(x, g), 14);
+        __m256i a = _mm256_loadu_si256((const __m256i*)(acc + i));
+        _mm256_storeu_si256((__m256i*)(acc + i), _mm256_add_epi32(a, p));
+    }
+#elif defined(ECCS_MIX_SSE2)
+    const __m128i g = _mm_set1_epi16(gain);
+    for (; i + 8 <= n; i += 8) {
+        __m128i x  = _mm_loadu_si128((const __m128i*)(src + i));
+        __m128i lo = _mm_mullo_epi16(x, g);
+        __m128i hi = _mm_mulhi_epi16(x, g);
+        __m128i p0 = _mm_srai_epi32(_mm_unpacklo_epi16(lo, hi), 14);
+        __m128i p1 = _mm_srai_epi32(_mm_unpackhi_epi16(lo, hi), 14);
+        __m128i a0 = _mm_loadu_si128((const __m128i*)(acc + i));
+        __m128i a1 = _mm_loadu_si128((const __m128i*)(acc + i + 4));
+        _mm_storeu_si128((__m128i*)(acc + i), _mm_add_epi32(a0, p0));
+        _mm_storeu_si128((__m128i*)(acc + i + 4), _mm_add_epi32(a1, p1));
+    }
+#endif
+    for (; i < n; ++i) {
+        acc[i] += ((i32)src[i] * gain) >> 14;
+    }
+}
+
+static void SaturateStore(i16* out, const i32* acc, u32 n)
+{
+    u32 i = 0;
+#if defined(ECCS_MIX_AVX2)
+    for (; i + 16 <= n; i += 16) {
+        __m256i a0 = _mm256_loadu_si256((const __m256i*)(acc + i));
+        __m256i a1 = _mm256_loadu_si256((const __m256i*)(acc + i + 8));
+        // packs 按 128 位通道交错，需要重排 64 位块恢复顺序
+        __m256i r = _mm256_permute4x64_epi64(_mm256_packs_epi32(a0, a1), 0xD8);
+        _mm256_storeu_si256((__m256i*)(out + i), r);
+    }
+#elif defined(ECCS_MIX_SSE2)
+    for (; i + 8 <= n; i += 8) {
+        __m128i a0 = _mm_loadu_si128((const __m128i*)(acc + i));
+        __m128i a1 = _mm_loadu_si128((const __m128i*)(acc + i + 4));
+        _mm_storeu_si128((__m128i*)(out + i), _mm_packs_epi32(a0, a1));
+    }
+#endif
+    for (; i < n; ++i) {
+        i32 v = acc[i];
+        out[i] = (i16)(v > 32767 ? 32767 : (v < -32768 ? -32768 : v));
+    }
+}
+
+
+//------------------------------------------------------
+// StreamSource
+//------------------------------------------------------
+
+StreamSource::StreamSource(size_t bufBytes, u32 frameSamples)
+    : m_ring(bufBytes), m_frame(frameSamples), m_active(false),
+      m_markHead(0), m_markTail(0), m_writeTotal(0), m_readTotal(0), m_stats(NULL),
+      m_inChannels(1), m_outChannels(1)
+{
+}
+
+void StreamSource::PushMark(size_t bytes)
+{
+    m_writeTotal += bytes;
+
+    u32 head = m_markHead.load(std::memory_order_relaxed);
+    u32 next = (head + 1) % MARK_SLOTS;
+    if (next == m_markTail.load(std::memory_order_acquire)) {
+        return; // 标记队列满，跳过本次采样
+    }
+    m_marks[head].offset = m_writeTotal;
+    m_marks[head].time = steady_clock::now();
+    m_markHead.store(next, std::memory_order_release);
+}
+
+void StreamSource::PopMarks(size_t bytes)
+{
+    m_readTotal += bytes;
+
+    u32 tail = m_markTail.load(std::memory_order_relaxed);
+    u32 head = m_markHead.load(std::memory_order_acquire);
+    if (tail == head) return;
+
+    steady_clock::time_point now = steady_clock::now();
+    while (tail != head && m_marks[tail].offset <= m_readTotal) {
+        m_stats->AddLatency(ECCS_C11 chrono::duration_cast<duration_us>(now - m_marks[tail].time).count());
+        tail = (tail + 1) % MARK_SLOTS;
+    }
+    m_markTail.store(tail, std::memory_order_release);
+}
+
+void StreamSource::SetInputFormat(u32 inRate, u32 inChannels, u32 outRate, u32 outChannels)
+{
+    std::lock_guard<std::mutex> lock(m_convMutex);
+    m_conv.reset(new AudioResampler(inRate, inChannels, outRate, outChannels));
+    m_inChannels = inChannels ? inChannels : 1;
+    m_outChannels = outChannels ? outChannels : 1;
+    if (m_conv->IsPassthrough()) {
+        m_conv.reset();
+    }
+}
+
+size_t StreamSource::Write(const u8* data, size_t len)
+{
+    std::lock_guard<std::mutex> lock(m_convMutex);
+    if (m_conv) {
+        u32 frames = (u32)(len / (sizeof(i16) * m_inChannels));
+        m_convBuf.clear();
+        m_conv->Process((const i16*)data, frames, m_convBuf);
+        data = (const u8*)m_convBuf.data();
+        len = m_convBuf.size() * sizeof(i16);
+    }
+    if (len == 0) {
+        return 0;
+    }
+
+    // 缓冲区满时只写入能放下的整帧，截断出的半帧会使之后取出的采样全部错位
+    // (取出端只有混音线程，空闲空间只会变大)
+    size_t frameBytes = sizeof(i16) * m_outChannels;
+    size_t space = m_ring.Capacity() - m_ring.Available();
+    size_t fit = ((len < space) ? len : space) / frameBytes * frameBytes;
+    size_t written = (fit > 0) ? m_ring.Write(data, fit) : 0;
+    if (m_stats) {
+        m_stats->Add(m_stats->pushBytes, written);
+        if (written < len) {
+            m_stats->Add(m_stats->overrunBytes, len - written);
+        }
+        if (written > 0) {
+            PushMark(written);
+        }
+    }
+    return written;
+}
+
+u32 StreamSource::Fetch(const i16*& data, u32 count)
+{
+    if (count > m_frame.size()) {
+        count = (u32)m_frame.size();
+    }
+
+    // 只按整采样读取，避免奇数字节导致后续数据错位
+    size_t avail = m_ring.Available() / sizeof(i16);
+    if (avail < count) {
+        // 正在播放的流取不满一帧，视为欠载
+        if (m_active && m_stats) {
+            m_stats->Add(m_stats->underruns);
+        }
+        m_active = false;
+        count = (u32)avail;
+    }
+    else {
+        m_active = true;
+    }
+    if (count == 0) {
+        return 0;
+    }
+
+    m_ring.Read((u8*)m_frame.data(), count * sizeof(i16));
+    if (m_stats) {
+        PopMarks(count * sizeof(i16));
+    }
+    data = m_frame.data();
+    return count;
+}
+
+
+//------------------------------------------------------
+// AudioMixer
+//------------------------------------------------------
+
+AudioMixer::AudioMixer(u32 frameSamples)
+    : m_frameSamples(frameSamples), m_duckGain(ToQ14(0.3f)), m_acc(frameSamples)
+{
+    for (int i = 0; i < MAX_SOURCES; ++i) {
+        m_slots[i].priority = 0;
+        m_slots[i].gain = 0;
+    }
+}
+
+i16 AudioMixer::ToQ14(float gain)
+{
+    if (gain < 0.0f) gain = 0.0f;
+    if (gain > 1.99f) gain = 1.99f;
+    return (i16)(gain * 16384.0f + 0.5f);
+}
+
+int AudioMixer::AddSource(AudioSource_Ptr src, u8 priority, float gain)
+{
+    if (!src) {
+        return -1;
+    }
+
+    std::lock_guard<std::mutex> lock(m_mutex);
+    for (int i = 0; i < MAX_SOURCES; ++i) {
+        if (!m_slots[i].src) {
+            m_slots[i].src = src;
+            m_slots[i].priority = priority;
+            m_slots[i].gain = ToQ14(gain);
+            return i;
+        }
+    }
+    return -1;
+}
+
+bool AudioMixer::RemoveSource(int id)
+{
+    if (id < 0 || id >= MAX_SOURCES) {
+        return false;
+    }
+
+    std::lock_guard<std::mutex> lock(m_mutex);
+    if (!m_slots[id].src) {
+        return false;
+    }
+    m_slots[id].src.reset();
+    return true;
+}
+
+bool AudioMixer::SetGain(int id, float gain)
+{
+    if (id < 0 || id >= MAX_SOURCES) {
+        return false;
+    }
+
+    std::lock_guard<std::mutex> lock(m_mutex);
+    if (!m_slots[id].src) {
+        return false;
+    }
+    m_slots[id].gain = ToQ14(gain);
+    return true;
+}
+
+AudioSource_Ptr AudioMixer::GetSource(int id)
+{
+    if (id < 0 || id >= MAX_SOURCES) {
+        return AudioSource_Ptr();
+    }
+
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_slots[id].src;
+}
+
+void AudioMixer::SetDuckGain(float gain)
+{
+    if (gain > 1.0f) gain = 1.0f;
+
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_duckGain = ToQ14(gain);
+}
+
+int AudioMixer::Mix(i16* out)
+{
+    struct Input {
+        const i16* data;
+        u32 count;
+        u8  priority;
+        i16 gain;
+    };
+    Input inputs[MAX_SOURCES];
+    int nInputs = 0;
+    int topPriority = -1;
+
+    std::lock_guard<std::mutex> lock(m_mutex);
+
+    // 1. 取数据，同时统计有数据的最高优先级
+    for (int i = 0; i < MAX_SOURCES; ++i) {
+        Slot& s = m_slots[i];
+        if (!s.src) continue;
+
+        const i16* data = NULL;
+        u32 cnt = s.src->Fetch(data, m_frameSamples);
+        if (cnt == 0) {
+            // 文件源播放完毕后自动移除
+            if (s.src->IsFinished()) s.src.reset();
+            continue;
+        }
+
+        Input& in = inputs[nInputs++];
+        in.data = data;
+        in.count = cnt;
+        in.priority = s.priority;
+        in.gain = s.gain;
+        if (s.priority > topPriority) topPriority = s.priority;
+    }
+
+    if (nInputs == 0) {
+        memset(out, 0, m_frameSamples * sizeof(i16));
+        return 0;
+    }
+
+    // 2. 按增益累加，低优先级源压低
+    i32* acc = m_acc.data();
+    memset(acc, 0, m_frameSamples * sizeof(i32));
+    for (int i = 0; i < nInputs; ++i) {
+        const Input& in = inputs[i];
+        i16 gain = in.gain;
+        if (in.priority < topPriority) {
+            gain = (i16)(((i32)gain * m_duckGain) >> 14);
+        }
+        if (gain != 0) {
+            AccumulateScaled(acc, in.data, in.count, gain);
+        }
+    }
+
+    // 3. 饱和输出
+    SaturateStore(out, acc, m_frameSamples);
+    return nInputs;
+}
+
+
+ECCS_END
@@ -0,0 +1,152 @@
+#pragma once
+#include "../../global.h"
+#include "../../utils/ring_buffer.h"
+#include "AudioResampler.h"
+#include "AudioStats.h"
+#include "../../time/sal_chrono.h"
+#include <memory>
+#include <mutex>
+#include <vector>
+
+ECCS_BEGIN
+
+//------------------------------------------------------
+// AudioSource: 混音输入源 (PCM 16bit 小端, 与输出格式一致)
+//------------------------------------------------------
+
+class AudioSource
+{
+public:
+    virtual ~AudioSource() {}
+
+    /**
+     * @brief Fetch 取出最多 count 个采样
+     * @param data：输出，指向连续采样数据 (在下一次 Fetch 前有效)
+     * @param count：期望的采样数
+     * @return 实际采样数，0 表示当前无数据
+     */
+    virtual u32 Fetch(const i16*& data, u32 count) = 0;
+
+    // 数据是否已经全部取完 (实时源永远返回 false)
+    virtual bool IsFinished() const { return false; }
+};
+typedef std::shared_ptr<AudioSource> AudioSource_Ptr;
+
+
+//------------------------------------------------------
+// StreamSource: 实时推流源 (喊话、告警音等)，内部用 RingBuffer 缓存
+//------------------------------------------------------
+
+class StreamSource : public AudioSource
+{
+public:
+    StreamSource(size_t bufBytes, u32 frameSamples);
+
+    /**
+     * @brief SetInputFormat 设置写入数据的格式
+     * 与输出格式不同时，Write 会先做重采样/声道转换再缓存
+     */
+    void SetInputFormat(u32 inRate, u32 inChannels, u32 outRate, u32 outChannels);
+
+    // 写入 PCM 数据 (需为整帧)，返回实际缓存字节数 (缓冲区满时按整帧截断)
+    size_t Write(const u8* data, size_t len);
+
+    virtual u32 Fetch(const i16*& data, u32 count) override;
+
+    // 统计输出 (溢出/欠载/写入到取出的延迟)，需在开始写入前设置
+    void SetStats(AudioStats* stats) { m_stats = stats; }
+
+    size_t Buffered() { return m_ring.Available(); }
+    size_t Capacity() const { return m_ring.Capacity(); }
+
+private:
+    void PushMark(size_t bytes);
+    void PopMarks(size_t bytes);
+
+private:
+    RingBuffer       m_ring;
+    std::vector<i16> m_frame;
+    bool             m_active;  // 上一帧取满，用于识别欠载
+
+    // 延迟标记: 每次写入记录 (累计写入位置, 时间)，取到该位置时计算延迟
+    // 写入端持有 m_convMutex，读取端只有混音线程，构成单生产者/单消费者
+    struct Mark {
+        u64 offset;
+        steady_clock::time_point time;
+    };
+    static const u32 MARK_SLOTS = 64;
+    Mark             m_marks[MARK_SLOTS];
+    std::atomic<u32> m_markHead;
+    std::atomic<u32> m_markTail;
+    u64              m_writeTotal;
+    u64              m_readTotal;
+    AudioStats*      m_stats;
+
+    // 格式转换 (仅写入线程使用)
+    std::mutex                       m_convMutex;
+    std::unique_ptr<AudioResampler>  m_conv;
+    u32                              m_inChannels;
+    u32                              m_outChannels;  // 缓存数据的声道数
+    std::vector<i16>                 m_convBuf;
+};
+typedef std::shared_ptr<StreamSource> StreamSource_Ptr;
+
+
+//------------------------------------------------------
+// AudioMixer: 多路 PCM 混音 (增益 + 优先级压低)
+// * 增益为 Q14 定点 (16384 = 1.0)，最大约 2.0
+// * 有数据的最高优先级源保持原增益，低优先级源再乘以 duckGain
+// * 累加在 32 位整型中完成，最后饱和截断为 16 位 (SSE2/AVX2/标量)
+//------------------------------------------------------
+
+class AudioMixer
+{
+    NON_COPYABLE(AudioMixer);
+
+public:
+    static const int MAX_SOURCES = 16;
+
+    AudioMixer(u32 frameSamples);
+
+    /**
+     * @brief AddSource 注册混音源
+     * @param priority：优先级 (0-255)，数值越大优先级越高
+     * @param gain：增益 (0.0 - 2.0)
+     * @return 混音源 ID，-1 表示已满
+     */
+    int AddSource(AudioSource_Ptr src, u8 priority, float gain);
+    bool RemoveSource(int id);
+    bool SetGain(int id, float gain);
+    AudioSource_Ptr GetSource(int id);
+
+    // 高优先级源活跃时，低优先级源的衰减系数 (0.0 - 1.0)
+    void SetDuckGain(float gain);
+
+    u32 FrameSamples() const { return m_frameSamples; }
+
+    /**
+     * @brief Mix 混合一帧 (FrameSamples 个采样)
+     * @param out：输出缓冲区，至少 FrameSamples 个采样
+     * @return 本帧有数据的源个数，0 表示全部静默 (out 置零)
+     */
+    int Mix(i16* out);
+
+private:
+    struct Slot {
+        AudioSource_Ptr src;
+        u8  priority;
+        i16 gain;       // Q14
+    };
+
+    static i16 ToQ14(float gain);
+
+private:
+    u32               m_frameSamples;
+    i16               m_duckGain;   // Q14
+    Slot              m_slots[MAX_SOURCES];
+    std::vector<i32>  m_acc;
+    std::mutex        m_mutex;
+};
+
+
+ECCS_END
@@ -0,0 +1,210 @@
+#include "AudioResampler.h"
+#include "../../utils/utils.h"
+#include <math.h>
+
+#if defined(__AVX__)
+#  include <immintrin.h>
+#  define ECCS_RS_AVX 1
+#elif defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#  include <emmintrin.h>
+#  define ECCS_RS_SSE 1
+#endif
+
+ECCS_BEGIN
+
+// 每相最少/最多抽头数 (按 4 对齐)
+static const u32 MIN_TAPS = 16;
+static const u32 MAX_TAPS = 64;
+// 多相数上限，限制系数表大小 (常见采样率组合均在此范围内)
+static const u32 MAX_PHASES = 1024;
+
+static u32 gcd(u32 a, u32 b)
+{
+    while (b) { u32 t = a % b; a = b; b = t; }
+    return a;
+}
+
+static float DotProduct(const float* a, const float* b, u32 n)
+{
+    u32 i = 0;
+    float sum = 0.0f;
+#if defined(ECCS_RS_AVX)
+    __m256 acc8 = _mm256_setzero_ps();
+    for (; i + 8 <= n; i += 8) {
+        acc8 = _mm256_add_ps(acc8, _mm256_mul_ps(_mm256_loadu_ps(a + i), _mm256_loadu_ps(b + i)));
+    }
+    __m128 acc = _mm_add_ps(_mm256_castps256_ps128(acc8), _mm256_extractf128_ps(acc8, 1));
+    for (; i + 4 <= n; i += 4) {
+        acc = _mm_add_ps(acc, _mm_mul_ps(_mm_loadu_ps(a + i), _mm_loadu_ps(b + i)));
+    }
+#elif defined(ECCS_RS_SSE)
+    __m128 acc = _mm_setzero_ps();
+    for (; i + 4 <= n; i += 4) {
+        acc = _mm_add_ps(acc, _mm_mul_ps(_mm_loadu_ps(a + i), _mm_loadu_ps(b + i)));
+    }
+#endif
+#if defined(ECCS_RS_AVX) || defined(ECCS_RS_SSE)
+    acc = _mm_add_ps(acc, _mm_movehl_ps(acc, acc));
+    acc = _mm_add_ss(acc, _mm_shuffle_ps(acc, acc, 1));
+    sum = _mm_cvtss_f32(acc);
+#endif
+    for (; i < n; ++i) {
+        sum += a[i] * b[i];
+    }
+    return sum;
+}
+
+static inline i16 SaturateSample(float v)
+{
+    v += (v >= 0.0f) ? 0.5f : -0.5f;
+    if (v > 32767.0f) return 32767;
+    if (v < -32768.0f) return -32768;
+    return (i16)v;
+}
+
+
+AudioResampler::AudioResampler(u32 inRate, u32 inChannels, u32 outRate, u32 outChannels)
+    : m_inRate(inRate), m_inChannels(inChannels ? inChannels : 1),
+      m_outRate(outRate), m_outChannels(outChannels == 2 ? 2 : 1),
+      m_L(1), m_M(1), m_taps(0)
+{
+    m_passthrough = (m_inRate == m_outRate && m_inChannels == m_outChannels);
+
+    if (m_inRate != m_outRate && m_inRate && m_outRate) {
+        u32 g = gcd(m_inRate, m_outRate);
+        m_L = m_outRate / g;
+        m_M = m_inRate / g;
+        if (m_L > MAX_PHASES) {
+            // 非常规采样率组合：近似到 MAX_PHASES 相
+            m_M = (u32)((u64)m_M * MAX_PHASES / m_L);
+            m_L = MAX_PHASES;
+            if (m_M == 0) m_M = 1;
+        }
+        BuildFilter();
+    }
+
+    m_channels.resize(m_outChannels);
+    Reset();
+}
+
+void AudioResampler::BuildFilter()
+{
+    // 降采样时截止频率随之降低，需要更多抽头维持过渡带
+    u32 taps = MIN_TAPS;
+    if (m_M > m_L) {
+        taps = (u32)((u64)MIN_TAPS * m_M / m_L);
+    }
+    taps = (taps + 3) & ~3u;
+    if (taps > MAX_TAPS) taps = MAX_TAPS;
+    m_taps = taps;
+
+    // 原型低通: 上采样域 (inRate * L) 下的 Blackman 窗 sinc
+    const u32 P = m_taps * m_L;
+    const double fc = 0.45 / (m_L > m_M ? m_L : m_M);
+    const double center = (P - 1) / 2.0;
+    std::vector<double> h(P);
+    for (u32 i = 0; i < P; ++i) {
+        double t = i - center;
+        double s = (t == 0.0) ? 2.0 * fc : sin(2.0 * M_PI * fc * t) / (M_PI * t);
+        double w = 0.42 - 0.5 * cos(2.0 * M_PI * i / (P - 1)) + 0.08 * cos(4.0 * M_PI * i / (P - 1));
+        h[i] = s * w * m_L;
+    }
+
+    // 拆分为多相并反序: y = sum(c[phase][j] * x[base - taps + 1 + j])
+    m_coeffs.resize(P);
+    for (u32 phase = 0; phase < m_L; ++phase) {
+        for (u32 j = 0; j < m_taps; ++j) {
+            m_coeffs[phase * m_taps + j] = (float)h[(m_taps - 1 - j) * m_L + phase];
+        }
+    }
+}
+
+void AudioResampler::Reset()
+{
+    for (size_t i = 0; i < m_channels.size(); ++i) {
+        Channel& c = m_channels[i];
+        c.hist.assign(m_taps ? m_taps - 1 : 0, 0.0f);
+        c.base = m_taps ? m_taps - 1 : 0;
+        c.phase = 0;
+    }
+}
+
+void AudioResampler::Process(const i16* in, u32 frames, std::vector<i16>& out)
+{
+    if (m_passthrough) {
+        out.insert(out.end(), in, in + frames * m_inChannels);
+        return;
+    }
+
+    // 1. 声道转换，追加到各声道输入缓存
+    for (u32 ch = 0; ch < m_outChannels; ++ch) {
+        std::vector<float>& hist = m_channels[ch].hist;
+        size_t off = hist.size();
+        hist.resize(off + frames);
+        float* dst = hist.data() + off;
+
+        if (m_outChannels == 1 && m_inChannels > 1) {
+            const float scale = 1.0f / m_inChannels;
+            for (u32 i = 0; i < frames; ++i) {
+                i32 sum = 0;
+                for (u32 k = 0; k < m_inChannels; ++k) sum += in[i * m_inChannels + k];
+                dst[i] = sum * scale;
+            }
+        }
+        else {
+            u32 src = (ch < m_inChannels) ? ch : 0;
+            for (u32 i = 0; i < frames; ++i) {
+                dst[i] = in[i * m_inChannels + src];
+            }
+        }
+    }
+
+    // 2. 逐声道重采样
+    for (u32 ch = 0; ch < m_outChannels; ++ch) {
+        m_planes[ch].clear();
+        RunChannel(ch, m_planes[ch]);
+    }
+
+    // 3. 交错输出
+    size_t n = m_planes[0].size();
+    size_t off = out.size();
+    out.resize(off + n * m_outChannels);
+    i16* dst = out.data() + off;
+    for (size_t i = 0; i < n; ++i) {
+        for (u32 ch = 0; ch < m_outChannels; ++ch) {
+            *dst++ = SaturateSample(m_planes[ch][i]);
+        }
+    }
+}
+
+void AudioResampler::RunChannel(u32 ch, std::vector<float>& outPlane)
+{
+    Channel& c = m_channels[ch];
+
+    // 采样率相同，只做了声道转换
+    if (m_taps == 0) {
+        outPlane.swap(c.hist);
+        c.hist.clear();
+        return;
+    }
+
+    const float* x = c.hist.data();
+    const u32 len = (u32)c.hist.size();
+    while (c.base < len) {
+        const float* win = x + c.base - (m_taps - 1);
+        outPlane.push_back(DotProduct(win, &m_coeffs[c.phase * m_taps], m_taps));
+
+        c.phase += m_M;
+        c.base += c.phase / m_L;
+        c.phase %= m_L;
+    }
+
+    // 丢弃已消费数据，保留 taps-1 个历史
+    u32 drop = c.base - (m_taps - 1);
+    if (drop > len) drop = len;
+    c.hist.erase(c.hist.begin(), c.hist.begin() + drop);
+    c.base -= drop;
+}
+
+
+ECCS_END
@@ -0,0 +1,59 @@
+#pragma once
+#include "../../global.h"
+#include <vector>
+
+ECCS_BEGIN
+
+//------------------------------------------------------
+// AudioResampler: PCM 格式转换 (采样率 + 声道数)
+// * 声道: 多声道平均下混为单声道，单声道复制上混
+// * 采样率: 有理数比 L/M 的多相 FIR (Blackman 窗 sinc)
+// * 内部保留滤波历史，可对连续数据流分块调用
+//------------------------------------------------------
+
+class AudioResampler
+{
+    NON_COPYABLE(AudioResampler);
+
+public:
+    AudioResampler(u32 inRate, u32 inChannels, u32 outRate, u32 outChannels);
+
+    // 输入输出格式相同，无需转换
+    bool IsPassthrough() const { return m_passthrough; }
+
+    /**
+     * @brief Process 转换一段交错 PCM
+     * @param in：输入采样 (交错)
+     * @param frames：输入帧数 (每帧 inChannels 个采样)
+     * @param out：输出 (追加写入，交错)
+     */
+    void Process(const i16* in, u32 frames, std::vector<i16>& out);
+
+    void Reset();
+
+private:
+    void BuildFilter();
+    void RunChannel(u32 ch, std::vector<float>& outPlane);
+
+private:
+    u32 m_inRate, m_inChannels;
+    u32 m_outRate, m_outChannels;
+    bool m_passthrough;
+
+    // 多相滤波器: m_coeffs[phase * m_taps + j]，已反序便于与输入连续点积
+    u32 m_L, m_M;
+    u32 m_taps;
+    std::vector<float> m_coeffs;
+
+    // 每个输出声道的流状态
+    struct Channel {
+        std::vector<float> hist;   // 未消费的输入 (含 taps-1 个历史)
+        u32 base;                  // 下一个输出对应的输入位置
+        u32 phase;                 // 下一个输出的相位
+    };
+    std::vector<Channel> m_channels;
+    std::vector<float>   m_planes[2];
+};
+
+
+ECCS_END
@@ -0,0 +1,71 @@
+#pragma once
+#include "../../global.h"
+#include <atomic>
+
+ECCS_BEGIN
+
+//------------------------------------------------------
+// AudioStats: 音频链路统计 (每个扬声器一份)
+// 全部为原子变量，读取方无需获取任何音频锁
+//------------------------------------------------------
+
+struct AudioStats
+{
+    // 延迟直方图: [i] 统计 2^i ~ 2^(i+1) ms，[0] 含 <1ms，最后一档含更大值
+    static const int LATENCY_BUCKETS = 12;
+
+    std::atomic<u64> pushBytes;         // 推入字节数 (转换后)
+    std::atomic<u64> overrunBytes;      // 缓冲区满被丢弃的字节数
+    std::atomic<u64> underruns;         // 数据流中断次数 (取不满一帧)
+    std::atomic<u64> framesSent;
+    std::atomic<u64> framesSuppressed;  // 被静音抑制的帧
+    std::atomic<u64> sendErrors;
+
+    std::atomic<u32> fillBytes;         // 喊话缓冲当前占用
+    std::atomic<u32> fillMax;           // 喊话缓冲占用峰值
+    std::atomic<u32> bufSize;           // 喊话缓冲容量
+
+    std::atomic<u32> latency[LATENCY_BUCKETS];
+
+    AudioStats() { Reset(); }
+
+    void Reset()
+    {
+        pushBytes = 0;
+        overrunBytes = 0;
+        underruns = 0;
+        framesSent = 0;
+        framesSuppressed = 0;
+        sendErrors = 0;
+        fillBytes = 0;
+        fillMax = 0;
+        for (int i = 0; i < LATENCY_BUCKETS; ++i) latency[i] = 0;
+    }
+
+    void Add(std::atomic<u64>& counter, u64 n = 1)
+    {
+        counter.fetch_add(n, std::memory_order_relaxed);
+    }
+
+    void SetFill(u32 bytes)
+    {
+        fillBytes.store(bytes, std::memory_order_relaxed);
+        if (bytes > fillMax.load(std::memory_order_relaxed)) {
+            fillMax.store(bytes, std::memory_order_relaxed);
+        }
+    }
+
+    void AddLatency(i64 us)
+    {
+        int bucket = 0;
+        u64 ms = (us > 0) ? (u64)us / 1000 : 0;
+        while (ms > 1 && bucket < LATENCY_BUCKETS - 1) {
+            ms >>= 1;
+            ++bucket;
+        }
+        latency[bucket].fetch_add(1, std::memory_order_relaxed);
+    }
+};
+
+
+ECCS_END
@@ -0,0 +1,109 @@
+#include "AudioVad.h"
+#include <math.h>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#  include <emmintrin.h>
+#  define ECCS_VAD_SSE2 1
+#endif
+
+ECCS_BEGIN
+
+// 底噪高于此值后，语音需高出底噪的幅度 (dB)
+static const float SPEECH_MARGIN_DB = 6.0f;
+// 清辅音判定: 能量可低于阈值的幅度 (dB) 与最小过零率
+static const float FRICATIVE_MARGIN_DB = 10.0f;
+static const float FRICATIVE_ZCR = 0.25f;
+// 底噪跟踪系数: 能量低于底噪时快速下降，高于时缓慢上升 (持续噪声数秒后被吸收)
+static const float FLOOR_FALL = 0.2f;
+static const float FLOOR_RISE = 0.005f;
+
+
+AudioVad::AudioVad()
+    : m_thresholdDb(-45.0f), m_hangoverFrames(15), m_keepaliveFrames(25)
+{
+    Reset();
+}
+
+void AudioVad::Configure(float thresholdDb, u32 hangoverFrames, u32 keepaliveFrames)
+{
+    m_thresholdDb = thresholdDb;
+    m_hangoverFrames = hangoverFrames;
+    m_keepaliveFrames = keepaliveFrames;
+    Reset();
+}
+
+void AudioVad::Reset()
+{
+    m_noiseFloorDb = -90.0f;
+    m_speech = false;
+    m_hangover = 0;
+    m_silentFrames = 0;
+}
+
+double AudioVad::MeanSquare(const i16* pcm, u32 samples)
+{
+    u64 sum = 0;
+    u32 i = 0;
+#if defined(ECCS_VAD_SSE2)
+    // madd 两两求平方和，最大 2^31，按无符号 32 位扩展到 64 位累加
+    const __m128i zero = _mm_setzero_si128();
+    __m128i acc = _mm_setzero_si128();
+    for (; i + 8 <= samples; i += 8) {
+        __m128i x = _mm_loadu_si128((const __m128i*)(pcm + i));
+        __m128i m = _mm_madd_epi16(x, x);
+        acc = _mm_add_epi64(acc, _mm_unpacklo_epi32(m, zero));
+        acc = _mm_add_epi64(acc, _mm_unpackhi_epi32(m, zero));
+    }
+    u64 lanes[2];
+    _mm_storeu_si128((__m128i*)lanes, acc);
+    sum = lanes[0] + lanes[1];
+#endif
+    for (; i < samples; ++i) {
+        sum += (u64)((i32)pcm[i] * pcm[i]);
+    }
+    return samples ? (double)sum / samples : 0.0;
+}
+
+bool AudioVad::Process(const i16* pcm, u32 samples, u32 channels)
+{
+    if (channels == 0) channels = 1;
+
+    // 1. 能量 (dBFS)
+    double ms = MeanSquare(pcm, samples);
+    float energyDb = (ms > 0.0) ? (float)(10.0 * log10(ms / (32768.0 * 32768.0))) : -96.0f;
+
+    // 2. 过零率 (第一声道)
+    u32 frames = samples / channels;
+    u32 crossings = 0;
+    for (u32 i = 1; i < frames; ++i) {
+        crossings += ((pcm[(i - 1) * channels] ^ pcm[i * channels]) < 0) ? 1 : 0;
+    }
+    float zcr = (frames > 1) ? (float)crossings / (frames - 1) : 0.0f;
+
+    // 3. 判决
+    bool loud = energyDb > m_thresholdDb && energyDb > m_noiseFloorDb + SPEECH_MARGIN_DB;
+    bool fricative = energyDb > m_thresholdDb - FRICATIVE_MARGIN_DB
+        && energyDb > m_noiseFloorDb + SPEECH_MARGIN_DB / 2
+        && zcr > FRICATIVE_ZCR;
+    m_speech = loud || fricative;
+
+    float alpha = (energyDb < m_noiseFloorDb) ? FLOOR_FALL : FLOOR_RISE;
+    m_noiseFloorDb += (energyDb - m_noiseFloorDb) * alpha;
+
+    if (m_speech) {
+        m_hangover = m_hangoverFrames;
+        m_silentFrames = 0;
+        return true;
+    }
+
+    if (m_hangover > 0) {
+        --m_hangover;
+        return true;
+    }
+
+    ++m_silentFrames;
+    return m_keepaliveFrames > 0 && (m_silentFrames % m_keepaliveFrames) == 0;
+}
+
+
+ECCS_END
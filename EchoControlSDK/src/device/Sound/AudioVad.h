@@ -0,0 +1,55 @@
+#pragma once
+#include "../../global.h"
+
+ECCS_BEGIN
+
+//------------------------------------------------------
+// AudioVad: 语音活动检测 (能量 + 过零率)
+// * 能量高于阈值且高于自适应底噪判为语音 (持续的背景噪声会被底噪吸收)
+// * 能量稍低但过零率高 (清辅音) 同样判为语音
+// * 语音结束后保持 hangover 帧，避免切掉尾音
+// * 静音期间每 keepalive 帧放行一帧，维持设备端流状态 (0 = 全部丢弃)
+//------------------------------------------------------
+
+class AudioVad
+{
+public:
+    AudioVad();
+
+    /**
+     * @brief Configure 配置检测参数
+     * @param thresholdDb：能量阈值 (dBFS，如 -45)
+     * @param hangoverFrames：语音结束后的保持帧数
+     * @param keepaliveFrames：静音时的放行间隔帧数
+     */
+    void Configure(float thresholdDb, u32 hangoverFrames, u32 keepaliveFrames);
+
+    void Reset();
+
+    /**
+     * @brief Process 检测一帧
+     * @param pcm：交错 PCM
+     * @param samples：采样总数 (含所有声道)
+     * @param channels：声道数 (过零率只统计第一声道)
+     * @return true 表示本帧需要发送
+     */
+    bool Process(const i16* pcm, u32 samples, u32 channels);
+
+    bool IsSpeech() const { return m_speech; }
+
+private:
+    static double MeanSquare(const i16* pcm, u32 samples);
+
+private:
+    float m_thresholdDb;
+    u32   m_hangoverFrames;
+    u32   m_keepaliveFrames;
+
+    float m_noiseFloorDb;   // 自适应底噪
+    bool  m_speech;
+    u32   m_hangover;       // 剩余保持帧数
+    u32   m_silentFrames;   // 连续静音帧数
+};
+
+
+ECCS_END
@@ -1,6 +1,9 @@
 #pragma once
 #include "../DeviceBase.h"
 #include "device/DeviceDataTypes.h"
+#include "AudioStats.h"
+#include <memory>
+#include <mutex>
 
 ECCS_BEGIN
 
@@ -8,13 +11,13 @@ class ISound_Device : public DeviceBase
 {
 public:
     // =================================================
-    // ģʽ
+    // 模式控制
     // =================================================
     virtual bool SetSoundMode(SoundStatus mode) = 0;
     virtual SoundStatus GetSoundMode() const = 0;
 
     // =================================================
-    // ſ
+    // 播放控制
     // =================================================
     virtual bool PlayIndex(int index, bool loop = false) = 0;
     virtual bool StopPlay() = 0;
@@ -23,12 +26,12 @@ public:
     virtual bool SetSingleLoop(bool enable) = 0;
 
     // =================================================
-    // һɢ
+    // 一键驱散
     // =================================================
     virtual bool OneKeyPlay(int index) = 0;
 
     // =================================================
-    // ƣConfig ͬ
+    // 音量控制（Config 同步）
     // =================================================
     virtual bool SetPlayVolume(u8 vol) = 0;
     virtual bool GetPlayVolume(u8& vol) const = 0;
@@ -37,24 +40,68 @@ public:
     virtual bool GetCaptureVolume(u8& vol) const = 0;
 
     // =================================================
-    // Ƶб / ļ
+    // 音频列表 / 文件管理
     // =================================================
     virtual bool GetAudioList(std::vector<SoundFileInfo>& list) = 0;
     virtual bool UploadAudioFile(const char* name, const u8* data, u32 len) = 0;
     virtual bool DeleteAudioFile(int index) = 0;
 
     // =================================================
-    // ʵʱƵȫ˫
+    // 实时音频（全双工）
     // =================================================
     virtual bool PushAudio(const u8* data, u32 len) = 0;
 
+    // =================================================
+    // SDK 侧混音（多路 PCM 叠加后推流，可选能力）
+    // =================================================
+    // 返回混音源 ID，<0 表示失败
+    virtual int AddMixSource(u8 priority, float gain) {
+        LOG_WARNING("[Slot %d] Device (Model: %s) does not support Mixing.",
+            m_slotID, GetProperty("Model").c_str());
+        return -1;
+    }
+    virtual bool RemoveMixSource(int sourceId) {
+        LOG_WARNING("[Slot %d] Device (Model: %s) does not support Mixing.",
+            m_slotID, GetProperty("Model").c_str());
+        return false;
+    }
+    virtual bool PushMixSource(int sourceId, const u8* data, u32 len) {
+        LOG_WARNING("[Slot %d] Device (Model: %s) does not support Mixing.",
+            m_slotID, GetProperty("Model").c_str());
+        return false;
+    }
+    virtual bool SetMixSourceGain(int sourceId, float gain) {
+        LOG_WARNING("[Slot %d] Device (Model: %s) does not support Mixing.",
+            m_slotID, GetProperty("Model").c_str());
+        return false;
+    }
+    // 本地 WAV 文件作为混音源推流，返回混音源 ID (<0 失败)
+    virtual int StreamFile(const char* path, bool loop) {
+        LOG_WARNING("[Slot %d] Device (Model: %s) does not support StreamFile.",
+            m_slotID, GetProperty("Model").c_str());
+        return -1;
+    }
+    // 音频链路统计 (不支持时返回 nullptr)
+    virtual const AudioStats* GetAudioStats() const { return nullptr; }
+    // 推流数据的 PCM 格式，与设备格式不同时在 SDK 侧转换 (sourceId < 0 表示 PushAudio)
+    virtual bool SetInputFormat(int sourceId, u32 sampleRate, u32 channels) {
+        LOG_WARNING("[Slot %d] Device (Model: %s) does not support Format Conversion.",
+            m_slotID, GetProperty("Model").c_str());
+        return false;
+    }
+
+    // 采集音频回调 (在接收线程中调用，固定帧长)
     using AudioCallback = std::function<void(const u8*, u32)>;
+    using AudioCallback_Ptr = std::shared_ptr<const AudioCallback>;
     void SetCaptureCallback(AudioCallback cb) {
-        m_audioCb = cb;
+        // 接收线程每帧只复制指针，不复制 std::function (避免实时路径上的堆分配)
+        AudioCallback_Ptr p = cb ? std::make_shared<const AudioCallback>(std::move(cb)) : AudioCallback_Ptr();
+        std::lock_guard<std::mutex> lock(m_audioCbMutex);
+        m_audioCb.swap(p);
     }
 
     // =================================================
-    // ״̬ص
+    // 播放状态回调
     // =================================================
     using PlayStateCallback = std::function<void(SoundPlayState)>;
     void SetPlayStateCallback(PlayStateCallback cb) {
@@ -68,7 +115,8 @@ protected:
     }
 
 protected:
-    AudioCallback      m_audioCb;
+    AudioCallback_Ptr  m_audioCb;      // 由 m_audioCbMutex 保护
+    std::mutex         m_audioCbMutex;
     PlayStateCallback  m_playStateCb;
 };
 
@@ -2,20 +2,58 @@
 #include "debug/Exceptions.h"
 #include "debug/Logger.h"
 #include "time/time_utils.h"
+#include "protocol/Packet_Def.h"
+#include "utils/buffer_pool.h"
 #include <chrono>
+#include <string.h>
 
 ECCS_BEGIN
 
+// 指令帧分隔符
+static const char JSON_DELIMITER[] = "\r\n\r\n";
+
 Sound_NetSpeaker_V2::Sound_NetSpeaker_V2()
-    : m_cseq(0), m_heartbeatThread(nullptr), m_keepHeartbeat(false), m_isMicOpen(false),
-      m_audioThread(nullptr), m_audioBuf(nullptr)
+    : m_cseq(0), m_writer(4096), m_parser(8192), m_cmdTimeoutMs(3000),
+      m_playState(Stopped), m_playStateKnown(false),
+      m_heartbeatThread(nullptr), m_keepHeartbeat(false),
+      m_audioRate(16000), m_audioChannels(1), m_mixer(nullptr),
+      m_audioThread(nullptr), m_captureThread(nullptr), m_isMicOpen(false)
 {
-
+    memset(m_pending, 0, sizeof(m_pending));
+
+    // 读取线程提取应答字段后转交设备线程
+    m_parser.SetHandler([this](const JsonMessage& msg) {
+        SpeakerReply reply;
+        ExtractReply(msg, reply);
+        postEvent(new SpeakerReplyEvent(reply));
+    });
 }
 
 Sound_NetSpeaker_V2::~Sound_NetSpeaker_V2() 
 {
-    Stop(); // ȷֹ߳ͣ
+    Stop(); // 确保线程停止
+
+    if (m_mixer) {
+        delete m_mixer;
+        m_mixer = nullptr;
+    }
+}
+
+void Sound_NetSpeaker_V2::OnRegisterProperties()
+{
+    RegisterProp<int>("AudioRate", 16000, "PCM Sample Rate");
+    RegisterProp<int>("AudioChannels", 1, "PCM Channels");
+    RegisterProp<int>("MicPriority", 200, "Mic Source Priority (0-255)");
+    RegisterProp<int>("DuckGain", 30, "Low Priority Source Gain When Ducked (%)");
+    RegisterProp<int>("StreamPriority", 100, "Local File Stream Priority (0-255)");
+    RegisterProp<int>("CapturePort", 0, "Local UDP Port For Speaker Mic Audio (0=Disabled)");
+    RegisterProp<bool>("CaptureRtp", true, "Capture Stream Has RTP Header");
+    RegisterProp<int>("CaptureJitter", 60, "Capture Jitter Buffer Depth (ms)");
+    RegisterProp<bool>("VadEnable", false, "Suppress Silent Frames On Uplink");
+    RegisterProp<int>("VadThreshold", -45, "VAD Energy Threshold (dBFS)");
+    RegisterProp<int>("VadHangover", 300, "VAD Hangover After Speech (ms)");
+    RegisterProp<int>("VadKeepalive", 500, "Send One Silent Frame Every N ms (0=None)");
+    RegisterProp<int>("CmdTimeout", 3000, "Command Response Timeout (ms)");
 }
 
 bool Sound_NetSpeaker_V2::Init(int slotID, const std::map<str, str>& config) 
@@ -25,9 +63,31 @@ bool Sound_NetSpeaker_V2::Init(int slotID, const std::map<str, str>& config)
     m_ip = GetPropValue<str>("IP");
     m_port = GetPropValue<int>("Port");
 
-    // ǿ豸Ĭ϶˿ͨ 9527ûԸĬֵ
+    // 强声设备默认端口通常是 9527，如果配置没填，可以给个默认值
     if (m_port == 0) m_port = 9527;
 
+    int cmdTimeout = GetPropValue<int>("CmdTimeout");
+    m_cmdTimeoutMs = (cmdTimeout > 0) ? (u32)cmdTimeout : 3000;
+
+    // 混音器按 AUDIO_FRAME_MS 分帧
+    int rate = GetPropValue<int>("AudioRate");
+    int channels = GetPropValue<int>("AudioChannels");
+    if (rate <= 0) rate = 16000;
+    if (channels <= 0) channels = 1;
+    m_audioRate = (u32)rate;
+    m_audioChannels = (u32)(channels == 2 ? 2 : 1);
+    u32 frameSamples = m_audioRate * AUDIO_FRAME_MS / 1000 * m_audioChannels;
+
+    if (m_mixer) delete m_mixer;
+    m_mixer = new AudioMixer(frameSamples);
+    m_mixer->SetDuckGain(GetPropValue<int>("DuckGain") / 100.0f);
+
+    // 喊话源 (PushAudio)
+    m_micSource = std::make_shared<StreamSource>(AUDIO_SOURCE_BUF, frameSamples);
+    m_micSource->SetStats(&m_stats);
+    m_stats.bufSize = (u32)m_micSource->Capacity();
+    m_mixer->AddSource(m_micSource, (u8)GetPropValue<int>("MicPriority"), 1.0f);
+
     return true;
 }
 
@@ -35,24 +95,27 @@ bool Sound_NetSpeaker_V2::Start()
 {
     if (!Connect()) {
         LOG_WARNING("[Slot %d] Start: Connect failed, will retry in run loop.", m_slotID);
-        // ע⣺ﷵ true߳Ա߳
+        // 注意：这里返回 true，允许线程启动，以便在线程里重连
     }
 
     if (!DeviceBase::Start()) return false;
 
-    // ߳
+    // 启动心跳线程
     m_keepHeartbeat = true;
     m_heartbeatThread = new std::thread(&Sound_NetSpeaker_V2::HeartbeatLoop, this);
 
-    m_audioBuf = new RingBuffer(1024 * 100); // 100KB 
     m_audioThread = new std::thread(&Sound_NetSpeaker_V2::AudioTxLoop, this);
 
+    if (GetPropValue<int>("CapturePort") > 0) {
+        m_captureThread = new std::thread(&Sound_NetSpeaker_V2::CaptureRxLoop, this);
+    }
+
     return true;
 }
 
 void Sound_NetSpeaker_V2::Stop() 
 {
-    // ֹͣ߳
+    // 停止心跳线程
     m_keepHeartbeat = false;
     if (m_heartbeatThread) {
         if (m_heartbeatThread->joinable()) m_heartbeatThread->join();
@@ -66,66 +129,59 @@ void Sound_NetSpeaker_V2::Stop()
         m_audioThread = nullptr;
     }
 
-    // [] ͷŻ
-    if (m_audioBuf) {
-        delete m_audioBuf;
-        m_audioBuf = nullptr;
+    if (m_captureThread) {
+        if (m_captureThread->joinable()) m_captureThread->join();
+        delete m_captureThread;
+        m_captureThread = nullptr;
     }
 
-    // ر Socket
+    // 关闭 Socket
     if (m_socket) m_socket->close();
 
-    // ֹͣ๤߳
+    // 停止基类工作线程
     DeviceBase::Stop();
+
+    ClearPending();
 }
 
-// --- ҵ߼ ---
+// --- 业务逻辑 ---
 
 void Sound_NetSpeaker_V2::PlayFile(const char* filename, bool loop) 
 {
-    // Э飺{"command":"start_play","cseq":"x", "index":"filename"}
-    // ע⣺ filename ·Эܲͬﰴͨô
-    char param[256];
-
-    //  filename Ż·
-    // ·ͨ one_key ģʽΪ start_play
-    snprintf(param, sizeof(param), "\"index\":\"%s\"", filename);
-
-    SendJsonCmd(BuildJson("start_play", param));
+    // 协议：{"command":"start_play","cseq":"x", "index":"filename"}
+    // 注意：如果 filename 是路径，协议可能不同，这里按通用处理
+    // 假设 filename 是索引号或者路径
+    // 如果是路径，通常用 one_key 模式，这里简化为 start_play
+    BeginCommand("start_play").Field("index", filename);
+    SendCommand(CMD_PLAY);
 }
 
 void Sound_NetSpeaker_V2::StopPlay() 
 {
-    SendJsonCmd(BuildJson("stop_play"));
+    BeginCommand("stop_play");
+    SendCommand(CMD_STOP);
 }
 
 void Sound_NetSpeaker_V2::TTSPlay(const char* text) 
 {
-    // Э飺start_tts_play, txt=...
-    char param[512];
-    snprintf(param, sizeof(param), "\"txt\":\"%s\",\"play_vol\":\"80\"", text);
-    SendJsonCmd(BuildJson("start_tts_play", param));
+    // 协议：start_tts_play, txt=... (文本按 JSON 转义)
+    BeginCommand("start_tts_play").Field("txt", text).Field("play_vol", "80");
+    SendCommand(CMD_PLAY);
 }
 
 void Sound_NetSpeaker_V2::SetMic(bool isOpen) 
 {
     m_isMicOpen = isOpen;
-    // ģʽҪл model
-    if (isOpen) {
-        // л mic_broadcast ģʽ
-        SendJsonCmd(BuildJson("model_change", "\"model\":\"mic_broadcast\""));
-    }
-    else {
-        // лؿ
-        SendJsonCmd(BuildJson("model_change", "\"model\":\"idle\""));
-    }
+    // 喊话模式需要切换 model
+    // 切换到 mic_broadcast 模式 / 切回空闲
+    BeginCommand("model_change").Field("model", isOpen ? "mic_broadcast" : "idle");
+    SendCommand(CMD_GENERIC);
 }
 
 void Sound_NetSpeaker_V2::SetVolume(u8 vol)
 {
-    char param[64];
-    snprintf(param, sizeof(param), "\"vol\":\"%d\"", vol);
-    SendJsonCmd(BuildJson("set_vol", param)); 
+    BeginCommand("set_vol").FieldAsString("vol", vol);
+    SendCommand(CMD_GENERIC);
 }
 
 void Sound_NetSpeaker_V2::GetVolume(u8 vol_play, u8 vol_cap)
@@ -133,48 +189,222 @@ void Sound_NetSpeaker_V2::GetVolume(u8 vol_play, u8 vol_cap)
 
 }
 
-// --- ڲ ---
+// --- 内部辅助 ---
 
-str Sound_NetSpeaker_V2::BuildJson(const char* cmd, const char* params) 
+JsonWriter& Sound_NetSpeaker_V2::BeginCommand(const char* cmd) 
 {
-    char buf[1024];
-    m_cseq++;
+    // cseq 从 1 开始，0 表示空闲槽位
+    if (++m_cseq <= 0) m_cseq = 1;
 
-    if (params && strlen(params) > 0) {
-        snprintf(buf, sizeof(buf), "{\"command\":\"%s\",\"cseq\":\"%d\",%s}\r\n\r\n",
-            cmd, m_cseq, params);
-    }
-    else {
-        snprintf(buf, sizeof(buf), "{\"command\":\"%s\",\"cseq\":\"%d\"}\r\n\r\n",
-            cmd, m_cseq);
-    }
-    return str(buf);
+    m_writer.Reset();
+    m_writer.BeginObject().Field("command", cmd).FieldAsString("cseq", m_cseq);
+    return m_writer;
 }
 
-void Sound_NetSpeaker_V2::SendJsonCmd(const str& json) 
+bool Sound_NetSpeaker_V2::SendCommand(CmdKind kind) 
 {
-    if (!Connect()) return;
+    m_writer.EndObject().Raw(JSON_DELIMITER, sizeof(JSON_DELIMITER) - 1);
+    if (m_writer.Overflow()) {
+        LOG_ERROR("[Slot %d] Sound command too long (cseq %d), dropped", m_slotID, m_cseq);
+        return false;
+    }
+
+    if (!Connect()) return false;
 
     try {
-        // TCP 
-        m_socket->write((const u8*)json.c_str(), json.length());
-        // LOG_DEBUG("[Sound] Sent: %s", json.c_str()); 
+        // TCP 发送
+        m_socket->write((const u8*)m_writer.Data(), (u32)m_writer.Size());
+        // LOG_DEBUG("[Sound] Sent: %.*s", (int)m_writer.Size(), m_writer.Data()); 
     }
     catch (std::exception& e) {
         LOG_ERROR("[Slot %d] Sound Send Error: %s", m_slotID, e.what());
         SetState(STATE_ERROR);
         m_socket->close();
+        if (kind == CMD_PLAY) SetPlayState(Error);
+        return false;
+    }
+
+    // 登记等待应答；表满时淘汰最早的一条
+    PendingCmd* slot = &m_pending[0];
+    for (int i = 0; i < MAX_PENDING; ++i) {
+        if (m_pending[i].cseq == 0) {
+            slot = &m_pending[i];
+            break;
+        }
+        if (m_pending[i].cseq < slot->cseq) slot = &m_pending[i];
+    }
+    if (slot->cseq != 0) {
+        LOG_WARNING("[Slot %d] Sound: too many pending commands, cseq %d abandoned", m_slotID, slot->cseq);
+        TimerService::instance().cancel(slot->timer);
+    }
+
+    int cseq = m_cseq;
+    slot->cseq = cseq;
+    slot->kind = kind;
+    slot->timer = TimerService::instance().schedule(m_cmdTimeoutMs, [this, cseq]() {
+        postEvent(new SpeakerTimeoutEvent(cseq));
+    });
+    return true;
+}
+
+void Sound_NetSpeaker_V2::ExtractReply(const JsonMessage& msg, SpeakerReply& reply) 
+{
+    reply.cseq = -1;
+    reply.result = 0;
+    reply.playState = -1;
+    reply.command[0] = '\0';
+
+    const char* cmd = msg.Get("command");
+    if (cmd) {
+        strncpy(reply.command, cmd, sizeof(reply.command) - 1);
+        reply.command[sizeof(reply.command) - 1] = '\0';
+    }
+    msg.GetInt("cseq", reply.cseq);
+
+    // 结果: "result"/"code"，0 或 "ok"/"success" 为成功，缺省视为成功
+    const char* result = msg.Get("result");
+    if (!result) result = msg.Get("code");
+    if (result && strcmp(result, "ok") != 0 && strcmp(result, "success") != 0) {
+        char* end;
+        long v = strtol(result, &end, 10);
+        reply.result = (end != result && *end == '\0') ? (int)v : -1;
+    }
+
+    // 播放状态推送: 命令名以 _end/_finish 结尾，或带 play_status (播放类命令的 status)
+    if (cmd) {
+        size_t n = strlen(cmd);
+        if ((n >= 4 && strcmp(cmd + n - 4, "_end") == 0) || (n >= 7 && strcmp(cmd + n - 7, "_finish") == 0)) {
+            reply.playState = Finished;
+            return;
+        }
+    }
+    const char* st = msg.Get("play_status");
+    if (!st && cmd && strstr(cmd, "play")) st = msg.Get("status");
+    if (!st) return;
+
+    if (!strcmp(st, "play") || !strcmp(st, "playing") || !strcmp(st, "1")) {
+        reply.playState = Playing;
+    }
+    else if (!strcmp(st, "stop") || !strcmp(st, "stopped") || !strcmp(st, "idle") || !strcmp(st, "0")) {
+        reply.playState = Stopped;
+    }
+    else if (!strcmp(st, "end") || !strcmp(st, "finish") || !strcmp(st, "finished") || !strcmp(st, "over")) {
+        reply.playState = Finished;
+    }
+    else if (!strcmp(st, "error")) {
+        reply.playState = Error;
     }
 }
 
+void Sound_NetSpeaker_V2::OnReply(const SpeakerReply& reply) 
+{
+    if (reply.cseq > 0) {
+        for (int i = 0; i < MAX_PENDING; ++i) {
+            PendingCmd& pc = m_pending[i];
+            if (pc.cseq != reply.cseq) continue;
+
+            TimerService::instance().cancel(pc.timer);
+            CmdKind kind = pc.kind;
+            pc.cseq = 0;
+
+            if (reply.result != 0) {
+                LOG_WARNING("[Slot %d] Sound command %s (cseq %d) failed: %d",
+                    m_slotID, reply.command, reply.cseq, reply.result);
+                if (kind == CMD_PLAY) SetPlayState(Error);
+            }
+            else if (kind == CMD_PLAY) {
+                SetPlayState(Playing);
+            }
+            else if (kind == CMD_STOP) {
+                SetPlayState(Stopped);
+            }
+            break;
+        }
+        // 未匹配的应答 (已超时或被淘汰) 忽略
+    }
+
+    if (reply.playState >= 0) {
+        SetPlayState((SoundPlayState)reply.playState);
+    }
+}
+
+void Sound_NetSpeaker_V2::OnCommandTimeout(int cseq) 
+{
+    for (int i = 0; i < MAX_PENDING; ++i) {
+        PendingCmd& pc = m_pending[i];
+        if (pc.cseq != cseq) continue;
+
+        LOG_WARNING("[Slot %d] Sound command timeout (cseq %d)", m_slotID, cseq);
+        pc.cseq = 0;
+        if (pc.kind == CMD_PLAY) SetPlayState(Error);
+        return;
+    }
+}
+
+void Sound_NetSpeaker_V2::ClearPending() 
+{
+    for (int i = 0; i < MAX_PENDING; ++i) {
+        if (m_pending[i].cseq != 0) {
+            TimerService::instance().cancel(m_pending[i].timer);
+            m_pending[i].cseq = 0;
+        }
+    }
+}
+
+void Sound_NetSpeaker_V2::SetPlayState(SoundPlayState state) 
+{
+    if (m_playStateKnown && m_playState == state) return;
+    m_playState = state;
+    m_playStateKnown = true;
+
+    if (m_playStateCb) m_playStateCb(state);
+
+    if (state == Finished) {
+        auto pkt = std::make_shared<rpc::OwSoundPlayEnd>(rpc::NoneData());
+        if (m_statusCb) m_statusCb(pkt);
+    }
+}
+
+int Sound_NetSpeaker_V2::ReadRaw(u8* buf, u32 maxLen) 
+{
+    if (!m_socket || !m_socket->isOpen()) {
+        m_parser.Reset(); // 连接断开，丢弃残留的半条消息
+        return -1;
+    }
+    try {
+        return m_socket->read(buf, maxLen);
+    }
+    catch (ETimeout&) {
+        return 0; // 读超时，保留半条消息
+    }
+    catch (...) {
+        m_parser.Reset();
+        return -1;
+    }
+}
+
+void Sound_NetSpeaker_V2::OnRawDataReceived(const u8* data, u32 len) 
+{
+    // 应答以 "\r\n\r\n" 分隔，可能被拆分或粘连
+    m_parser.Feed(data, len);
+}
+
 bool Sound_NetSpeaker_V2::Connect() 
 {
     if (IsOnline() && m_socket && m_socket->isOpen()) return true;
 
+    // 旧连接上的指令不会再有应答；读取线程已停止，可直接清空半条消息
+    ClearPending();
+    m_parser.Reset();
+
+    // 出错状态需先回到离线才能重连
+    if (GetState() == STATE_ERROR) SetState(STATE_OFFLINE);
+
     try {
         SetState(STATE_CONNECTING);
         m_socket = std::make_shared<TcpSocket>(m_ip, m_port);
-        m_socket->setConnTimeout(1000); // 1볬ʱ
+        m_socket->setConnTimeout(1000); // 1秒超时
+        m_socket->setRecvTimeout(200);
         m_socket->open();
         SetState(STATE_ONLINE);
         return true;
@@ -185,7 +415,7 @@ bool Sound_NetSpeaker_V2::Connect()
     }
 }
 
-// ̷߳
+// 独立的线程发送心跳
 void Sound_NetSpeaker_V2::HeartbeatLoop() 
 {
     int counter = 0;
@@ -193,7 +423,7 @@ void Sound_NetSpeaker_V2::HeartbeatLoop()
         msleep(100);
         counter++;
 
-        if (counter >= 300) { // 30
+        if (counter >= 300) { // 30秒
             counter = 0;
             if (IsOnline()) {
                 postEvent(new Event(EVENT_HEARTBEAT));
@@ -202,27 +432,119 @@ void Sound_NetSpeaker_V2::HeartbeatLoop()
     }
 }
 
-// ߳д¼
+// 在主线程中处理事件
 void Sound_NetSpeaker_V2::OnCustomEvent(Event_Ptr& e)
 {
-    // жǷ¼
+    // 判断是否是心跳事件
     if (e->eId() == EVENT_HEARTBEAT) 
     {
-        SendJsonCmd(BuildJson("online"));
+        BeginCommand("online");
+        SendCommand(CMD_GENERIC);
         // LOG_DEBUG("Heartbeat sent via main thread.");
     }
+    else if (e->eId() == DeviceEventID::SpeakerReply)
+    {
+        auto re = std::dynamic_pointer_cast<SpeakerReplyEvent>(e);
+        if (re) OnReply(re->Dat);
+    }
+    else if (e->eId() == DeviceEventID::SpeakerTimeout)
+    {
+        auto te = std::dynamic_pointer_cast<SpeakerTimeoutEvent>(e);
+        if (te) OnCommandTimeout(te->Dat);
+    }
 }
 
 void Sound_NetSpeaker_V2::PushAudio(const u8* data, u32 len)
 {
-    if (m_audioBuf) {
-        m_audioBuf->Write(data, len);
+    if (m_micSource) {
+        m_micSource->Write(data, len);
+    }
+}
+
+// --- SDK 侧混音 ---
+
+int Sound_NetSpeaker_V2::AddMixSource(u8 priority, float gain)
+{
+    if (!m_mixer) return -1;
+
+    StreamSource_Ptr src = std::make_shared<StreamSource>(AUDIO_SOURCE_BUF, m_mixer->FrameSamples());
+    src->SetStats(&m_stats);
+    int id = m_mixer->AddSource(src, priority, gain);
+    if (id < 0) {
+        LOG_WARNING("[Slot %d] AddMixSource: too many sources", m_slotID);
+    }
+    return id;
+}
+
+bool Sound_NetSpeaker_V2::RemoveMixSource(int sourceId)
+{
+    // 喊话源由驱动自身管理，不允许移除
+    if (!m_mixer || m_mixer->GetSource(sourceId) == m_micSource) return false;
+    return m_mixer->RemoveSource(sourceId);
+}
+
+bool Sound_NetSpeaker_V2::PushMixSource(int sourceId, const u8* data, u32 len)
+{
+    if (!m_mixer) return false;
+
+    StreamSource_Ptr src = std::dynamic_pointer_cast<StreamSource>(m_mixer->GetSource(sourceId));
+    if (!src) return false;
+
+    src->Write(data, len);
+    return true;
+}
+
+bool Sound_NetSpeaker_V2::SetMixSourceGain(int sourceId, float gain)
+{
+    if (!m_mixer) return false;
+    return m_mixer->SetGain(sourceId, gain);
+}
+
+bool Sound_NetSpeaker_V2::SetInputFormat(int sourceId, u32 sampleRate, u32 channels)
+{
+    if (!m_mixer || sampleRate == 0 || channels == 0) return false;
+
+    StreamSource_Ptr src = (sourceId < 0) ? m_micSource
+        : std::dynamic_pointer_cast<StreamSource>(m_mixer->GetSource(sourceId));
+    if (!src) return false;
+
+    // 统一转换到设备格式，减少发送带宽
+    src->SetInputFormat(sampleRate, channels, m_audioRate, m_audioChannels);
+    LOG_INFO("[Slot %d] Audio input format: %uHz/%uch -> %uHz/%uch", m_slotID,
+        sampleRate, channels, m_audioRate, m_audioChannels);
+    return true;
+}
+
+int Sound_NetSpeaker_V2::StreamFile(const char* path, bool loop)
+{
+    if (!m_mixer || !path) return -1;
+
+    AudioSource_Ptr src;
+    try {
+        src = std::make_shared<WavFileSource>(path, loop, m_audioRate, m_audioChannels);
+    }
+    catch (std::exception& e) {
+        LOG_ERROR("[Slot %d] StreamFile: %s", m_slotID, e.what());
+        return -1;
+    }
+
+    int id = m_mixer->AddSource(src, (u8)GetPropValue<int>("StreamPriority"), 1.0f);
+    if (id < 0) {
+        LOG_WARNING("[Slot %d] StreamFile: too many sources", m_slotID);
+        return -1;
     }
+
+    // 推流依赖喊话 (mic_broadcast) 模式，交给设备线程切换
+    if (!m_isMicOpen) {
+        ExecutePacket(std::make_shared<rpc::RqSoundMic>(true));
+    }
+
+    LOG_INFO("[Slot %d] StreamFile: %s (source %d)", m_slotID, path, id);
+    return id;
 }
 
 void Sound_NetSpeaker_V2::AudioTxLoop() {
-    u8 buf[1024]; // ÿη 1KB UDP 
-    UdpSocket udpSock(m_ip, 9888); // ר socket
+    UdpSocket udpSock(m_ip, 9888); // 发送专用 socket
     try {
         udpSock.open();
     }
@@ -231,25 +553,156 @@ void Sound_NetSpeaker_V2::AudioTxLoop() {
         return;
     }
 
+    const u32 frameSamples = m_mixer->FrameSamples();
+    BufferPool::Lease frameBuf = BufferPool::Instance().Acquire(frameSamples * sizeof(i16));
+    i16* frame = (i16*)frameBuf.Data();
+
+    // 静音抑制 (可选)
+    const str vadStr = GetProperty("VadEnable");
+    const bool vadEnable = (vadStr == "true" || vadStr == "1");
+    AudioVad vad;
+    vad.Configure((float)GetPropValue<int>("VadThreshold"),
+        (u32)GetPropValue<int>("VadHangover") / AUDIO_FRAME_MS,
+        (u32)GetPropValue<int>("VadKeepalive") / AUDIO_FRAME_MS);
+
+    // 按固定帧周期混音发送，避免突发发包导致设备端缓冲溢出
+    const std::chrono::milliseconds period(AUDIO_FRAME_MS);
+    std::chrono::steady_clock::time_point next = std::chrono::steady_clock::now();
 
     while (m_keepHeartbeat) {
         if (!m_isMicOpen) {
             msleep(100); 
+            next = std::chrono::steady_clock::now();
+            vad.Reset();
             continue; 
         }
 
-        int len = m_audioBuf->Read(buf, 1024);
-        if (len > 0) {
-            try {
-                // [ؼ] Ƶ
-                udpSock.write(buf, len);
-            }
-            catch (...) {
-                // UDP ʧͨԣ֤
-            }
+        next += period;
+        std::chrono::steady_clock::time_point now = std::chrono::steady_clock::now();
+        if (next + period * 5 < now) {
+            next = now; // 落后太多 (线程被挂起等)，重新对齐节拍
         }
         else {
-            msleep(10);
+            sleep_until(next);
+        }
+
+        // 全部源静默时不发包
+        int active = m_mixer->Mix(frame);
+        m_stats.SetFill((u32)m_micSource->Buffered());
+        if (active == 0) {
+            continue;
+        }
+
+        // 讲话间隙的静音帧丢弃或降频发送，节省带宽与设备端缓冲
+        if (vadEnable && !vad.Process(frame, frameSamples, m_audioChannels)) {
+            m_stats.Add(m_stats.framesSuppressed);
+            continue;
+        }
+
+        try {
+            // [关键] 发送音频数据
+            udpSock.write((const u8*)frame, frameSamples * sizeof(i16));
+            m_stats.Add(m_stats.framesSent);
+        }
+        catch (...) {
+            // UDP 发送失败不重试，保证流畅性，只计数
+            m_stats.Add(m_stats.sendErrors);
+        }
+    }
+}
+
+// RTP (RFC 3550) 头解析，成功时 payload/len 指向负载
+static bool ParseRtp(const u8*& payload, u32& len, u16& seq)
+{
+    if (len < 12 || (payload[0] & 0xC0) != 0x80) return false;
+
+    u32 hdr = 12 + (payload[0] & 0x0F) * 4;    // CSRC
+    if (payload[0] & 0x10) {                    // 扩展头
+        if (len < hdr + 4) return false;
+        hdr += 4 + ((payload[hdr + 2] << 8) | payload[hdr + 3]) * 4;
+    }
+    if (payload[0] & 0x20) {                    // 填充
+        u8 pad = payload[len - 1];
+        if (pad >= len) return false;
+        len -= pad;
+    }
+    if (len <= hdr) return false;
+
+    seq = (u16)((payload[2] << 8) | payload[3]);
+    payload += hdr;
+    len -= hdr;
+    return true;
+}
+
+void Sound_NetSpeaker_V2::CaptureRxLoop()
+{
+    const int port = GetPropValue<int>("CapturePort");
+    const str rtpStr = GetProperty("CaptureRtp");
+    const bool isRtp = (rtpStr == "true" || rtpStr == "1");
+
+    UdpSocket udpSock(port);
+    try {
+        udpSock.open();
+        udpSock.setRecvTimeout(200); // 定期醒来检查退出标志
+        udpSock.setRecvBufSize(256 * 1024);
+    }
+    catch (std::exception& e) {
+        LOG_ERROR("[Slot %d] Capture UDP Open Failed (port %d): %s", m_slotID, port, e.what());
+        return;
+    }
+
+    // 接收缓冲、抖动缓冲、输出帧全部在此一次性分配
+    const u32 frameBytes = m_audioRate * AUDIO_FRAME_MS / 1000 * m_audioChannels * sizeof(i16);
+    const u32 depth = (u32)GetPropValue<int>("CaptureJitter") / AUDIO_FRAME_MS;
+    AudioJitterBuffer jitter(CAPTURE_SLOTS, CAPTURE_MAX_DATAGRAM, depth, frameBytes);
+
+    BufferPool::Lease pool = BufferPool::Instance().Acquire(CAPTURE_BATCH * CAPTURE_MAX_DATAGRAM);
+    u8* bufs[CAPTURE_BATCH];
+    u32 lens[CAPTURE_BATCH];
+
+    // 回调在锁外调用: 回调中可再次 SetCaptureCallback，慢回调也不阻塞更换
+    AudioJitterBuffer::FrameCallback deliver = [this](const u8* data, u32 len) {
+        AudioCallback_Ptr cb;
+        {
+            std::lock_guard<std::mutex> lock(m_audioCbMutex);
+            cb = m_audioCb;
+        }
+        if (cb) (*cb)(data, len);
+    };
+
+    LOG_INFO("[Slot %d] Capture listening on UDP %d (%s, jitter %u pkts)", m_slotID, port,
+        isRtp ? "RTP" : "raw", depth);
+
+    u16 localSeq = 0;
+    while (m_keepHeartbeat) {
+        for (int i = 0; i < CAPTURE_BATCH; ++i) {
+            bufs[i] = pool.Data() + i * CAPTURE_MAX_DATAGRAM;
+            lens[i] = CAPTURE_MAX_DATAGRAM;
+        }
+
+        int n = 0;
+        try {
+            n = udpSock.readBatch(bufs, lens, CAPTURE_BATCH);
+        }
+        catch (ETimeout&) {
+            continue;
+        }
+        catch (std::exception& e) {
+            LOG_ERROR("[Slot %d] Capture Recv Error: %s", m_slotID, e.what());
+            msleep(100);
+            continue;
+        }
+
+        for (int i = 0; i < n; ++i) {
+            const u8* payload = bufs[i];
+            u32 len = lens[i];
+            u16 seq = localSeq;
+            if (isRtp && !ParseRtp(payload, len, seq)) {
+                continue;
+            }
+            localSeq = seq + 1; // 无 RTP 头时按到达顺序编号
+
+            jitter.Push(seq, payload, len, deliver);
         }
     }
 }
@@ -2,7 +2,13 @@
 #include "../ISound_Device.h"
 #include "net/TCPSocket.h"
 #include "net/UDPSocket.h"
-#include "utils/ring_buffer.h"
+#include "../AudioMixer.h"
+#include "../AudioVad.h"
+#include "../WavFileSource.h"
+#include "../AudioJitterBuffer.h"
+#include "protocol/JsonWriter.h"
+#include "protocol/JsonStreamParser.h"
+#include "thread/timer_service.h"
 #include <atomic>
 #include <thread>
 
@@ -12,10 +18,10 @@ class Sound_NetSpeaker_V2 : public ISound_Device
 {
 public:
     using Self = Sound_NetSpeaker_V2;
-    //  ID: Sound + NetSpeaker_V2
+    // 定义 ID: Sound + NetSpeaker_V2
     static const u32 ID = MAKE_DEV_OID(did::DEVICE_SOUND, did::SOUND_NETSPEAKER_V2);
 
-    // עṤ
+    // 注册工厂
     FACTORY_ID_CHILD_WITH_SPEC_NAME(u32, ID, DeviceBase, Self, "NetSpeaker-V2")
 
     Sound_NetSpeaker_V2();
@@ -26,7 +32,7 @@ public:
     virtual void Stop() override;
 
 public:
-    // --- ʵ ISound_Device ӿ ---
+    // --- 实现 ISound_Device 纯虚接口 ---
     virtual void PlayFile(const char* filename, bool loop) override;
     virtual void StopPlay() override;
     virtual void TTSPlay(const char* text) override;
@@ -39,34 +45,94 @@ public:
 
     virtual void PushAudio(const u8* data, u32 len) override; 
 
+    // --- SDK 侧混音 ---
+    virtual int  AddMixSource(u8 priority, float gain) override;
+    virtual bool RemoveMixSource(int sourceId) override;
+    virtual bool PushMixSource(int sourceId, const u8* data, u32 len) override;
+    virtual bool SetMixSourceGain(int sourceId, float gain) override;
+    virtual bool SetInputFormat(int sourceId, u32 sampleRate, u32 channels) override;
+    virtual int  StreamFile(const char* path, bool loop) override;
+    virtual const AudioStats* GetAudioStats() const override { return &m_stats; }
+
+protected:
+    virtual void OnRegisterProperties() override;
+
+    // 实现基类的 IO 接口 (读取线程接收应答)
+    virtual int ReadRaw(u8* buf, u32 maxLen) override;
+    virtual void OnRawDataReceived(const u8* data, u32 len) override;
+
 private:
-    void SendJsonCmd(const str& json);
-    str BuildJson(const char* cmd, const char* params = "");
+    // 指令类别 (决定应答对应的播放状态)
+    enum CmdKind { CMD_GENERIC, CMD_PLAY, CMD_STOP };
+
+    // 组包: BeginCommand 写入 command/cseq，调用方追加参数后 SendCommand
+    JsonWriter& BeginCommand(const char* cmd);
+    bool SendCommand(CmdKind kind);
+
+    // 应答匹配 (设备线程)
+    void OnReply(const SpeakerReply& reply);
+    void OnCommandTimeout(int cseq);
+    void ClearPending();
+    void SetPlayState(SoundPlayState state);
 
-    // ӹ
+    // 从应答中提取字段 (读取线程)
+    static void ExtractReply(const JsonMessage& msg, SpeakerReply& reply);
+
+    // 连接管理
     bool Connect();
 
-    // ̺߳
+    // 心跳线程函数
     void HeartbeatLoop();
 
-    // ڲʹõ¼ID
+    // 定义内部使用的心跳事件ID
     static const int EVENT_HEARTBEAT = EventTypes::User + 100;
     void AudioTxLoop(); 
 
+    // 每帧时长 (ms)，发送线程按此节拍混音发包
+    static const int AUDIO_FRAME_MS = 20;
+    // 每路推流源的缓存大小
+    static const size_t AUDIO_SOURCE_BUF = 1024 * 100;
+
+    // 采集 (设备麦克风 -> SDK) 接收线程
+    void CaptureRxLoop();
+    static const int CAPTURE_BATCH = 16;            // 单次 recvmmsg 报文数
+    static const u32 CAPTURE_MAX_DATAGRAM = 1500;
+    static const u32 CAPTURE_SLOTS = 64;            // 重排窗口 (报文数)
+
 private:
     str m_ip;
     int m_port;
     TcpSocket_Ptr m_socket;
 
-    // Э
-    int m_cseq; // к
-
-    // ר
+    // 协议相关
+    int m_cseq; // 自增序列号
+    JsonWriter m_writer;            // 只在设备线程中使用
+    JsonStreamParser m_parser;      // 只在读取线程中使用
+
+    // 等待应答的指令 (cseq = 0 表示空闲)
+    struct PendingCmd {
+        int cseq;
+        CmdKind kind;
+        TimerService::TimerId timer;
+    };
+    static const int MAX_PENDING = 16;
+    PendingCmd m_pending[MAX_PENDING];
+    u32 m_cmdTimeoutMs;
+
+    SoundPlayState m_playState;
+    bool m_playStateKnown;
+
+    // 心跳专用
     std::thread* m_heartbeatThread;
     std::atomic<bool> m_keepHeartbeat;
 
-    RingBuffer* m_audioBuf;
+    u32 m_audioRate;                // 设备侧 PCM 格式 (发送格式)
+    u32 m_audioChannels;
+    AudioMixer* m_mixer;
+    StreamSource_Ptr m_micSource;   // PushAudio 对应的喊话源
+    AudioStats m_stats;
     std::thread* m_audioThread;
+    std::thread* m_captureThread;
     bool m_isMicOpen;
 };
 
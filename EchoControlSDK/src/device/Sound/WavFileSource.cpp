@@ -0,0 +1,148 @@
+#include "WavFileSource.h"
+#include "../../debug/Exceptions.h"
+#include <string.h>
+
+ECCS_BEGIN
+
+// 格式转换时每次从文件读取的帧数
+static const u32 CONV_CHUNK_FRAMES = 1024;
+
+static const u16 WAVE_FORMAT_PCM        = 0x0001;
+static const u16 WAVE_FORMAT_EXTENSIBLE = 0xFFFE;
+
+static inline u16 ReadLE16(const u8* p) { return (u16)(p[0] | (p[1] << 8)); }
+static inline u32 ReadLE32(const u8* p) { return (u32)p[0] | ((u32)p[1] << 8) | ((u32)p[2] << 16) | ((u32)p[3] << 24); }
+
+
+WavFileSource::WavFileSource(const char* path, bool loop, u32 outRate, u32 outChannels)
+    : m_file(path), m_loop(loop), m_rate(0), m_channels(0),
+      m_pcm(NULL), m_total(0), m_pos(0), m_convPos(0)
+{
+    ParseHeader(path);
+
+    AudioResampler* conv = new AudioResampler(m_rate, m_channels, outRate, outChannels);
+    if (conv->IsPassthrough()) {
+        delete conv;
+    }
+    else {
+        m_conv.reset(conv);
+    }
+}
+
+void WavFileSource::ParseHeader(const char* path)
+{
+    const u8* p = m_file.data();
+    size_t size = m_file.size();
+
+    if (size < 12 || memcmp(p, "RIFF", 4) != 0 || memcmp(p + 8, "WAVE", 4) != 0) {
+        throw EIOException("%s: not a WAV file", path);
+    }
+
+    u16 format = 0, bits = 0, blockAlign = 0;
+    bool hasFmt = false;
+    size_t off = 12;
+    while (off + 8 <= size) {
+        const u8* chunk = p + off;
+        u32 len = ReadLE32(chunk + 4);
+        off += 8;
+
+        if (memcmp(chunk, "fmt ", 4) == 0 && len >= 16 && off + len <= size) {
+            format     = ReadLE16(p + off);
+            m_channels = ReadLE16(p + off + 2);
+            m_rate     = ReadLE32(p + off + 4);
+            blockAlign = ReadLE16(p + off + 12);
+            bits       = ReadLE16(p + off + 14);
+            // 扩展格式: SubFormat GUID 的前两字节为实际格式
+            if (format == WAVE_FORMAT_EXTENSIBLE && len >= 40) {
+                format = ReadLE16(p + off + 24);
+            }
+            hasFmt = true;
+        }
+        else if (memcmp(chunk, "data", 4) == 0) {
+            if (!hasFmt || blockAlign == 0) break;
+            // 流式写出的文件 data 长度可能未回填，按文件实际大小截断
+            size_t dataLen = (len > size - off) ? size - off : len;
+            m_pcm = (const i16*)(p + off);
+            m_total = (u32)(dataLen / blockAlign * m_channels);
+            break;
+        }
+
+        off += len + (len & 1);  // 块按偶数字节对齐
+    }
+
+    if (!hasFmt || !m_pcm) {
+        throw EIOException("%s: missing fmt/data chunk", path);
+    }
+    if (format != WAVE_FORMAT_PCM || bits != 16 || m_channels == 0 || m_rate == 0
+        || blockAlign != m_channels * 2) {
+        throw EIOException("%s: unsupported WAV format (fmt=%u, bits=%u), need 16bit PCM",
+            path, format, bits);
+    }
+}
+
+u32 WavFileSource::FetchRaw(const i16*& data, u32 count)
+{
+    if (m_total == 0) return 0;
+
+    if (m_pos >= m_total) {
+        if (!m_loop) return 0;
+        m_pos = 0;
+    }
+
+    u32 avail = m_total - m_pos;
+    if (avail >= count || !m_loop) {
+        u32 n = (avail < count) ? avail : count;
+        data = m_pcm + m_pos;
+        m_pos += n;
+        return n;
+    }
+
+    // 循环衔接: 尾部 + 头部拼成完整一段，避免循环点出现空隙
+    m_splice.resize(count);
+    u32 filled = 0;
+    while (filled < count) {
+        u32 n = m_total - m_pos;
+        if (n > count - filled) n = count - filled;
+        memcpy(&m_splice[filled], m_pcm + m_pos, n * sizeof(i16));
+        filled += n;
+        m_pos += n;
+        if (m_pos >= m_total) m_pos = 0;
+    }
+    data = m_splice.data();
+    return count;
+}
+
+u32 WavFileSource::Fetch(const i16*& data, u32 count)
+{
+    if (!m_conv) {
+        return FetchRaw(data, count);
+    }
+
+    while (m_convBuf.size() - m_convPos < count) {
+        const i16* raw = NULL;
+        u32 n = FetchRaw(raw, CONV_CHUNK_FRAMES * m_channels);
+        if (n == 0) break;
+
+        if (m_convPos > 0) {
+            m_convBuf.erase(m_convBuf.begin(), m_convBuf.begin() + m_convPos);
+            m_convPos = 0;
+        }
+        m_conv->Process(raw, n / m_channels, m_convBuf);
+    }
+
+    size_t avail = m_convBuf.size() - m_convPos;
+    u32 n = (u32)((avail < count) ? avail : count);
+    if (n == 0) return 0;
+
+    data = &m_convBuf[m_convPos];
+    m_convPos += n;
+    return n;
+}
+
+bool WavFileSource::IsFinished() const
+{
+    return !m_loop && m_pos >= m_total && m_convPos >= m_convBuf.size();
+}
+
+
+ECCS_END
@@ -0,0 +1,50 @@
+#pragma once
+#include "AudioMixer.h"
+#include "../../utils/mapped_file.h"
+
+ECCS_BEGIN
+
+//------------------------------------------------------
+// WavFileSource: 本地 WAV 文件混音源
+// * 文件以只读方式内存映射，格式与设备一致时 Fetch 直接返回映射内的指针
+// * 格式不同时经 AudioResampler 分块转换 (仅占用一小段转换缓存)
+// * 目前只支持 16bit PCM
+//------------------------------------------------------
+
+class WavFileSource : public AudioSource
+{
+public:
+    // 打开失败或格式不支持时抛出 EIOException
+    WavFileSource(const char* path, bool loop, u32 outRate, u32 outChannels);
+
+    virtual u32 Fetch(const i16*& data, u32 count) override;
+    virtual bool IsFinished() const override;
+
+    u32 SampleRate() const { return m_rate; }
+    u32 Channels() const { return m_channels; }
+
+private:
+    void ParseHeader(const char* path);
+    // 从映射区取原始采样，循环播放的首尾衔接处拷贝到 m_splice
+    u32 FetchRaw(const i16*& data, u32 count);
+
+private:
+    MappedFile m_file;
+    bool       m_loop;
+
+    u32        m_rate;
+    u32        m_channels;
+    const i16* m_pcm;       // data 块起始
+    u32        m_total;     // 采样总数 (含所有声道)
+    u32        m_pos;       // 下一个待取采样
+
+    std::vector<i16> m_splice;
+
+    // 格式转换
+    std::unique_ptr<AudioResampler> m_conv;
+    std::vector<i16> m_convBuf;
+    size_t           m_convPos;
+};
+
+
+ECCS_END
@@ -6,14 +6,30 @@ ECCS_BEGIN
 class IUltrasonic_Device : public DeviceBase
 {
 public:
-    // === ӿڣɾʵ ===
+    // === 纯虚接口：由具体驱动实现 ===
 
     /**
-     * @brief ÿ״̬
-     * @param channel ͨ (1=1·, 2=2·...)
-     * @param isOpen  true=, false=
+     * @brief 设置开关状态
+     * @param channel 通道号 (1=第1路, 2=第2路...)
+     * @param isOpen  true=开, false=关
      */
     virtual void SetSwitch(u8 channel, bool isOpen) = 0;
+
+    /**
+     * @brief 按位掩码设置全部通道
+     * @param mask bit0=第1路, bit1=第2路... (1=开, 0=关)
+     */
+    virtual void SetMask(u32 mask) {
+        LOG_WARNING("[Slot %d] Device (Model: %s) does not support SetMask.",
+            m_slotID, GetProperty("Model").c_str());
+    }
+
+    /**
+     * @brief 读取设备确认的通道状态 (可在任意线程调用)
+     * @param mask 输出通道状态 (bit0=第1路, 1=开)
+     * @return 状态已知的通道掩码，0 表示尚无数据
+     */
+    virtual u32 GetSwitchState(u32& mask) const { mask = 0; return 0; }
 };
 
 ECCS_END
\ No newline at end of file
@@ -1,91 +1,476 @@
 #include "Ultrasonic_TAS_IO_428R2.h"
 #include "../../../debug/Exceptions.h"
 #include "../../../debug/Logger.h"
+#include <string.h>
 
 ECCS_BEGIN
 
-Ultrasonic_TAS_IO_428R2::Ultrasonic_TAS_IO_428R2() {
+// UnitID 固定为 0x11 (参考旧代码)
+static const u8 UNIT_ID = 0x11;
+
+// Modbus 功能码
+static const u8 FC_READ_COILS = 0x01;
+static const u8 FC_WRITE_COIL = 0x05;
+static const u8 FC_WRITE_COILS = 0x0F;
+
+// 连续超时次数达到后断开重连
+static const u32 MAX_TIMEOUTS = 3;
+
+Ultrasonic_TAS_IO_428R2::Ultrasonic_TAS_IO_428R2()
+    : m_port(0), m_channels(8), m_coils(0), m_known(0), m_state(0),
+      m_rtu(false), m_nextSeq(1), m_maxInFlight(4), m_timeoutMs(1000), m_timeouts(0),
+      m_pollMs(1000), m_pollGen(0), m_pollBusy(false), m_pollTimer(TimerService::INVALID_TIMER) {
+    memset(m_lastWrite, 0, sizeof(m_lastWrite));
+
+    // 读取线程分帧后转交设备线程做事务匹配
+    m_parser.SetHandler([this](u16 tid, u8 unit, u8 func, const u8* data, u32 len) {
+        ModbusResponse rsp;
+        rsp.tid = tid;
+        rsp.unit = unit;
+        rsp.func = func;
+        rsp.len = (u8)((len < sizeof(rsp.data)) ? len : sizeof(rsp.data));
+        memcpy(rsp.data, data, rsp.len);
+        postEvent(new ModbusResponseEvent(rsp));
+    });
 }
 
 Ultrasonic_TAS_IO_428R2::~Ultrasonic_TAS_IO_428R2() {
+    CancelPollTimer();
+    FailAll();
     if (m_socket) m_socket->close();
 }
 
 bool Ultrasonic_TAS_IO_428R2::Init(int slotID, const std::map<str, str>& config) {
-    // 1. ʼ
+    // 1. 基类初始化
     if (!DeviceBase::Init(slotID, config)) return false;
 
-    // 2. ȡ
+    // 2. 获取配置
     m_ip = GetPropValue<str>("IP");
     m_port = GetPropValue<int>("Port");
 
-    // Ĭ϶˿ 10123 (οľɴ)
+    // 默认端口 10123 (参考你的旧代码)
     if (m_port == 0) m_port = 10123;
 
+    m_channels = GetPropValue<int>("Channels");
+    if (m_channels < 1) m_channels = 1;
+    if (m_channels > 32) m_channels = 32;
+
+    str framing = GetPropValue<str>("Framing");
+    m_rtu = (framing == "RTU" || framing == "rtu");
+    m_parser.SetFraming(m_rtu ? ModbusTcpParser::FRAMING_RTU : ModbusTcpParser::FRAMING_TCP);
+
+    int inFlight = GetPropValue<int>("MaxInFlight");
+    m_maxInFlight = (inFlight < 1 || m_rtu) ? 1 : (u32)inFlight;
+    int timeout = GetPropValue<int>("Timeout");
+    m_timeoutMs = (timeout < 50) ? 50 : (u32)timeout;
+    int poll = GetPropValue<int>("PollInterval");
+    m_pollMs = (poll < 0) ? 0 : (u32)poll;
+
+    return true;
+}
+
+void Ultrasonic_TAS_IO_428R2::OnRegisterProperties() {
+    IUltrasonic_Device::OnRegisterProperties();
+
+    RegisterProp<int>("Channels", 8, "Switch Channel Count (1-32)");
+    RegisterProp<str>("Framing", "TCP", "Modbus Framing: TCP (MBAP) / RTU (RTU over TCP, CRC16)");
+    RegisterProp<int>("MaxInFlight", 4, "Max Outstanding Modbus Requests (RTU: always 1)");
+    RegisterProp<int>("Timeout", 1000, "Modbus Response Timeout (ms)");
+    RegisterProp<int>("PollInterval", 1000, "Coil State Read-back Interval (ms, 0=Off)");
+}
+
+bool Ultrasonic_TAS_IO_428R2::Start() {
+    if (!Connect()) {
+        LOG_WARNING("[Slot %d] Start: Connect failed, will retry on poll.", m_slotID);
+    }
+
+    if (!IUltrasonic_Device::Start()) return false;
+
+    ArmPollTimer();
     return true;
 }
 
+void Ultrasonic_TAS_IO_428R2::Stop() {
+    CancelPollTimer();
+    IUltrasonic_Device::Stop();
+
+    // 设备线程已退出，直接结束所有未完成的请求
+    FailAll();
+}
+
+u32 Ultrasonic_TAS_IO_428R2::GetSwitchState(u32& mask) const {
+    u64 v = m_state.load(std::memory_order_acquire);
+    u32 known = (u32)(v >> 32);
+    mask = (u32)v & known;
+    return known;
+}
+
 void Ultrasonic_TAS_IO_428R2::SetSwitch(u8 channel, bool isOpen) {
-    // Channel 1 -> Address 0x0000
-    // Channel 2 -> Address 0x0001
-    // ...
-    u16 addr = (channel > 0) ? (channel - 1) : 0;
+    // 0 = 所有通道，合并为一帧
+    if (channel == 0) {
+        SetMask(isOpen ? AllChannels() : 0);
+        return;
+    }
+    if (channel > m_channels) {
+        LOG_WARNING("[Slot %d] Ultrasonic channel %d out of range (1-%d)", m_slotID, channel, m_channels);
+        return;
+    }
+
+    u32 bit = 1u << (channel - 1);
+    WriteCoils(isOpen ? bit : 0, bit);
+}
 
-    // UnitID ̶Ϊ 0x11 (οɴ)
-    SendModbusCmd(0x11, addr, isOpen);
+void Ultrasonic_TAS_IO_428R2::SetMask(u32 mask) {
+    WriteCoils(mask, AllChannels());
 }
 
-void Ultrasonic_TAS_IO_428R2::SendModbusCmd(u8 unitId, u16 addr, bool on) {
+void Ultrasonic_TAS_IO_428R2::WriteCoils(u32 mask, u32 select) {
     if (!Connect()) return;
 
-    // Modbus-TCP Ľṹ (12ֽ)
-    u8 buf[12];
+    // 只写状态变化或未知的通道
+    u32 pending = select & ((mask ^ m_coils) | ~m_known);
+    u32 target = (m_coils & ~select) | (mask & select);
 
-    // 1. Transaction ID (2 bytes) - ʶͨ0
-    buf[0] = 0x00;
-    buf[1] = 0x00;
+    while (pending && IsOnline()) {
+        // 找出一段连续区间: 中间夹着的未变化通道只要状态已知，就按缓存值一并写入，
+        // 以减少帧数; 遇到状态未知的间隔则断开，避免覆盖未知通道
+        int first = 0;
+        while (!(pending & (1u << first))) ++first;
+        int last = first;
+        for (int ch = first + 1; ch < m_channels; ++ch) {
+            u32 b = 1u << ch;
+            if (pending & b) last = ch;
+            else if (!(m_known & b)) break;
+        }
 
-    // 2. Protocol ID (2 bytes) - ModbusЭ̶Ϊ0
-    buf[2] = 0x00;
-    buf[3] = 0x00;
+        u32 span = ((last >= 31) ? 0xFFFFFFFFu : ((1u << (last + 1)) - 1)) & ~((1u << first) - 1);
 
-    // 3. Length (2 bytes) - ֽ = UnitID(1) + Func(1) + Data(4) = 6
-    buf[4] = 0x00;
-    buf[5] = 0x06;
+        // Channel 1 -> Address 0x0000, Channel 2 -> Address 0x0001 ...
+        ModbusRequest req;
+        req.func = (first == last) ? FC_WRITE_COIL : FC_WRITE_COILS;
+        req.addr = (u16)first;
+        req.count = (u16)(last - first + 1);
+        req.bits = target & span;
+        req.span = span;
 
-    // 4. Unit ID (1 byte) - վַ
-    buf[6] = unitId;
+        // 缓存按指令更新，后续写入据此比较；失败时由 FailRequest 清除已知标记
+        m_coils = (m_coils & ~span) | (target & span);
+        m_known |= span;
+        pending &= ~span;
 
-    // 5. Function Code (1 byte) - 05 Write Single Coil (дȦ)
-    buf[7] = 0x05;
+        Submit(req);
+    }
+}
 
-    // 6. Output Address (2 bytes) - Ĵַ
-    buf[8] = (addr >> 8) & 0xFF;
-    buf[9] = addr & 0xFF;
+// -----------------------------------------------------------
+// 事务管理
+// -----------------------------------------------------------
 
-    // 7. Output Value (2 bytes) - FF00=ON, 0000=OFF
-    buf[10] = on ? 0xFF : 0x00;
-    buf[11] = 0x00;
+void Ultrasonic_TAS_IO_428R2::Submit(ModbusRequest req) {
+    req.seq = m_nextSeq++;
+    req.timer = TimerService::INVALID_TIMER;
 
+    if (req.func != FC_READ_COILS) {
+        for (int ch = 0; ch < m_channels; ++ch) {
+            if (req.span & (1u << ch)) m_lastWrite[ch] = req.seq;
+        }
+    }
+
+    m_queue.push_back(req);
+    Pump();
+}
+
+void Ultrasonic_TAS_IO_428R2::Pump() {
+    while (!m_queue.empty() && m_inflight.size() < m_maxInFlight) {
+        ModbusRequest req = m_queue.front();
+        m_queue.pop_front();
+
+        if (!Transmit(req)) {
+            // 连接已断开，队列中的请求也无法送达
+            FailRequest(req);
+            FailAll();
+            return;
+        }
+    }
+}
+
+bool Ultrasonic_TAS_IO_428R2::Transmit(ModbusRequest& req) {
+    // PDU (功能码之后): Addr(2) + Value/Quantity(2) [+ ByteCount(1) + Coils(N)]
+    u8 pdu[5 + 4];
+    u32 len = 4;
+    pdu[0] = (req.addr >> 8) & 0xFF;
+    pdu[1] = req.addr & 0xFF;
+
+    if (req.func == FC_WRITE_COIL) {
+        // FF00=ON, 0000=OFF
+        pdu[2] = req.bits ? 0xFF : 0x00;
+        pdu[3] = 0x00;
+    }
+    else {
+        pdu[2] = (req.count >> 8) & 0xFF;
+        pdu[3] = req.count & 0xFF;
+    }
+
+    if (req.func == FC_WRITE_COILS) {
+        // 线圈值: 低位在前，首字节 bit0 对应起始地址
+        u8 byteCount = (u8)((req.count + 7) / 8);
+        u32 bits = req.bits >> req.addr;
+        pdu[4] = byteCount;
+        for (u8 i = 0; i < byteCount; ++i) {
+            pdu[5 + i] = (bits >> (i * 8)) & 0xFF;
+        }
+        len = 5 + byteCount;
+    }
+
+    u8 frame[ModbusTcpParser::MBAP_LEN + 1 + sizeof(pdu)];
+    u32 n = m_rtu ? ModbusTcpParser::EncodeRtu(frame, UNIT_ID, req.func, pdu, len)
+                  : ModbusTcpParser::Encode(frame, (u16)req.seq, UNIT_ID, req.func, pdu, len);
+    if (!SendFrame(frame, n)) return false;
+
+    u32 seq = req.seq;
+    req.timer = TimerService::instance().schedule(m_timeoutMs, [this, seq]() {
+        postEvent(new ModbusTimeoutEvent(seq));
+    });
+    m_inflight[(u16)req.seq] = req;
+    return true;
+}
+
+void Ultrasonic_TAS_IO_428R2::OnResponse(const ModbusResponse& rsp) {
+    // RTU 应答没有事务 ID，对应唯一的在途请求
+    auto it = m_rtu ? m_inflight.begin() : m_inflight.find(rsp.tid);
+    if (it == m_inflight.end()) {
+        // 已超时的请求迟到的应答
+        LOG_BIN_DEBUG("[Slot %d] Modbus: unmatched response (tid %d), dropped", m_slotID, rsp.tid);
+        return;
+    }
+
+    ModbusRequest req = it->second;
+    m_inflight.erase(it);
+    TimerService::instance().cancel(req.timer);
+    m_timeouts = 0;
+
+    if ((rsp.func & 0x7F) != req.func) {
+        LOG_WARNING("[Slot %d] Modbus: function mismatch (req 0x%02X, rsp 0x%02X)", m_slotID, req.func, rsp.func);
+        FailRequest(req);
+    }
+    else if (rsp.func & 0x80) {
+        LOG_WARNING("[Slot %d] Modbus exception: func 0x%02X, code %d",
+            m_slotID, req.func, (rsp.len > 0) ? rsp.data[0] : 0);
+        FailRequest(req);
+    }
+    else if (req.func == FC_READ_COILS) {
+        // 应答: ByteCount(1) + Coils(N)
+        u32 byteCount = (rsp.len > 0) ? rsp.data[0] : 0;
+        if (byteCount < (req.count + 7u) / 8 || rsp.len < 1 + byteCount) {
+            LOG_WARNING("[Slot %d] Modbus: malformed read coils response (%d bytes)", m_slotID, rsp.len);
+            FailRequest(req);
+        }
+        else {
+            u32 v = 0;
+            for (u32 i = 0; i < byteCount && i < 4; ++i) {
+                v |= (u32)rsp.data[1 + i] << (i * 8);
+            }
+            u32 bits = (v << req.addr) & req.span;
+
+            // 回读请求发出后又写过的通道以写入为准，不用旧值覆盖
+            u32 apply = 0;
+            for (int ch = 0; ch < m_channels; ++ch) {
+                u32 b = 1u << ch;
+                if ((req.span & b) && (i32)(m_lastWrite[ch] - req.seq) < 0) apply |= b;
+            }
+
+            u32 drift = (m_coils ^ bits) & apply & m_known;
+            if (drift) {
+                LOG_INFO("[Slot %d] Ultrasonic: coil state differs from cache (mask 0x%08X), resynced", m_slotID, drift);
+            }
+
+            m_coils = (m_coils & ~apply) | (bits & apply);
+            m_known |= apply;
+            UpdateState(apply, bits);
+            m_pollBusy = false;
+        }
+    }
+    else {
+        // 写线圈应答为请求回显，即写入成功
+        UpdateState(req.span, req.bits);
+    }
+
+    Pump();
+}
+
+void Ultrasonic_TAS_IO_428R2::OnTimeout(u32 seq) {
+    auto it = m_inflight.find((u16)seq);
+    if (it == m_inflight.end() || it->second.seq != seq) return; // 已应答
+
+    ModbusRequest req = it->second;
+    m_inflight.erase(it);
+
+    LOG_WARNING("[Slot %d] Modbus timeout: func 0x%02X, addr %d, count %d",
+        m_slotID, req.func, req.addr, req.count);
+    FailRequest(req);
+
+    if (++m_timeouts >= MAX_TIMEOUTS) {
+        LOG_ERROR("[Slot %d] Modbus: %d consecutive timeouts, reconnect", m_slotID, m_timeouts);
+        Disconnect();
+        return;
+    }
+    Pump();
+}
+
+void Ultrasonic_TAS_IO_428R2::FailRequest(const ModbusRequest& req) {
+    if (req.func == FC_READ_COILS) {
+        m_pollBusy = false;
+        return;
+    }
+
+    // 写入结果未知: 下次写入时重新下发，状态表等待回读确认
+    m_known &= ~req.span;
+    u64 v = m_state.load(std::memory_order_relaxed);
+    u32 known = (u32)(v >> 32) & ~req.span;
+    m_state.store(((u64)known << 32) | (u32)v, std::memory_order_release);
+}
+
+void Ultrasonic_TAS_IO_428R2::FailAll() {
+    for (auto& kv : m_inflight) {
+        TimerService::instance().cancel(kv.second.timer);
+        FailRequest(kv.second);
+    }
+    m_inflight.clear();
+
+    for (auto& req : m_queue) {
+        FailRequest(req);
+    }
+    m_queue.clear();
+}
+
+void Ultrasonic_TAS_IO_428R2::UpdateState(u32 span, u32 bits) {
+    // 只有设备线程写入，读-改-写无需 CAS
+    u64 v = m_state.load(std::memory_order_relaxed);
+    u32 known = (u32)(v >> 32) | span;
+    u32 state = ((u32)v & ~span) | (bits & span);
+    m_state.store(((u64)known << 32) | state, std::memory_order_release);
+}
+
+// -----------------------------------------------------------
+// 轮询回读
+// -----------------------------------------------------------
+
+void Ultrasonic_TAS_IO_428R2::PollCoils() {
+    // 上一次回读未完成时不叠加
+    if (m_pollBusy || !Connect()) return;
+
+    ModbusRequest req;
+    req.func = FC_READ_COILS;
+    req.addr = 0;
+    req.count = (u16)m_channels;
+    req.bits = 0;
+    req.span = AllChannels();
+
+    m_pollBusy = true;
+    Submit(req);
+}
+
+void Ultrasonic_TAS_IO_428R2::ArmPollTimer() {
+    CancelPollTimer();
+    if (m_pollMs == 0) return;
+
+    u32 gen = m_pollGen;
+    m_pollTimer = TimerService::instance().schedule(m_pollMs, [this, gen]() {
+        postEvent(new ModbusPollEvent(gen));
+    });
+}
+
+void Ultrasonic_TAS_IO_428R2::CancelPollTimer() {
+    if (m_pollTimer != TimerService::INVALID_TIMER) {
+        TimerService::instance().cancel(m_pollTimer);
+        m_pollTimer = TimerService::INVALID_TIMER;
+    }
+    ++m_pollGen;
+}
+
+void Ultrasonic_TAS_IO_428R2::OnCustomEvent(Event_Ptr& e) {
+    if (e->eId() == DeviceEventID::ModbusResponse) {
+        auto re = std::dynamic_pointer_cast<ModbusResponseEvent>(e);
+        if (re) OnResponse(re->Dat);
+        return;
+    }
+    if (e->eId() == DeviceEventID::ModbusTimeout) {
+        auto te = std::dynamic_pointer_cast<ModbusTimeoutEvent>(e);
+        if (te) OnTimeout(te->Dat);
+        return;
+    }
+    if (e->eId() == DeviceEventID::ModbusPoll) {
+        auto pe = std::dynamic_pointer_cast<ModbusPollEvent>(e);
+        if (pe && pe->Dat == m_pollGen) {
+            m_pollTimer = TimerService::INVALID_TIMER; // 已触发，无需取消
+            PollCoils();
+            ArmPollTimer();
+        }
+        return;
+    }
+    IUltrasonic_Device::OnCustomEvent(e);
+}
+
+// -----------------------------------------------------------
+// IO
+// -----------------------------------------------------------
+
+int Ultrasonic_TAS_IO_428R2::ReadRaw(u8* buf, u32 maxLen) {
+    if (!m_socket || !m_socket->isOpen()) {
+        m_parser.Reset(); // 连接断开，丢弃残留的半帧
+        return -1;
+    }
     try {
-        m_socket->write(buf, 12);
-        // LOG_DEBUG("[Slot %d] Ultrasonic Set: Ch %d -> %d", m_slotID, addr+1, on);
+        return m_socket->read(buf, maxLen);
+    }
+    catch (ETimeout&) {
+        // 读超时: Modbus-TCP 保留半帧；RTU 以线路空闲为帧边界，丢弃残帧重新同步
+        if (m_rtu) m_parser.Reset();
+        return 0;
+    }
+    catch (...) {
+        m_parser.Reset();
+        return -1;
+    }
+}
+
+void Ultrasonic_TAS_IO_428R2::OnRawDataReceived(const u8* data, u32 len) {
+    // 应答可能被拆分到多次读取或多帧粘连，由 m_parser 分帧后逐帧投递
+    m_parser.Feed(data, len);
+}
+
+bool Ultrasonic_TAS_IO_428R2::SendFrame(const u8* buf, size_t len) {
+    if (!m_socket || !m_socket->isOpen()) return false;
+
+    try {
+        m_socket->write(buf, (u32)len);
+        return true;
     }
     catch (std::exception& e) {
         LOG_ERROR("[Slot %d] Ultrasonic Send failed: %s", m_slotID, e.what());
         SetState(STATE_ERROR, 101);
         m_socket->close();
+        return false;
     }
 }
 
 bool Ultrasonic_TAS_IO_428R2::Connect() {
     if (IsOnline() && m_socket && m_socket->isOpen()) return true;
 
+    // 旧连接上的请求不会再有应答
+    FailAll();
+
+    // 出错状态需先回到离线才能重连
+    if (GetState() == STATE_ERROR) SetState(STATE_OFFLINE);
+
     try {
         SetState(STATE_CONNECTING);
         m_socket = std::make_shared<TcpSocket>(m_ip, m_port);
-        m_socket->setConnTimeout(500); // 500ms ӳʱ
+        m_socket->setConnTimeout(500); // 500ms 连接超时
+        m_socket->setRecvTimeout(200);
         m_socket->open();
+        m_known = 0;    // 重连后线圈状态未知，下次写入全部下发
+        m_timeouts = 0;
         SetState(STATE_ONLINE);
         return true;
     }
@@ -95,4 +480,10 @@ bool Ultrasonic_TAS_IO_428R2::Connect() {
     }
 }
 
+void Ultrasonic_TAS_IO_428R2::Disconnect() {
+    if (m_socket) m_socket->close();
+    FailAll();
+    SetState(STATE_OFFLINE);    // 停止读取线程，下次写入或轮询时重连
+}
+
 ECCS_END
\ No newline at end of file
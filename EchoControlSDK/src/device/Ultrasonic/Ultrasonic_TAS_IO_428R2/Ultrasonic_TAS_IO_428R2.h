@@ -1,6 +1,11 @@
 #pragma once
 #include "../IUltrasonic_Device.h"
 #include "net/TCPSocket.h"
+#include "protocol/ModbusTcpParser.h"
+#include "thread/timer_service.h"
+#include <atomic>
+#include <deque>
+#include <map>
 
 ECCS_BEGIN
 
@@ -9,33 +14,106 @@ class Ultrasonic_TAS_IO_428R2 : public IUltrasonic_Device
 public:
     using Self = Ultrasonic_TAS_IO_428R2;
 
-    // 徲̬ ID 
+    // 定义静态 ID 常量
     static const u32 ID = MAKE_DEV_OID(did::DEVICE_ULTRASONIC, did::ULTRASONIC_TAS_IO_428R2);
 
-    // עṤ: Key=u32, Model Name="TAS-IO-428R2"
+    // 注册工厂宏: Key=u32, Model Name="TAS-IO-428R2"
     FACTORY_ID_CHILD_WITH_SPEC_NAME(u32, ID, DeviceBase, Self, "TAS-IO-428R2")
 
     Ultrasonic_TAS_IO_428R2();
     virtual ~Ultrasonic_TAS_IO_428R2();
 
-    // ǳʼ
+    // 覆盖初始化
     virtual bool Init(int slotID, const std::map<str, str>& config) override;
+    virtual void OnRegisterProperties() override;
+
+    virtual u32 GetSwitchState(u32& mask) const override;
 
 protected:
-    // --- ʵ IUltrasonic_Device ӿ ---
+    // --- 实现 IUltrasonic_Device 接口 ---
     virtual void SetSwitch(u8 channel, bool isOpen) override;
+    virtual void SetMask(u32 mask) override;
+
+    virtual void OnCustomEvent(Event_Ptr& e) override;
+
+    // 实现基类的 IO 接口 (读取线程)
+    virtual int ReadRaw(u8* buf, u32 maxLen) override;
+    virtual void OnRawDataReceived(const u8* data, u32 len) override;
+
+    // 覆盖 Start/Stop 以启动轮询
+    virtual bool Start() override;
+    virtual void Stop() override;
 
 private:
-    // Modbus-TCP 
-    void SendModbusCmd(u8 unitId, u16 addr, bool on);
+    // Modbus 请求 (设备线程)
+    struct ModbusRequest {
+        u32 seq;        // 请求序号，低 16 位为事务 ID
+        u8  func;       // 01 读线圈 / 05 写单个线圈 / 0F 写多个线圈
+        u16 addr;
+        u16 count;
+        u32 bits;       // 写入值 (bit0=通道1)
+        u32 span;       // 涉及的通道
+        TimerService::TimerId timer;
+    };
+
+    u32 AllChannels() const { return (m_channels >= 32) ? 0xFFFFFFFFu : ((1u << m_channels) - 1); }
+
+    // 写入 select 选中的通道 (值取自 mask)，与缓存一致的通道不重复写入
+    void WriteCoils(u32 mask, u32 select);
+
+    // 事务管理: 排队 -> 发送 (在途数受限) -> 应答匹配 / 超时
+    void Submit(ModbusRequest req);
+    void Pump();
+    bool Transmit(ModbusRequest& req);
+    void OnResponse(const ModbusResponse& rsp);
+    void OnTimeout(u32 seq);
+    void FailRequest(const ModbusRequest& req);
+    void FailAll();
 
-    // ӹ
+    // 轮询回读
+    void PollCoils();
+    void ArmPollTimer();
+    void CancelPollTimer();
+
+    // 更新对外发布的通道状态表 (span 内的通道置为已知)
+    void UpdateState(u32 span, u32 bits);
+
+    bool SendFrame(const u8* buf, size_t len);
+
+    // 连接管理
     bool Connect();
+    void Disconnect();
 
 private:
     str m_ip;
     int m_port;
     TcpSocket_Ptr m_socket;
+
+    // 线圈状态缓存 (bit0=通道1)，只在设备线程中访问
+    // 写入时立即按指令更新，失败/超时清除对应通道的已知标记，轮询回读校正
+    int m_channels;
+    u32 m_coils;
+    u32 m_known;    // 状态已知的通道 (重连后清空)
+
+    // 设备确认的通道状态表 (高 32 位: 已知掩码，低 32 位: 状态)，供任意线程读取
+    std::atomic<u64> m_state;
+
+    // 事务
+    bool m_rtu;                                 // RTU over TCP: 无事务 ID，同一时刻只有一个在途请求
+    ModbusTcpParser m_parser;                   // 仅在读取线程中使用
+    std::map<u16, ModbusRequest> m_inflight;    // 事务 ID -> 在途请求
+    std::deque<ModbusRequest> m_queue;          // 等待发送
+    u32 m_nextSeq;
+    u32 m_lastWrite[32];                        // 各通道最近一次写请求的序号
+    u32 m_maxInFlight;
+    u32 m_timeoutMs;
+    u32 m_timeouts;                             // 连续超时次数
+
+    // 轮询
+    u32 m_pollMs;
+    u32 m_pollGen;
+    bool m_pollBusy;
+    TimerService::TimerId m_pollTimer;
 };
 
 ECCS_END
\ No newline at end of file
@@ -58,11 +58,11 @@
        classname(const classname &); \
        classname & operator=(const classname &);
 #endif
-//Ƿر־¼ܣ 1رգ0
+//是否关闭日志记录功能： 1：关闭，0：打开
 #define DISABLE_LOG 0
-//ƴǷӡ߳ԴϢDEBUG־: 1/ 0/ر
+//用来控制代码是否打印线程资源相关信息的DEBUG日志: 1/开启 0/关闭
 #define THREAD_DEBUG_LOG 0
-//ʱӵlogϢǷʾ
+//用来控制临时调试增加的log信息是否显示
 #define TMP_DEBUG_LOG 0
 
 #include "types.h"
\ No newline at end of file
@@ -2,7 +2,7 @@
 #include "protocol/Packet_Def.h"
 #include "debug/Logger.h"
 
-// мӿ (Interface Layer)
+// 引入中间层接口 (Interface Layer)
 #include "device/Light/ILight_Device.h"
 #include "device/PTZ/IPTZ_Device.h"
 #include "device/Sound/ISound_Device.h"
@@ -11,10 +11,10 @@
 ECCS_BEGIN
 
 // -----------------------------------------------------------
-// ꣺ת밲ȫ
+// 辅助宏：简化类型转换与安全检查
 // -----------------------------------------------------------
 
-//  DeviceBase* תΪмӿָ ( ILight_Device*)
+// 将 DeviceBase* 转换为具体的中间层接口指针 (如 ILight_Device*)
 #define CAST_DEV(InterfaceType, VarName) \
     InterfaceType* VarName = dynamic_cast<InterfaceType*>(dev); \
     if (!VarName) { \
@@ -22,7 +22,7 @@ ECCS_BEGIN
         return; \
     }
 
-//  RpcPacket* תΪҵָ ( RqLightSwitch*)
+// 将 RpcPacket* 转换为具体的业务包指针 (如 RqLightSwitch*)
 #define CAST_PKT(PacketType, VarName) \
     auto VarName = std::dynamic_pointer_cast<PacketType>(pkt); \
     if (!VarName) { \
@@ -31,71 +31,115 @@ ECCS_BEGIN
     }
 
 // -----------------------------------------------------------
-// 캯ע·ɱ
+// 构造函数：注册路由表
 // -----------------------------------------------------------
 EchoControlHandler::EchoControlHandler() {
 
     // =======================================================
-    // 1. ǿ豸 (Light)
+    // 1. 强光设备 (Light)
     // =======================================================
 
-    // 
+    // 开关
     Register<rpc::RqLightSwitch>([](DeviceBase* dev, std::shared_ptr<rpc::RpcPacket> pkt) {
         CAST_DEV(ILight_Device, light);
         CAST_PKT(rpc::RqLightSwitch, req);
         light->SetSwitch(req->data); // bool
         });
 
-    // 
+    // 亮度
     Register<rpc::RqLightLevel>([](DeviceBase* dev, std::shared_ptr<rpc::RpcPacket> pkt) {
         CAST_DEV(ILight_Device, light);
         CAST_PKT(rpc::RqLightLevel, req);
         light->SetBrightness(req->data); // u8
         });
 
-    // Ƶ
+    // 频闪
     Register<rpc::RqLightStrobe>([](DeviceBase* dev, std::shared_ptr<rpc::RpcPacket> pkt) {
         CAST_DEV(ILight_Device, light);
         CAST_PKT(rpc::RqLightStrobe, req);
         light->SetStrobe(req->data); // bool
         });
 
+    // 强制刷新
+    Register<rpc::RqLightRefresh>([](DeviceBase* dev, std::shared_ptr<rpc::RpcPacket> pkt) {
+        CAST_DEV(ILight_Device, light);
+        light->Refresh();
+        });
+
+    // 状态查询 (结果通过 OwLightStatus 推送)
+    Register<rpc::RqQueryLightStatus>([](DeviceBase* dev, std::shared_ptr<rpc::RpcPacket> pkt) {
+        CAST_DEV(ILight_Device, light);
+        light->QueryStatus();
+        });
+
     // =======================================================
-    // 2. ̨豸 (PTZ)
+    // 2. 云台设备 (PTZ)
     // =======================================================
 
-    // ƶ (///)
+    // 移动 (上/下/左/右)
     Register<rpc::RqPtzMove>([](DeviceBase* dev, std::shared_ptr<rpc::RpcPacket> pkt) {
         CAST_DEV(IPTZ_Device, ptz);
-        CAST_PKT(rpc::RqPtzMove, req); // ע:  PacketDef  PtzMotion ṹ
+        CAST_PKT(rpc::RqPtzMove, req); // 注意: 你的 PacketDef 中 PtzMotion 结构体
+        ptz->TourNotifyManual();
         ptz->PtzMove(req->data.action, req->data.speed);
         });
 
-    // ֹͣ
+    // 停止
     Register<rpc::RqPtzStop>([](DeviceBase* dev, std::shared_ptr<rpc::RpcPacket> pkt) {
         CAST_DEV(IPTZ_Device, ptz);
+        ptz->TourNotifyManual();
         ptz->PtzStop();
         });
 
-    // Ԥλ
+    // 预置位
     Register<rpc::RqPtzPreset>([](DeviceBase* dev, std::shared_ptr<rpc::RpcPacket> pkt) {
         CAST_DEV(IPTZ_Device, ptz);
         CAST_PKT(rpc::RqPtzPreset, req);
+        ptz->TourNotifyManual();
         ptz->PtzPreset(req->data.action, req->data.index);
         });
 
+    // 连续速度 (摇杆)
+    Register<rpc::RqPtzVelocity>([](DeviceBase* dev, std::shared_ptr<rpc::RpcPacket> pkt) {
+        CAST_DEV(IPTZ_Device, ptz);
+        CAST_PKT(rpc::RqPtzVelocity, req);
+        ptz->TourNotifyManual();
+        ptz->PtzSetVelocity(req->data.pan, req->data.tilt);
+        });
+
+    // 绝对定位 (结果通过 OwPtzGotoDone 异步推送)
+    Register<rpc::RqPtzGoto>([](DeviceBase* dev, std::shared_ptr<rpc::RpcPacket> pkt) {
+        CAST_DEV(IPTZ_Device, ptz);
+        CAST_PKT(rpc::RqPtzGoto, req);
+        ptz->TourNotifyManual();
+        ptz->PtzGotoAngle(req->data.pan, req->data.tilt, req->data.tolerance);
+        });
+
+    // 巡航开始/停止
+    Register<rpc::RqPtzTourStart>([](DeviceBase* dev, std::shared_ptr<rpc::RpcPacket> pkt) {
+        CAST_DEV(IPTZ_Device, ptz);
+        CAST_PKT(rpc::RqPtzTourStart, req);
+        req->data.steps[sizeof(req->data.steps) - 1] = '\0';
+        ptz->TourStart(req->data.steps);
+        });
+
+    Register<rpc::RqPtzTourStop>([](DeviceBase* dev, std::shared_ptr<rpc::RpcPacket> pkt) {
+        CAST_DEV(IPTZ_Device, ptz);
+        ptz->TourStop();
+        });
+
     // =======================================================
-    // 3. ǿ豸 (Sound)
+    // 3. 强声设备 (Sound)
     // =======================================================
 
-    // ļ
+    // 播放文件
     Register<rpc::RqSoundPlay>([](DeviceBase* dev, std::shared_ptr<rpc::RpcPacket> pkt) {
         CAST_DEV(ISound_Device, sound);
         CAST_PKT(rpc::RqSoundPlay, req);
         sound->PlayFile(req->data.filename, req->data.loop > 0);
         });
 
-    // ֹͣ
+    // 停止
     Register<rpc::RqSoundStop>([](DeviceBase* dev, std::shared_ptr<rpc::RpcPacket> pkt) {
         CAST_DEV(ISound_Device, sound);
         sound->StopPlay();
@@ -108,14 +152,14 @@ EchoControlHandler::EchoControlHandler() {
         sound->TTSPlay(req->data.text);
         });
 
-    // 
+    // 喊话
     Register<rpc::RqSoundMic>([](DeviceBase* dev, std::shared_ptr<rpc::RpcPacket> pkt) {
         CAST_DEV(ISound_Device, sound);
         CAST_PKT(rpc::RqSoundMic, req);
         sound->SetMic(req->data); // bool
         });
 
-    // 
+    // 设置音量
     Register<rpc::RqSetSoundVolume>([](DeviceBase* dev, std::shared_ptr<rpc::RpcPacket> pkt) {
         CAST_DEV(ISound_Device, sound);
         CAST_PKT(rpc::RqSetSoundVolume, req);
@@ -123,10 +167,10 @@ EchoControlHandler::EchoControlHandler() {
     });
 
     // =======================================================
-    // 4. 豸 (Ultrasonic)
+    // 4. 超声设备 (Ultrasonic)
     // =======================================================
 
-    // ؿ
+    // 开关控制
     Register<rpc::RqUltrasonicSwitch>([](DeviceBase* dev, std::shared_ptr<rpc::RpcPacket> pkt) {
         CAST_DEV(IUltrasonic_Device, ultrasonic);
         CAST_PKT(rpc::RqUltrasonicSwitch, req);
@@ -135,10 +179,17 @@ EchoControlHandler::EchoControlHandler() {
         // req->data.isOpen: 0, 1
         ultrasonic->SetSwitch(req->data.channel, (req->data.isOpen != 0));
     });
+
+    // 按掩码设置全部通道
+    Register<rpc::RqUltrasonicMask>([](DeviceBase* dev, std::shared_ptr<rpc::RpcPacket> pkt) {
+        CAST_DEV(IUltrasonic_Device, ultrasonic);
+        CAST_PKT(rpc::RqUltrasonicMask, req);
+        ultrasonic->SetMask(req->data.mask);
+    });
 }
 
 // -----------------------------------------------------------
-// ķַ߼
+// 核心分发逻辑
 // -----------------------------------------------------------
 void EchoControlHandler::Dispatch(DeviceBase* dev, std::shared_ptr<rpc::RpcPacket> pkt) {
     if (!dev || !pkt) return;
@@ -147,7 +198,7 @@ void EchoControlHandler::Dispatch(DeviceBase* dev, std::shared_ptr<rpc::RpcPacke
     auto it = m_handlers.find(id);
 
     if (it != m_handlers.end()) {
-        // ҵ -> ִ
+        // 找到处理函数 -> 执行
         try {
             it->second(dev, pkt);
         }
@@ -156,7 +207,7 @@ void EchoControlHandler::Dispatch(DeviceBase* dev, std::shared_ptr<rpc::RpcPacke
         }
     }
     else {
-        // δעָ
+        // 未注册的指令
         LOG_WARNING("[EchoHandler] No handler found for Packet ID 0x%X", id);
     }
 }
@@ -7,39 +7,39 @@
 
 ECCS_BEGIN
 
-// ǰѭͷļ
+// 前置声明，避免循环引用头文件
 class DeviceBase;
 
 class EchoControlHandler {
 public:
-    // 
+    // 单例访问
     static EchoControlHandler& Instance() {
         static EchoControlHandler instance;
         return instance;
     }
 
     /**
-     * @brief ķַ
-     * @param dev Ŀ豸ָ (DeviceBase*)
-     * @param pkt յЭ
+     * @brief 核心分发函数
+     * @param dev 目标设备指针 (DeviceBase*)
+     * @param pkt 收到的协议包
      */
     void Dispatch(DeviceBase* dev, std::shared_ptr<rpc::RpcPacket> pkt);
 
 private:
-    EchoControlHandler(); // ڹ캯ָע
+    EchoControlHandler(); // 在构造函数中完成所有指令的注册
 
-    // 崦ǩ
+    // 定义处理函数的签名
     using HandlerFunc = std::function<void(DeviceBase*, std::shared_ptr<rpc::RpcPacket>)>;
 
-    // ģ帨 Packet  ID ע
+    // 模板辅助函数：利用 Packet 自身的 ID 进行注册
     template<typename TPacket>
     void Register(HandlerFunc func) {
-        // TPacket::_FACTORY_ID_  PacketTemplate Զɵľ̬
+        // TPacket::_FACTORY_ID_ 是 PacketTemplate 自动生成的静态常量
         m_handlers[TPacket::_FACTORY_ID_] = func;
     }
 
 private:
-    // ·ɱ: PacketID -> 
+    // 路由表: PacketID -> 处理函数
     std::map<u32, HandlerFunc> m_handlers;
 };
 
@@ -0,0 +1,706 @@
+#include "RpcGateway.h"
+#include "../debug/Exceptions.h"
+#include "../debug/Logger.h"
+#include "../../include/EchoControlCode.h"
+#include <string.h>
+#include <algorithm>
+#include <vector>
+
+#ifdef __linux__
+#include <sys/epoll.h>
+#endif
+
+#ifndef _WIN32
+#include <sys/socket.h>
+#include <limits.h>
+#endif
+
+#ifndef IOV_MAX
+#define IOV_MAX 1024
+#endif
+
+#ifndef MSG_NOSIGNAL
+#define MSG_NOSIGNAL 0
+#endif
+
+#ifndef AF_LOCAL
+#define AF_LOCAL AF_UNIX
+#endif
+
+ECCS_BEGIN
+
+static const u32 RP_FLAG = 0x8000;      // Packet ID 中的应答位 (见 Packet_ID.h)
+static const size_t RECV_CHUNK = 16 * 1024;
+
+// Packet ID 分类 (见 Packet_ID.h)
+static inline u32 PacketCategory(u32 id) { return (id >> 16) & 0xFF; }
+static inline bool IsResponseId(u32 id) { return (id & RP_FLAG) != 0; }
+
+static bool SetNonBlocking(HD_SOCKET fd)
+{
+    int flags = HD_FCNTL(fd, HD_F_GETFL, 0);
+    if (flags == -1) return false;
+    return HD_FCNTL(fd, HD_F_SETFL, flags | HD_O_NONBLOCK) != -1;
+}
+
+static inline bool WouldBlock(int e)
+{
+    return e == HD_EAGAIN || e == HD_EWOULDBLOCK || e == HD_EINTR;
+}
+
+// 分散写 (一次系统调用发送多个片段)，返回值同 send
+static HD_SSIZET SendIov(HD_SOCKET fd, rpc::IoVec* iov, int cnt)
+{
+#ifdef _WIN32
+    // Windows 下合并后发送
+    Buffer tmp;
+    for (int i = 0; i < cnt; ++i) tmp.push_back((const char*)iov[i].iov_base, iov[i].iov_len);
+    return send(fd, tmp.buf(), (int)tmp.size(), 0);
+#else
+    msghdr msg;
+    memset(&msg, 0, sizeof(msg));
+    msg.msg_iov = iov;
+    msg.msg_iovlen = cnt;
+    return sendmsg(fd, &msg, MSG_NOSIGNAL);
+#endif
+}
+
+// 把 skip 字节之后的片段内容追加到缓冲
+static void AppendIov(Buffer& buf, const rpc::IoVec* iov, size_t cnt, size_t skip)
+{
+    for (size_t i = 0; i < cnt; ++i) {
+        size_t len = iov[i].iov_len;
+        if (skip >= len) {
+            skip -= len;
+            continue;
+        }
+        buf.push_back((const char*)iov[i].iov_base + skip, len - skip);
+        skip = 0;
+    }
+}
+
+
+//------------------------------------------------------
+// 就绪通知: Linux epoll (水平触发)，其它平台 poll
+//------------------------------------------------------
+
+struct PollReady {
+    HD_SOCKET fd;
+    bool readable;      // 含错误/挂断，由 recv 判定
+    bool writable;
+};
+
+#ifdef __linux__
+
+class RpcGateway::Poller
+{
+public:
+    Poller() : m_ep(epoll_create1(EPOLL_CLOEXEC)), m_events(64) {}
+    ~Poller() { if (m_ep >= 0) ::close(m_ep); }
+
+    bool Valid() const { return m_ep >= 0; }
+
+    void Add(HD_SOCKET fd, bool wantWrite) { Ctl(EPOLL_CTL_ADD, fd, wantWrite); }
+    void Modify(HD_SOCKET fd, bool wantWrite) { Ctl(EPOLL_CTL_MOD, fd, wantWrite); }
+    void Remove(HD_SOCKET fd) { epoll_ctl(m_ep, EPOLL_CTL_DEL, fd, nullptr); }
+
+    int Wait(int timeoutMs, std::vector<PollReady>& ready)
+    {
+        ready.clear();
+        int n = epoll_wait(m_ep, m_events.data(), (int)m_events.size(), timeoutMs);
+        for (int i = 0; i < n; ++i) {
+            u32 ev = m_events[i].events;
+            PollReady r;
+            r.fd = m_events[i].data.fd;
+            r.readable = (ev & (EPOLLIN | EPOLLERR | EPOLLHUP)) != 0;
+            r.writable = (ev & EPOLLOUT) != 0;
+            ready.push_back(r);
+        }
+        return n;
+    }
+
+private:
+    void Ctl(int op, HD_SOCKET fd, bool wantWrite)
+    {
+        epoll_event ev;
+        memset(&ev, 0, sizeof(ev));
+        u32 events = EPOLLIN;
+        if (wantWrite) events |= EPOLLOUT;
+        ev.events = events;
+        ev.data.fd = fd;
+        epoll_ctl(m_ep, op, fd, &ev);
+    }
+
+    int m_ep;
+    std::vector<epoll_event> m_events;
+};
+
+#else
+
+class RpcGateway::Poller
+{
+public:
+    bool Valid() const { return true; }
+
+    void Add(HD_SOCKET fd, bool wantWrite)
+    {
+        HD_POLLFD p;
+        memset(&p, 0, sizeof(p));
+        p.fd = fd;
+        p.events = HD_POLLIN | (wantWrite ? HD_POLLOUT : 0);
+        m_fds.push_back(p);
+    }
+    void Modify(HD_SOCKET fd, bool wantWrite)
+    {
+        for (auto& p : m_fds) {
+            if (p.fd == fd) p.events = HD_POLLIN | (wantWrite ? HD_POLLOUT : 0);
+        }
+    }
+    void Remove(HD_SOCKET fd)
+    {
+        for (size_t i = 0; i < m_fds.size(); ++i) {
+            if (m_fds[i].fd == fd) {
+                m_fds.erase(m_fds.begin() + i);
+                return;
+            }
+        }
+    }
+
+    int Wait(int timeoutMs, std::vector<PollReady>& ready)
+    {
+        ready.clear();
+        int n = HD_POLL(m_fds.data(), (int)m_fds.size(), timeoutMs);
+        if (n <= 0) return n;
+        for (auto& p : m_fds) {
+            if (!p.revents) continue;
+            PollReady r;
+            r.fd = p.fd;
+            r.readable = (p.revents & ~HD_POLLOUT) != 0;
+            r.writable = (p.revents & HD_POLLOUT) != 0;
+            ready.push_back(r);
+        }
+        return (int)ready.size();
+    }
+
+private:
+    std::vector<HD_POLLFD> m_fds;
+};
+
+#endif
+
+
+RpcGateway::RpcGateway(RouteFunc route)
+    : m_route(route), m_listenFd(HD_INVALID_SOCKET),
+      m_wakeReader(HD_INVALID_SOCKET), m_wakeWriter(HD_INVALID_SOCKET),
+      m_thread(nullptr), m_running(false),
+      m_requests(0), m_replies(0), m_pushes(0), m_badFrames(0), m_dropped(0), m_clientCount(0), m_compactCount(0)
+{
+}
+
+RpcGateway::~RpcGateway()
+{
+    Stop();
+}
+
+bool RpcGateway::Start(int port, const str& addr)
+{
+    if (m_running) return true;
+
+    m_poller.reset(new Poller());
+    if (!m_poller->Valid()) {
+        LOG_ERROR("[Gateway] Create poller failed");
+        return false;
+    }
+
+    try {
+        m_server = std::make_shared<TcpServer>(addr, port);
+        m_server->setAcceptTimeout(0);  // 非阻塞 accept，由事件循环驱动
+        m_server->setInterruptableChildren(false);
+        m_server->setListenCallback([this](HD_SOCKET fd) {
+            m_listenFd = fd;
+#ifdef TCP_DEFER_ACCEPT
+            // 只订阅推送的客户端连上后不发数据，不能等到首包才 accept
+            int zero = 0;
+            setsockopt(fd, IPPROTO_TCP, TCP_DEFER_ACCEPT, (const char*)&zero, sizeof(zero));
+#endif
+        });
+        m_server->listen();
+    }
+    catch (std::exception& e) {
+        LOG_ERROR("[Gateway] Listen on port %d failed: %s", port, e.what());
+        m_server.reset();
+        return false;
+    }
+
+    HD_SOCKET sv[2];
+    if (HD_SOCKETPAIR(AF_LOCAL, SOCK_STREAM, 0, sv) == -1) {
+        LOG_ERROR("[Gateway] Create wakeup socket failed");
+        m_server.reset();
+        return false;
+    }
+    SetNonBlocking(sv[0]);
+    SetNonBlocking(sv[1]);
+    m_wakeReader = sv[0];
+    {
+        std::lock_guard<std::mutex> lock(m_outboxMutex);
+        m_wakeWriter = sv[1];
+    }
+
+    m_poller->Add(m_listenFd, false);
+    m_poller->Add(m_wakeReader, false);
+
+    m_running = true;
+    m_thread = new std::thread(&RpcGateway::Loop, this);
+
+    LOG_INFO("[Gateway] Listening on port %d", m_server->port());
+    return true;
+}
+
+void RpcGateway::Stop()
+{
+    if (!m_thread) return;
+
+    m_running = false;
+    {
+        std::lock_guard<std::mutex> lock(m_outboxMutex);
+        char b = 0;
+        send(m_wakeWriter, &b, 1, MSG_NOSIGNAL);
+    }
+
+    if (m_thread->joinable()) m_thread->join();
+    delete m_thread;
+    m_thread = nullptr;
+
+    m_clients.clear();      // TcpSocket 析构时关闭连接
+    m_clientCount = 0;
+    m_server.reset();
+    m_listenFd = HD_INVALID_SOCKET;
+
+    HD_CLOSESOCKET(m_wakeReader);
+    m_wakeReader = HD_INVALID_SOCKET;
+    m_poller.reset();
+
+    {
+        // 已取得网关指针的发布线程可能仍在 Publish 中，唤醒端只在锁内使用
+        std::lock_guard<std::mutex> lock(m_outboxMutex);
+        HD_CLOSESOCKET(m_wakeWriter);
+        m_wakeWriter = HD_INVALID_SOCKET;
+        m_outbox.clear();
+    }
+    m_batch.clear();
+    m_iov.clear();
+    for (Buffer& b : m_compactBatch) b.clear();
+    m_compactCount = 0;
+
+    LOG_INFO("[Gateway] Stopped. requests=%llu replies=%llu pushes=%llu bad=%llu dropped=%llu",
+        (unsigned long long)m_requests.load(), (unsigned long long)m_replies.load(),
+        (unsigned long long)m_pushes.load(), (unsigned long long)m_badFrames.load(),
+        (unsigned long long)m_dropped.load());
+}
+
+RpcGateway::Stats RpcGateway::GetStats() const
+{
+    Stats s;
+    s.requests = m_requests;
+    s.replies = m_replies;
+    s.pushes = m_pushes;
+    s.badFrames = m_badFrames;
+    s.dropped = m_dropped;
+    s.clients = m_clientCount;
+    s.compactClients = m_compactCount;
+    return s;
+}
+
+void RpcGateway::Publish(std::shared_ptr<rpc::RpcPacket> pkt)
+{
+    if (!pkt || !m_running) return;
+
+    // 与 Stop 关闭唤醒端互斥 (唤醒端非阻塞，持锁写入不会等待)
+    std::lock_guard<std::mutex> lock(m_outboxMutex);
+    if (!m_running || m_wakeWriter == HD_INVALID_SOCKET) return;
+
+    // 队列由空变非空时才唤醒，积压期间不重复写唤醒字节
+    bool wake = m_outbox.empty();
+    m_outbox.push_back(pkt);
+    if (wake) {
+        char b = 0;
+        send(m_wakeWriter, &b, 1, MSG_NOSIGNAL);
+    }
+}
+
+void RpcGateway::Loop()
+{
+    std::vector<PollReady> ready;
+
+    while (m_running) {
+        int n = m_poller->Wait(1000, ready);
+        if (n < 0) {
+            int e = HD_GET_SOCKET_ERROR;
+            if (e == HD_EINTR) continue;
+            LOG_ERROR("[Gateway] Poll failed: %d", e);
+            break;
+        }
+
+        for (const PollReady& r : ready) {
+            if (r.fd == m_listenFd) {
+                AcceptAll();
+                continue;
+            }
+            if (r.fd == m_wakeReader) {
+                char tmp[64];
+                while (recv(m_wakeReader, tmp, sizeof(tmp), 0) > 0) {}
+                DrainOutbox();
+                continue;
+            }
+
+            auto it = m_clients.find(r.fd);
+            if (it == m_clients.end()) continue;   // 本轮已关闭
+            Client_Ptr c = it->second;
+
+            if (r.writable && !OnWritable(c)) continue;
+            if (r.readable) OnReadable(c);
+        }
+    }
+}
+
+void RpcGateway::AcceptAll()
+{
+    for (;;) {
+        TcpSocket_Ptr sock;
+        try {
+            sock = m_server->accept();
+        }
+        catch (std::exception& e) {
+            LOG_WARNING("[Gateway] Accept failed: %s", e.what());
+            return;
+        }
+        if (!sock) return;
+
+        if (m_clients.size() >= (size_t)MAX_CLIENTS) {
+            LOG_WARNING("[Gateway] Too many clients, reject %s", sock->peerAddress().c_str());
+            continue;   // sock 析构时关闭
+        }
+
+        HD_SOCKET fd = sock->socket();
+        if (!SetNonBlocking(fd)) {
+            LOG_WARNING("[Gateway] Set non-blocking failed, reject %s", sock->peerAddress().c_str());
+            continue;
+        }
+        sock->setNoDelay(true);
+
+        Client_Ptr c = std::make_shared<Client>();
+        c->sock = sock;
+        c->wantWrite = false;
+        c->format = FORMAT_UNKNOWN;
+        c->version = 0;
+        m_clients[fd] = c;
+        m_poller->Add(fd, false);
+        m_clientCount = (u32)m_clients.size();
+
+        LOG_INFO("[Gateway] Client connected: %s", sock->peerAddress().c_str());
+    }
+}
+
+void RpcGateway::CloseClient(HD_SOCKET fd)
+{
+    auto it = m_clients.find(fd);
+    if (it == m_clients.end()) return;
+
+    m_poller->Remove(fd);
+    LOG_INFO("[Gateway] Client disconnected: %s", it->second->sock->peerAddress().c_str());
+    if (it->second->format == FORMAT_COMPACT) --m_compactCount;
+    m_clients.erase(it);
+    m_clientCount = (u32)m_clients.size();
+}
+
+void RpcGateway::OnReadable(Client_Ptr& c)
+{
+    HD_SOCKET fd = c->sock->socket();
+
+    // 直接收进客户端的接收缓冲尾部，避免中间拷贝
+    size_t old = c->in.size();
+    c->in.resize(old + RECV_CHUNK);
+    HD_SSIZET n = recv(fd, c->in.buf() + old, (int)RECV_CHUNK, 0);
+    c->in.resize(old + (n > 0 ? (size_t)n : 0));
+
+    if (n == 0) {
+        CloseClient(fd);
+        return;
+    }
+    if (n < 0) {
+        if (!WouldBlock(HD_GET_SOCKET_ERROR)) CloseClient(fd);
+        return;
+    }
+
+    HandleFrames(c);
+    if (m_clients.count(fd)) Flush(c);
+}
+
+bool RpcGateway::OnWritable(Client_Ptr& c)
+{
+    HD_SOCKET fd = c->sock->socket();
+    Flush(c);
+    return m_clients.count(fd) != 0;
+}
+
+void RpcGateway::HandleFrames(Client_Ptr& c)
+{
+    // 帧直接在接收缓冲上解析，处理完一帧再整体弹出
+    for (;;) {
+        rpc::RawPacketView view;
+        rpc::RawPacketView::Status st = view.Parse((const u8*)c->in.buf(), c->in.size(), MAX_BODY_LEN);
+        if (st == rpc::RawPacketView::VIEW_NEED_MORE) return;   // 等待包体
+
+        // 帧头错误后无法重新定位帧边界，断开该客户端；
+        // 校验失败说明链路上有损坏，其后的数据同样不可信
+        if (st == rpc::RawPacketView::VIEW_BAD_CRC) {
+            ++m_badFrames;
+            LOG_WARNING("[Gateway] CRC mismatch in compact frame from %s (id 0x%08X, len %u)",
+                c->sock->peerAddress().c_str(), view.Id(), view.BodyLen());
+            CloseClient(c->sock->socket());
+            return;
+        }
+        if (st == rpc::RawPacketView::VIEW_BAD_HEADER) {
+            ++m_badFrames;
+            u8 first = (u8)c->in.buf()[0];
+            if (rpc::IsCompactTag(first)) {
+                LOG_WARNING("[Gateway] Bad compact frame from %s (tag 0x%02X, supported version %u)",
+                    c->sock->peerAddress().c_str(), (u32)first, (u32)rpc::COMPACT_VERSION);
+            }
+            else {
+                rpc::PacketHeader hdr;
+                memcpy(&hdr, c->in.buf(), sizeof(hdr));
+                LOG_WARNING("[Gateway] Bad frame header from %s (magic 0x%08X, len %u)",
+                    c->sock->peerAddress().c_str(), hdr.magic, hdr.bodyLen);
+            }
+            CloseClient(c->sock->socket());
+            return;
+        }
+
+        // 首帧决定该连接的编码
+        WireFormat fmt = view.IsCompact() ? FORMAT_COMPACT : FORMAT_FIXED;
+        if (c->format == FORMAT_UNKNOWN) {
+            c->format = fmt;
+            c->version = view.Version();
+            if (fmt == FORMAT_COMPACT) {
+                ++m_compactCount;
+                LOG_INFO("[Gateway] Client %s uses compact encoding v%u",
+                    c->sock->peerAddress().c_str(), (u32)view.Version());
+            }
+        }
+        else if (c->format != fmt || c->version != view.Version()) {
+            ++m_badFrames;
+            LOG_WARNING("[Gateway] Client %s switched wire format, disconnect", c->sock->peerAddress().c_str());
+            CloseClient(c->sock->socket());
+            return;
+        }
+
+        HandleRequest(c, view);
+        c->in.pop_front(view.FrameLen());
+    }
+}
+
+void RpcGateway::HandleRequest(Client_Ptr& c, const rpc::RawPacketView& view)
+{
+    u32 id = view.Id();
+
+    // 紧凑编码协商帧: 以客户端选择的版本回应 (版本已在解析时检查)
+    if (view.IsCompact() && id == rpc::COMPACT_HELLO_ID) {
+        rpc::AppendCompactFrame(c->out, c->version, rpc::COMPACT_HELLO_ID, view.Seq(), NULL, 0);
+        return;
+    }
+
+    ++m_requests;
+
+    u32 cat = PacketCategory(id);
+    if (IsResponseId(id) || cat < 2 || cat > 4) {
+        ++m_badFrames;
+        LOG_WARNING("[Gateway] Not a request packet: 0x%08X", id);
+        return;
+    }
+
+    // 路由函数先检查目标设备，只有确定投递时才生成包对象；
+    // 设备不存在/离线的请求不分配内存
+    int code;
+    if (!view.IsKnown()) {
+        code = ECCS_ERR_NOT_SUPPORTED;
+    }
+    else {
+        code = m_route ? m_route(view) : (int)ECCS_ERR_NOT_INIT;
+        if (code == ECCS_ERR_INVALID_PARAM) ++m_badFrames;
+    }
+
+    // Query 类请求的结果随 Ow* 推送返回，只在失败时记录
+    if (cat == 3) {
+        if (code != ECCS_SUCCESS) {
+            LOG_WARNING("[Gateway] Query 0x%08X failed: %s", id, ECCS_GetErrorStr((ECCS_Error)code));
+        }
+        return;
+    }
+
+    Reply(c, id | RP_FLAG, view.Seq(), code);
+}
+
+void RpcGateway::Reply(Client_Ptr& c, u32 id, u32 cseq, int code)
+{
+    // Control/Setting 类 Rp* 包体均为 Result
+    rpc::Result res;
+    memset(&res, 0, sizeof(res));
+    res.code = (u32)code;
+
+    if (c->format == FORMAT_COMPACT) {
+        // 紧凑编码下成功应答不带描述文字，由客户端按 code 查表
+        if (code != ECCS_SUCCESS) {
+            strncpy(res.msg, ECCS_GetErrorStr((ECCS_Error)code), sizeof(res.msg) - 1);
+        }
+
+        u8 body[sizeof(rpc::Result) + 16];
+        rpc::CompactWriter w(body, sizeof(body));
+        rpc::CompactCodec<rpc::Result>::Write(w, res);
+
+        rpc::AppendCompactFrame(c->out, c->version, id, cseq, body, (u32)w.Size());
+    }
+    else {
+        strncpy(res.msg, ECCS_GetErrorStr((ECCS_Error)code), sizeof(res.msg) - 1);
+
+        rpc::PacketHeader hdr;
+        hdr.id = id;
+        hdr.bodyLen = sizeof(rpc::Result);
+        hdr.cseq = cseq;
+
+        c->out.push_back((const char*)&hdr, sizeof(hdr));
+        c->out.push_back((const char*)&res, sizeof(res));
+    }
+    ++m_replies;
+}
+
+void RpcGateway::DrainOutbox()
+{
+    m_batch.clear();
+    {
+        std::lock_guard<std::mutex> lock(m_outboxMutex);
+        m_batch.swap(m_outbox);
+    }
+    if (m_batch.empty()) return;
+
+    m_pushes += m_batch.size();
+
+    // 先复制快照：发送失败或积压会关闭客户端 (快照容器复用，稳定后不再分配)
+    std::vector<Client_Ptr>& clients = m_snapshot;
+    clients.clear();
+    for (auto& kv : m_clients) clients.push_back(kv.second);
+
+    // 本批需要的编码
+    bool needFixed = false;
+    bool needVersion[rpc::COMPACT_VERSION + 1] = { false };
+    for (auto& c : clients) {
+        if (c->format == FORMAT_COMPACT) needVersion[c->version] = true;
+        else needFixed = true;
+    }
+
+    // 整批编码，同一编码的客户端共用 (定长帧片段指向 m_batch 持有的包对象)
+    size_t total = 0;
+    m_iov.clear();
+    if (needFixed) {
+        m_iov.resize(m_batch.size() * 2);
+        size_t n = 0;
+        for (auto& pkt : m_batch) {
+            int k = pkt->EncodeIov(&m_iov[n]);
+            for (int i = 0; i < k; ++i) total += m_iov[n + i].iov_len;
+            n += k;
+        }
+        m_iov.resize(n);
+    }
+
+    rpc::IoVec compactIov[rpc::COMPACT_VERSION + 1];
+    for (u8 v = 1; v <= rpc::COMPACT_VERSION; ++v) {
+        Buffer& b = m_compactBatch[v];
+        b.clear();
+        if (!needVersion[v]) continue;
+        for (auto& pkt : m_batch) pkt->EncodeCompact(b, v);
+        compactIov[v].iov_base = b.buf();
+        compactIov[v].iov_len = b.size();
+    }
+
+    for (auto& c : clients) {
+        if (c->format == FORMAT_COMPACT) {
+            Buffer& b = m_compactBatch[c->version];
+            if (b.size() > 0) SendBatch(c, &compactIov[c->version], 1, b.size());
+        }
+        else {
+            SendBatch(c, m_iov.data(), m_iov.size(), total);
+        }
+    }
+    clients.clear();    // 不延长已关闭客户端的生命周期
+}
+
+void RpcGateway::SendBatch(Client_Ptr& c, rpc::IoVec* iov, size_t cnt, size_t total)
+{
+    // 已有积压时必须排在其后
+    if (c->out.size() > 0) {
+        AppendIov(c->out, iov, cnt, 0);
+        Flush(c);
+        return;
+    }
+
+    HD_SOCKET fd = c->sock->socket();
+    size_t sent = 0, first = 0;
+    while (first < cnt) {
+        int k = (int)std::min(cnt - first, (size_t)IOV_MAX);
+        size_t chunk = 0;
+        for (int i = 0; i < k; ++i) chunk += iov[first + i].iov_len;
+
+        HD_SSIZET r = SendIov(fd, &iov[first], k);
+        if (r < 0) {
+            if (!WouldBlock(HD_GET_SOCKET_ERROR)) {
+                CloseClient(fd);
+                return;
+            }
+            r = 0;
+        }
+        sent += (size_t)r;
+        if ((size_t)r < chunk) break;
+        first += k;
+    }
+
+    // 发不完的部分才拷贝进发送缓冲，等待可写事件
+    if (sent < total) {
+        AppendIov(c->out, iov, cnt, sent);
+        Flush(c);
+    }
+}
+
+void RpcGateway::Flush(Client_Ptr& c)
+{
+    HD_SOCKET fd = c->sock->socket();
+
+    while (c->out.size() > 0) {
+        HD_SSIZET n = send(fd, c->out.buf(), (int)c->out.size(), MSG_NOSIGNAL);
+        if (n > 0) {
+            c->out.pop_front((size_t)n);
+            continue;
+        }
+        int e = HD_GET_SOCKET_ERROR;
+        if (n < 0 && WouldBlock(e)) break;
+        CloseClient(fd);
+        return;
+    }
+
+    if (c->out.size() > MAX_PENDING_OUT) {
+        ++m_dropped;
+        LOG_WARNING("[Gateway] Client %s too slow (%u bytes pending), disconnect",
+            c->sock->peerAddress().c_str(), (u32)c->out.size());
+        CloseClient(fd);
+        return;
+    }
+
+    // 有积压时关注可写事件，发完后取消
+    bool want = c->out.size() > 0;
+    if (want != c->wantWrite) {
+        c->wantWrite = want;
+        m_poller->Modify(fd, want);
+    }
+}
+
+
+ECCS_END
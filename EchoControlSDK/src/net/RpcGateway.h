@@ -0,0 +1,127 @@
+#pragma once
+#include "../global.h"
+#include "TCPServer.h"
+#include "../protocol/PacketView.hpp"
+#include "../utils/buffer.h"
+#include <atomic>
+#include <functional>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+ECCS_BEGIN
+
+//------------------------------------------------------
+// RpcGateway: 远程控制网关
+// * 以 PacketHeader 分帧接收远程客户端的 Rq* 包，帧在接收缓冲上以 RawPacketView 解析，
+//   路由函数确认目标设备可用后才 Materialize 成包对象投递到设备
+// * Control/Setting 类请求立即回 Rp* 应答 (Result，cseq 与请求相同)；
+//   Query 类请求不单独应答，结果随 Ow* 推送返回
+// * Publish 把设备推送的 Ow* 包广播给所有客户端: 包不预先编码，
+//   事件循环按 EncodeIov 片段对每个客户端一次 sendmsg 发出整批，只有发不完的部分才拷贝进发送缓冲
+// * 每个连接按首帧协商编码: 定长帧 (旧客户端) 或紧凑帧 (CompactCodec.h)，
+//   该连接之后的应答与推送都使用同一编码，中途切换视为帧错误
+// * 单线程事件循环: Linux 使用 epoll，其它平台使用 poll
+//------------------------------------------------------
+
+class RpcGateway
+{
+    NON_COPYABLE(RpcGateway);
+
+public:
+    // 路由函数: 把请求投递到设备，返回 ECCS_Error (包体无法解码时返回 ECCS_ERR_INVALID_PARAM)
+    // view 只在调用期间有效，需要保留时用 view.Materialize()
+    using RouteFunc = std::function<int(const rpc::RawPacketView&)>;
+
+    struct Stats {
+        u64 requests;       // 收到的请求数
+        u64 replies;        // 发出的应答数
+        u64 pushes;         // 广播的推送包数
+        u64 badFrames;      // 帧头错误/解码失败
+        u64 dropped;        // 因发送积压断开的客户端数
+        u32 clients;        // 当前连接数
+        u32 compactClients; // 其中使用紧凑编码的连接数
+    };
+
+    static const u32 MAX_BODY_LEN = 64 * 1024;
+    static const u32 MAX_PENDING_OUT = 1024 * 1024;   // 单客户端发送积压上限
+    static const int MAX_CLIENTS = 256;
+
+    explicit RpcGateway(RouteFunc route);
+    ~RpcGateway();
+
+    // 监听并启动事件循环 (port = 0 时由系统分配，可用 Port() 查询)
+    bool Start(int port, const str& addr = "");
+    void Stop();
+
+    bool IsRunning() const { return m_running; }
+    int Port() const { return m_server ? m_server->port() : 0; }
+
+    // 广播推送包 (可在任意线程调用；发布后不得再修改 pkt)
+    void Publish(std::shared_ptr<rpc::RpcPacket> pkt);
+
+    Stats GetStats() const;
+
+private:
+    enum WireFormat : u8 {
+        FORMAT_UNKNOWN = 0,     // 尚未收到首帧，推送按定长帧发送
+        FORMAT_FIXED,
+        FORMAT_COMPACT,
+    };
+
+    struct Client {
+        TcpSocket_Ptr sock;
+        Buffer in;          // 未成帧的接收数据
+        Buffer out;         // 待发送数据
+        bool wantWrite;
+        WireFormat format;
+        u8 version;         // 紧凑编码版本 (首帧决定)
+    };
+    using Client_Ptr = std::shared_ptr<Client>;
+
+    class Poller;
+
+    void Loop();
+    void AcceptAll();
+    void OnReadable(Client_Ptr& c);
+    bool OnWritable(Client_Ptr& c);
+    void HandleFrames(Client_Ptr& c);
+    void HandleRequest(Client_Ptr& c, const rpc::RawPacketView& view);
+    void Reply(Client_Ptr& c, u32 id, u32 cseq, int code);
+    void DrainOutbox();
+    void SendBatch(Client_Ptr& c, rpc::IoVec* iov, size_t cnt, size_t total);
+    void Flush(Client_Ptr& c);
+    void CloseClient(HD_SOCKET fd);
+
+private:
+    RouteFunc m_route;
+    TcpServer_Ptr m_server;
+    HD_SOCKET m_listenFd;
+    HD_SOCKET m_wakeReader;     // Publish/Stop 唤醒事件循环
+    HD_SOCKET m_wakeWriter;     // 由 m_outboxMutex 保护
+
+    std::thread* m_thread;
+    std::atomic<bool> m_running;
+    std::unique_ptr<Poller> m_poller;
+    std::map<HD_SOCKET, Client_Ptr> m_clients;  // 只在事件循环线程中访问
+    std::vector<Client_Ptr> m_snapshot;         // 推送时的客户端快照
+
+    // 跨线程推送队列
+    std::mutex m_outboxMutex;
+    std::vector<std::shared_ptr<rpc::RpcPacket>> m_outbox;
+    std::vector<std::shared_ptr<rpc::RpcPacket>> m_batch;   // 只在事件循环线程中使用
+    std::vector<rpc::IoVec> m_iov;                          // 本批推送的编码片段 (定长帧)
+    Buffer m_compactBatch[rpc::COMPACT_VERSION + 1];        // 本批推送的紧凑编码 (按版本)
+
+    std::atomic<u64> m_requests;
+    std::atomic<u64> m_replies;
+    std::atomic<u64> m_pushes;
+    std::atomic<u64> m_badFrames;
+    std::atomic<u64> m_dropped;
+    std::atomic<u32> m_clientCount;
+    std::atomic<u32> m_compactCount;
+};
+
+ECCS_END
@@ -167,29 +167,29 @@ private:
 // Utilities
 //------------------------------------------------------
 /**
- * @brief IsValidPort ж϶˿Ƿ
- * @param portҪжϵĶ˿ں
- * @return True  False
+ * @brief IsValidPort 判断端口是否可用
+ * @param port：需要判断的端口号
+ * @return True：可用 ， False：不可用
  */
 bool IsValidPort(int port);
 /**
- * @brief IsValidSockAddr жϵַǷ
- * @param addrҪжϵip
- * @return True  False
+ * @brief IsValidSockAddr 判断地址是否可用
+ * @param addr：需要判断的ip
+ * @return True：可用 ， False：不可用
  */
 bool IsValidSockAddr(str addr);
 /**
- * @brief Equal жַǷͬ
- * @param addr0 жϵĵַ1
- * @param addr1 жϵĵַ2
- * @return TrueͬFalseͬ
+ * @brief Equal 判断两个地址是否相同
+ * @param addr0 ：待判断的地址1
+ * @param addr1 ：待判断的地址2
+ * @return True：相同，False：不同
  */
 bool Equal(const sockaddr& addr0, const sockaddr& addr1);
 bool operator==(const sockaddr& addr0, const sockaddr& addr1);
 /**
- * @brief StrSockAddr ipַַ
- * @param addripַ
- * @return ַ
+ * @brief StrSockAddr ip地址输出成字符串
+ * @param addr：待输出的ip地址
+ * @return 输出字符串
  */
 str StrSockAddr(const sockaddr& addr);
 
@@ -1,4 +1,4 @@
-﻿
+
 #include "tcpserver.h"
 #include <string.h>
 #include "../debug/exceptions.h"
@@ -868,26 +868,26 @@ again:
 
         // falling through means there is something to recv and it cannot block
     }
-    //ܰMIN_PACKET_LENֽʱڷдʱ˷ְ˶ʱҪӦ
+    //当待接受包大于MIN_PACKET_LEN字节时，由于服务写包时进行了分包，因此读包时需要做对应操作
     if (len > MIN_PACKET_LEN)
     {
-        //bufдλָʾ
+        //buf写入位置指示器
         int index = 0;
-        //123ֽڴСʣ
+        //计算最后不足123个字节大小的剩余包长度
         u32 _packet_left_len = len % (MAX_PATCH_LEN - 5);
-        //ְ(ѭְ)
+        //计算分包个数(循环分包次数)
         u32 _loop_times;
         (_packet_left_len == 0) ? (_loop_times = len / (MAX_PATCH_LEN - 5)) : (_loop_times = len / (MAX_PATCH_LEN - 5) + 1);
-        std::shared_ptr<char> sp(new char[MAX_PATCH_LEN]);
-        char* precv = sp.get();
+        BufferPool::Lease lease = BufferPool::Instance().Acquire(MAX_PATCH_LEN);
+        char* precv = (char*)lease.Data();
         for (int i = 0; i < _loop_times; i++)
         {
             if (0 == i)
             {
                 int offset = MAX_PATCH_LEN - MinPacketLen;
-                //RPCReadPackageжͷ˵һζMinPacketLen
+                //由于RPCReadPackage中读过包头，因此第一次读包需跳过MinPacketLen
                 iRet = recv(_sock, precv, offset, 0);
-                //жϰβǷзְ־λӶжǷΪȴ128İķְ
+                //判断包尾是否有分包标志位，从而判断这个包是否为长度大于128的包的分包
                 if (iRet < 0)
                 {
                     int e = HD_GET_SOCKET_ERROR;
@@ -900,7 +900,7 @@ again:
                         // check if this is the lack of resources or timeout case
                         if (et->uelapsed() < eagainThresholdMicros) {
                             if (++retries <= _maxRetries) {
-                                LOG_INFO("TcpSocket::read  eagainThresholMicros : %d, retries : %d, maxRetries : %d", eagainThresholdMicros, retries, _maxRetries)
+                                LOG_INFO("TcpSocket::read ： eagainThresholMicros : %d, retries : %d, maxRetries : %d", eagainThresholdMicros, retries, _maxRetries)
                                     msleep(20);
                                 goto again;
                             }
@@ -930,7 +930,7 @@ again:
                     'S' == *(precv + offset - 2) && \
                     '$' == *(precv + offset - 1))
                 {
-                    //ðǷְм
+                    //该包是分包的中间包
                     memcpy(buf, precv, offset - 5);
                     index += offset - 5;
                     LOG_INFO("TcpSocket::read : get depatched Packet Middle, len = %d, index size = %d", len, index)
@@ -962,7 +962,7 @@ again:
                         // check if this is the lack of resources or timeout case
                         if (et->uelapsed() < eagainThresholdMicros) {
                             if (++retries <= _maxRetries) {
-                                LOG_INFO("TcpSocket::read  eagainThresholMicros : %d, retries : %d, maxRetries : %d", eagainThresholdMicros, retries, _maxRetries)
+                                LOG_INFO("TcpSocket::read ： eagainThresholMicros : %d, retries : %d, maxRetries : %d", eagainThresholdMicros, retries, _maxRetries)
                                     msleep(20);
                                 goto again;
                             }
@@ -992,7 +992,7 @@ again:
                     'd' == *(precv + _packet_left_len + 3) && \
                     '$' == *(precv + _packet_left_len + 4))
                 {
-                    //ðǷְ
+                    //该包是分包结束包
                     memcpy(buf + index, precv, _packet_left_len);
                     index += _packet_left_len;
                     LOG_INFO("TcpSocket::read : get depatched Packet End, len = %d, index size = %d", len, index)
@@ -1007,7 +1007,7 @@ again:
             }
             else {
                 iRet = recv(_sock, precv, MAX_PATCH_LEN, 0);
-                //жϰβǷзְ־λӶжǷΪȴ128İķְ
+                //判断包尾是否有分包标志位，从而判断这个包是否为长度大于128的包的分包
                 if (iRet < 0)
                 {
                     int e = HD_GET_SOCKET_ERROR;
@@ -1020,7 +1020,7 @@ again:
                         // check if this is the lack of resources or timeout case
                         if (et->uelapsed() < eagainThresholdMicros) {
                             if (++retries <= _maxRetries) {
-                                LOG_INFO("TcpSocket::read  eagainThresholMicros : %d, retries : %d, maxRetries : %d", eagainThresholdMicros, retries, _maxRetries)
+                                LOG_INFO("TcpSocket::read ： eagainThresholMicros : %d, retries : %d, maxRetries : %d", eagainThresholdMicros, retries, _maxRetries)
                                     msleep(20);
                                 goto again;
                             }
@@ -1050,7 +1050,7 @@ again:
                     'S' == *(precv + MAX_PATCH_LEN - 2) && \
                     '$' == *(precv + MAX_PATCH_LEN - 1))
                 {
-                    //ðǷְм
+                    //该包是分包的中间包
                     memcpy(buf + index, precv, MAX_PATCH_LEN - 5);
                     LOG_INFO("TcpSocket::read signature:%d, %d, %d, %d, %d", *(precv + MAX_PATCH_LEN - 5), *(precv + MAX_PATCH_LEN - 4), *(precv + MAX_PATCH_LEN - 3), *(precv + MAX_PATCH_LEN - 2), *(precv + MAX_PATCH_LEN - 1))
                         index += (MAX_PATCH_LEN - 5);
@@ -1065,7 +1065,7 @@ again:
                     'd' == *(precv + MAX_PATCH_LEN - 2) && \
                     '$' == *(precv + MAX_PATCH_LEN - 1))
                 {
-                    //ðǷְ
+                    //该包是分包结束包
                     memcpy(buf + index, precv, MAX_PATCH_LEN - 5);
                     index += MAX_PATCH_LEN - 5;
                     //LOG_INFO("TcpSocket::read : get depatched Packet End, len = %d, buf size = %d, index = %d",len,strlen((char*)buf),index);
@@ -1096,7 +1096,7 @@ again:
                 // check if this is the lack of resources or timeout case
                 if (et->uelapsed() < eagainThresholdMicros) {
                     if (++retries <= _maxRetries) {
-                        LOG_INFO("TcpSocket::read  eagainThresholMicros : %d, retries : %d, maxRetries : %d", eagainThresholdMicros, retries, _maxRetries)
+                        LOG_INFO("TcpSocket::read ： eagainThresholMicros : %d, retries : %d, maxRetries : %d", eagainThresholdMicros, retries, _maxRetries)
                             msleep(20);
                         goto again;
                     }
@@ -1142,11 +1142,11 @@ u32 TcpSocket::writePartial(const u8* buf, u32 len)
 #endif
     if (len > MIN_PACKET_LEN && len < 1500)
     {
-        //СMIN_PACKET_LENֽʱзְ
+        //当待发包大小超过MIN_PACKET_LEN字节时，进行分包操作
         const u8* pos = buf;
-        //MAX_PATCH_LEN-5ֽڴСʣ
+        //计算最后不足MAX_PATCH_LEN-5个字节大小的剩余包长度
         u32 _packet_left_len = len % (MAX_PATCH_LEN - 5);
-        //ְ(ѭְ)
+        //计算分包个数(循环分包次数)
         u32 _loop_times;
         (_packet_left_len == 0) ? (_loop_times = len / (MAX_PATCH_LEN - 5)) : (_loop_times = len / (MAX_PATCH_LEN - 5) + 1);
         std::shared_ptr<u8> sp(new u8[MAX_PATCH_LEN]);
@@ -1164,14 +1164,14 @@ u32 TcpSocket::writePartial(const u8* buf, u32 len)
                 u8* final_buf = sp2.get();
                 memcpy(final_buf, pos, _packet_left_len);
                 //LOG_INFO("len = %d , _packet_left_len = %d, packet end = %d,%d",len,_packet_left_len,*(final_buf+_packet_left_len-1),*(final_buf+_packet_left_len))
-                //ڷְβϼַУ
+                //在分包包尾加上简单字符校验
                 memset(final_buf + _packet_left_len, '$', 1);
                 memset(final_buf + _packet_left_len + 1, 'E', 1);
                 memset(final_buf + _packet_left_len + 2, 'n', 1);
                 memset(final_buf + _packet_left_len + 3, 'd', 1);
                 memset(final_buf + _packet_left_len + 4, '$', 1);
                 //LOG_INFO("TcpSocket::writePartial patch signature: %d, %d, %d, %d, %d",*(final_buf+_packet_left_len),*(final_buf+_packet_left_len+1),*(final_buf+_packet_left_len+2),*(final_buf+_packet_left_len+3),*(final_buf+_packet_left_len+4))
-                //tcp
+                //tcp发送
                 iRet = send(_sock, (const char*)final_buf, _packet_left_len + 5, flags);
 #if RPC_DEBUG_LOG & 0x0010
                 LOG_INFO("TcpSocket::writePartial send patch packet, len = %d byte", _packet_left_len + 5)
@@ -1188,7 +1188,7 @@ u32 TcpSocket::writePartial(const u8* buf, u32 len)
                 if (iRet == 0 && len != 0) {
                     throw ESocketError("TcpSocket::writePartial() send() 0 byte sent");
                 }
-                //ǰʹ̨ͻ240 byte100msʱֹ̨䶪
+                //当前低带宽电台发送缓存上限240 byte，发送设置100ms延时防止电台传输丢包
                 msleep(100);
                 _byte_sent += iRet;
             }
@@ -1196,14 +1196,14 @@ u32 TcpSocket::writePartial(const u8* buf, u32 len)
             {
                 memcpy(patch_buf, pos, MAX_PATCH_LEN - 5);
                 pos += MAX_PATCH_LEN - 5;
-                //ڷְβϼַУ
+                //在分包包尾加上简单字符校验
                 memset(patch_buf + MAX_PATCH_LEN - 5, '$', 1);
                 memset(patch_buf + MAX_PATCH_LEN - 4, 'M', 1);
                 memset(patch_buf + MAX_PATCH_LEN - 3, 'M', 1);
                 memset(patch_buf + MAX_PATCH_LEN - 2, 'S', 1);
                 memset(patch_buf + MAX_PATCH_LEN - 1, '$', 1);
                 //LOG_INFO("TcpSocket::writePartial patch signature: %d, %d, %d, %d, %d",*(patch_buf+123),*(patch_buf+123+1),*(patch_buf+123+2),*(patch_buf+123+3),*(patch_buf+123+4))
-                //
+                //发送
                 iRet = send(_sock, (const char*)patch_buf, MAX_PATCH_LEN, flags);
 #if RPC_DEBUG_LOG & 0x0010
                 LOG_INFO("TcpSocket::writePartial send patch packet, len = %d byte", MAX_PATCH_LEN - 5)
@@ -1221,7 +1221,7 @@ u32 TcpSocket::writePartial(const u8* buf, u32 len)
                     throw ESocketError("TcpSocket::writePartial() send() 0 byte sent");
                 }
                 _byte_sent += iRet;
-                //ǰʹ̨ͻ240 byte100msʱֹ̨䶪
+                //当前低带宽电台发送缓存上限240 byte，发送设置100ms延时防止电台传输丢包
                 msleep(100);
             }
         }
@@ -1242,7 +1242,7 @@ u32 TcpSocket::writePartial(const u8* buf, u32 len)
         if (iRet == 0 && len != 0) {
             throw ESocketError("TcpSocket::writePartial() send() 0 byte sent");
         }
-        //ǰʹ̨ͻ240 byte100msʱֹ̨䶪
+        //当前低带宽电台发送缓存上限240 byte，发送设置100ms延时防止电台传输丢包
         msleep(80);
         return iRet;
     }
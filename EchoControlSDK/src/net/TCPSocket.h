@@ -25,9 +25,9 @@ class TcpSocket
     NON_COPYABLE(TcpSocket);
 
 public:
-    //ÿְĳ
+    //每个分包的长度
     static const int MAX_PATCH_LEN = 400;
-    //ҪзְСС
+    //需要进行分包操作的最小包大小
     static const int MIN_PACKET_LEN = 512;
     TcpSocket(str host, int port);
     TcpSocket(HD_SOCKET sock, std::shared_ptr<HD_SOCKET> interrupt = NULL);
@@ -73,11 +73,11 @@ public:
 
     u32 read(u8* buf, u32 len);
     /**
-     * @brief readƫȡְrpc
-     * @param buf:
-     * @param len:
-     * @param MinPacketLenƫΪRPCİͷ
-     * @return ȡֽ
+     * @brief read：根据偏移量读取分包传输的rpc包
+     * @param buf:读缓冲
+     * @param len:缓冲区长度
+     * @param MinPacketLen：缓冲区偏移量，含义为RPC包的包头长度
+     * @return 读取的字节数
      */
     u32 read(u8* buf, u32 len, u32 MinPacketLen);
     u32 writePartial(const u8* buf, u32 len);
@@ -1,6 +1,7 @@
 
 #include "UDPSocket.h"
 #include <string.h>
+#include <utility>
 #include "../debug/exceptions.h"
 #include "../debug/str_error.h"
 #include "../time/elapsed_timer.h"
@@ -636,6 +637,96 @@ again:
 
     return iRet;
 }
+int UdpSocket::readBatch(u8** bufs, u32* lens, int count)
+{
+    if (_sock == HD_INVALID_SOCKET) {
+        throw EInvalidOperation("UdpSocket::readBatch() read on a non-open socket");
+    }
+    if (count <= 0) {
+        return 0;
+    }
+
+#ifdef __linux
+    // 预留在栈上，避免每次调用分配
+    const int MAX_BATCH = 64;
+    if (count > MAX_BATCH) count = MAX_BATCH;
+
+    mmsghdr msgs[MAX_BATCH];
+    iovec iovs[MAX_BATCH];
+    sockaddr_storage addrs[MAX_BATCH];
+    memset(msgs, 0, sizeof(mmsghdr) * count);
+    for (int i = 0; i < count; ++i) {
+        iovs[i].iov_base = bufs[i];
+        iovs[i].iov_len = lens[i];
+        msgs[i].msg_hdr.msg_iov = &iovs[i];
+        msgs[i].msg_hdr.msg_iovlen = 1;
+        msgs[i].msg_hdr.msg_name = &addrs[i];
+        msgs[i].msg_hdr.msg_namelen = sizeof(sockaddr_storage);
+    }
+
+    int retries = 0;
+    int n = 0;
+    while (true) {
+        // MSG_WAITFORONE: 第一个报文按 SO_RCVTIMEO 阻塞，之后不再等待
+        n = recvmmsg(_sock, msgs, count, MSG_WAITFORONE, NULL);
+        if (n >= 0) break;
+
+        int e = HD_GET_SOCKET_ERROR;
+        if (e == HD_EINTR && ++retries <= _retryLimit) {
+            continue;
+        }
+        if (e == HD_EAGAIN || e == HD_ETIMEDOUT) {
+            throw ETimeout("UdpSocket::readBatch() recvmmsg() timeout");
+        }
+        throw ESocketError("UdpSocket::readBatch() recvmmsg()", e);
+    }
+
+    // 过滤并压缩结果
+    int out = 0;
+    for (int i = 0; i < n; ++i) {
+        const sockaddr* from = (const sockaddr*)&addrs[i];
+        if (_filter) {
+            auto* cachedAddr = cachedRemoteAddress(NULL);
+            if (cachedAddr && !Equal(*from, *cachedAddr)) {
+                continue;
+            }
+        }
+        else {
+            setCachedRemoteAddress(from, msgs[i].msg_hdr.msg_namelen);
+        }
+        if (out != i) {
+            std::swap(bufs[out], bufs[i]);
+            std::swap(lens[out], lens[i]);
+        }
+        lens[out] = msgs[i].msg_len;
+        ++out;
+    }
+    return out;
+#else
+    // 第一个报文按超时阻塞，其余仅取已到达的
+    int out = 0;
+    int len = read(bufs[0], lens[0]);
+    if (len > 0) {
+        lens[out++] = (u32)len;
+    }
+
+    while (out < count) {
+        HD_POLLFD fds[1];
+        memset(fds, 0, sizeof(fds));
+        fds[0].fd = _sock;
+        fds[0].events = HD_POLLIN;
+        if (HD_POLL(fds, 1, 0) <= 0) {
+            break;
+        }
+
+        len = read(bufs[out], lens[out]);
+        if (len > 0) {
+            lens[out++] = (u32)len;
+        }
+    }
+    return out;
+#endif
+}
 u32 UdpSocket::writePartial(const u8* buf, u32 len)
 {
     if (_sock == HD_INVALID_SOCKET) {
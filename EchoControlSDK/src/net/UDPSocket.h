@@ -51,6 +51,10 @@ public:
     u32 available();  // last datagram length
 
     int read(u8* buf, u32 len);
+    // 批量接收: 阻塞等待至少一个报文 (受 RecvTimeout 限制)，再取走已到达的报文
+    // bufs[i] 容量为 lens[i]，返回后 lens[i] 为报文长度；返回报文个数
+    // Linux 使用 recvmmsg 一次系统调用完成，其他平台逐个 recvfrom
+    int readBatch(u8** bufs, u32* lens, int count);
     u32 writePartial(const u8* buf, u32 len);
     void write(const u8* buf, u32 len);
 
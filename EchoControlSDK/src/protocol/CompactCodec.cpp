@@ -0,0 +1,83 @@
+#include "CompactCodec.h"
+#include "../utils/checksum.h"
+
+ECCS_BEGIN
+namespace rpc {
+
+// 读取 u32 varint: 1=成功, 0=数据不足, -1=超长或溢出
+static int ReadVarint32(const u8*& p, const u8* end, u32& v)
+{
+    u64 x = 0;
+    for (int i = 0; i < 5; ++i) {
+        if (p >= end) return 0;
+        u8 b = *p++;
+        x |= (u64)(b & 0x7F) << (7 * i);
+        if (!(b & 0x80)) {
+            if (x > 0xFFFFFFFFull) return -1;
+            v = (u32)x;
+            return 1;
+        }
+    }
+    return -1;
+}
+
+CompactParseResult ParseCompactHeader(const u8* buf, size_t len, CompactHeader& hdr)
+{
+    if (len == 0) return COMPACT_NEED_MORE;
+    if (!IsCompactTag(buf[0])) return COMPACT_BAD;
+
+    hdr.version = buf[0] & (u8)~COMPACT_TAG_MASK;
+    if (hdr.version == 0 || hdr.version > COMPACT_VERSION) return COMPACT_BAD;
+
+    const u8* p = buf + 1;
+    const u8* end = buf + len;
+    u32* fields[3] = { &hdr.id, &hdr.cseq, &hdr.bodyLen };
+    for (int i = 0; i < 3; ++i) {
+        int r = ReadVarint32(p, end, *fields[i]);
+        if (r < 0) return COMPACT_BAD;
+        if (r == 0) return COMPACT_NEED_MORE;
+    }
+
+    hdr.headerLen = (u32)(p - buf);
+    return COMPACT_OK;
+}
+
+static inline void PutLE32(u8* out, u32 v)
+{
+    out[0] = v & 0xFF;
+    out[1] = (v >> 8) & 0xFF;
+    out[2] = (v >> 16) & 0xFF;
+    out[3] = (v >> 24) & 0xFF;
+}
+
+void AppendCompactFrame(Buffer& buf, u8 version, u32 id, u32 cseq, const u8* body, u32 bodyLen)
+{
+    u8 hdr[COMPACT_MAX_HEADER];
+    CompactWriter w(hdr, sizeof(hdr));
+    w.PutU8(COMPACT_TAG | version);
+    w.PutVarint(id);
+    w.PutVarint(cseq);
+    w.PutVarint(bodyLen);
+
+    bool crc = version >= COMPACT_VERSION_CRC;
+    buf.reserve(w.Size() + bodyLen + (crc ? COMPACT_CRC_LEN : 0));
+    buf.push_back((const char*)hdr, w.Size());
+    if (bodyLen > 0) buf.push_back((const char*)body, bodyLen);
+
+    if (crc) {
+        u8 tail[COMPACT_CRC_LEN];
+        u32 c = checksum::Crc32C(hdr, w.Size());
+        PutLE32(tail, checksum::Crc32C(body, bodyLen, c));
+        buf.push_back((const char*)tail, sizeof(tail));
+    }
+}
+
+bool CheckCompactCrc(const u8* frame, size_t len)
+{
+    const u8* t = frame + len;
+    u32 expect = (u32)t[0] | ((u32)t[1] << 8) | ((u32)t[2] << 16) | ((u32)t[3] << 24);
+    return checksum::Crc32C(frame, len) == expect;
+}
+
+}
+ECCS_END
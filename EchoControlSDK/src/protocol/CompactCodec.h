@@ -0,0 +1,196 @@
+#pragma once
+#include "../global.h"
+#include "../utils/buffer.h"
+#include <string.h>
+#include <type_traits>
+
+ECCS_BEGIN
+namespace rpc {
+
+    //------------------------------------------------------
+    // 紧凑编码 (按连接协商，用于计流量的低带宽链路)
+    //
+    // 帧格式:
+    //   u8     tag      高 4 位固定 0xC，低 4 位为 schema 版本
+    //   varint id       Packet ID
+    //   varint cseq
+    //   varint bodyLen
+    //   body            由 CompactCodec<TData> 编码
+    //   crc32c          (仅 v2) 覆盖 tag 至包体，4 字节小端
+    //
+    // * 定长帧以 magic 0xEC55AAEE 开头 (小端首字节 0xEE)，与 tag 不冲突，
+    //   网关按每个连接收到的首帧决定该连接使用哪种格式
+    // * 包体: 整数为 varint (有符号数先 zigzag)，字符串为 varint 长度 + 内容 (不含结尾 0)，
+    //   float 保持 4 字节；未特化的数据结构按原始字节写出
+    //------------------------------------------------------
+
+    static const u8 COMPACT_TAG = 0xC0;
+    static const u8 COMPACT_TAG_MASK = 0xF0;
+    static const u8 COMPACT_VERSION_PLAIN = 1;
+    static const u8 COMPACT_VERSION_CRC = 2;        // 帧尾附 CRC32C，用于无可靠传输保证的链路
+    static const u8 COMPACT_VERSION = COMPACT_VERSION_CRC;  // 支持的最高版本
+    static const u32 COMPACT_CRC_LEN = 4;
+
+    // 协商帧: id 为 0、包体为空的紧凑帧。客户端以希望使用的版本发出，网关以同一版本回应；
+    // 只订阅推送的客户端可借此在发请求前切换到紧凑编码
+    static const u32 COMPACT_HELLO_ID = 0;
+
+    // 帧头最大长度: tag + 3 个 u32 varint
+    static const u32 COMPACT_MAX_HEADER = 1 + 3 * 5;
+
+    inline bool IsCompactTag(u8 b) { return (b & COMPACT_TAG_MASK) == COMPACT_TAG; }
+
+    //------------------------------------------------------
+    // CompactWriter: 写入调用方提供的定长缓冲，超出容量时置溢出标志并停止写入
+    //------------------------------------------------------
+    class CompactWriter
+    {
+    public:
+        CompactWriter(u8* buf, size_t capacity) : m_buf(buf), m_cap(capacity), m_len(0), m_overflow(false) {}
+
+        void PutU8(u8 v) {
+            if (m_len >= m_cap) { m_overflow = true; return; }
+            m_buf[m_len++] = v;
+        }
+
+        // 先在栈上编码再整体写入: 只做一次容量检查
+        void PutVarint(u64 v) {
+            u8 tmp[10];
+            size_t n = 0;
+            while (v >= 0x80) {
+                tmp[n++] = (u8)(v | 0x80);
+                v >>= 7;
+            }
+            tmp[n++] = (u8)v;
+            PutBytes(tmp, n);
+        }
+
+        void PutZigZag(i64 v) { PutVarint(((u64)v << 1) ^ (u64)(v >> 63)); }
+
+        void PutBytes(const void* p, size_t n) {
+            if (m_len + n > m_cap) { m_overflow = true; return; }
+            memcpy(m_buf + m_len, p, n);
+            m_len += n;
+        }
+
+        void PutFloat(float v) { PutBytes(&v, sizeof(v)); }
+
+        // 定长字符数组: 只写出到第一个 0 为止
+        void PutString(const char* s, size_t cap) {
+            size_t n = 0;
+            while (n < cap && s[n] != 0) ++n;
+            PutVarint(n);
+            PutBytes(s, n);
+        }
+
+        size_t Size() const { return m_len; }
+        bool Overflow() const { return m_overflow; }
+
+    private:
+        u8*    m_buf;
+        size_t m_cap;
+        size_t m_len;
+        bool   m_overflow;
+    };
+
+    //------------------------------------------------------
+    // CompactReader: 越界或格式错误时置失败标志，之后的读取都返回 0
+    //------------------------------------------------------
+    class CompactReader
+    {
+    public:
+        CompactReader(const u8* data, size_t len) : m_p(data), m_end(data + len), m_ok(true) {}
+
+        u8 GetU8() {
+            if (m_p >= m_end) { m_ok = false; return 0; }
+            return *m_p++;
+        }
+
+        u64 GetVarint() {
+            u64 v = 0;
+            for (int shift = 0; shift < 64; shift += 7) {
+                if (m_p >= m_end) { m_ok = false; return 0; }
+                u8 b = *m_p++;
+                v |= (u64)(b & 0x7F) << shift;
+                if (!(b & 0x80)) return v;
+            }
+            m_ok = false;   // 超过 10 字节
+            return 0;
+        }
+
+        i64 GetZigZag() {
+            u64 v = GetVarint();
+            return (i64)(v >> 1) ^ -(i64)(v & 1);
+        }
+
+        bool GetBytes(void* dst, size_t n) {
+            if ((size_t)(m_end - m_p) < n) { m_ok = false; return false; }
+            memcpy(dst, m_p, n);
+            m_p += n;
+            return true;
+        }
+
+        float GetFloat() {
+            float v = 0;
+            GetBytes(&v, sizeof(v));
+            return v;
+        }
+
+        // 读入定长字符数组 (补 0)，超长视为格式错误
+        void GetString(char* dst, size_t cap) {
+            memset(dst, 0, cap);
+            u64 n = GetVarint();
+            if (!m_ok) return;
+            if (n > cap) { m_ok = false; return; }
+            GetBytes(dst, (size_t)n);
+        }
+
+        bool Ok() const { return m_ok; }
+        size_t Remaining() const { return (size_t)(m_end - m_p); }
+
+    private:
+        const u8* m_p;
+        const u8* m_end;
+        bool m_ok;
+    };
+
+    //------------------------------------------------------
+    // CompactCodec<TData>: 包体数据的紧凑编解码
+    // 默认按原始字节写出 (适用于只有几个 u8 的结构)，含字符串或宽整数的结构在 Packet_Def.h 中特化
+    //------------------------------------------------------
+    template<typename TData>
+    struct CompactCodec {
+        static void Write(CompactWriter& w, const TData& d) {
+            if (!std::is_empty<TData>::value) w.PutBytes(&d, sizeof(TData));
+        }
+        static void Read(CompactReader& r, TData& d) {
+            if (!std::is_empty<TData>::value) r.GetBytes(&d, sizeof(TData));
+        }
+    };
+
+    // 紧凑帧头 (解析结果)
+    struct CompactHeader {
+        u8  version;
+        u32 id;
+        u32 cseq;
+        u32 bodyLen;
+        u32 headerLen;  // 帧头占用的字节数
+    };
+
+    enum CompactParseResult {
+        COMPACT_OK = 0,
+        COMPACT_NEED_MORE,
+        COMPACT_BAD,
+    };
+
+    // 解析帧头 (不要求包体已收全)
+    CompactParseResult ParseCompactHeader(const u8* buf, size_t len, CompactHeader& hdr);
+
+    // 追加整帧 (帧头 + 包体 [+ CRC32C])
+    void AppendCompactFrame(Buffer& buf, u8 version, u32 id, u32 cseq, const u8* body, u32 bodyLen);
+
+    // 校验 v2 帧尾 CRC (frame/len 为不含 CRC 的帧内容)
+    bool CheckCompactCrc(const u8* frame, size_t len);
+
+}
+ECCS_END
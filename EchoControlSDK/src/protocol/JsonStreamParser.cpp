@@ -0,0 +1,308 @@
+#include "JsonStreamParser.h"
+#include <stdlib.h>
+#include <string.h>
+
+ECCS_BEGIN
+
+static const char DELIMITER[] = "\r\n\r\n";
+static const size_t DELIMITER_LEN = 4;
+
+static inline bool IsSpace(char c)
+{
+    return c == ' ' || c == '\t' || c == '\r' || c == '\n';
+}
+
+static int HexValue(char c)
+{
+    if (c >= '0' && c <= '9') return c - '0';
+    if (c >= 'a' && c <= 'f') return c - 'a' + 10;
+    if (c >= 'A' && c <= 'F') return c - 'A' + 10;
+    return -1;
+}
+
+static bool ParseHex4(const char* p, u32& cp)
+{
+    cp = 0;
+    for (int k = 0; k < 4; ++k) {
+        int h = HexValue(p[k]);
+        if (h < 0) return false;
+        cp = (cp << 4) | (u32)h;
+    }
+    return true;
+}
+
+static size_t EncodeUtf8(u32 cp, char* out)
+{
+    if (cp < 0x80) {
+        out[0] = (char)cp;
+        return 1;
+    }
+    if (cp < 0x800) {
+        out[0] = (char)(0xC0 | (cp >> 6));
+        out[1] = (char)(0x80 | (cp & 0x3F));
+        return 2;
+    }
+    if (cp < 0x10000) {
+        out[0] = (char)(0xE0 | (cp >> 12));
+        out[1] = (char)(0x80 | ((cp >> 6) & 0x3F));
+        out[2] = (char)(0x80 | (cp & 0x3F));
+        return 3;
+    }
+    out[0] = (char)(0xF0 | (cp >> 18));
+    out[1] = (char)(0x80 | ((cp >> 12) & 0x3F));
+    out[2] = (char)(0x80 | ((cp >> 6) & 0x3F));
+    out[3] = (char)(0x80 | (cp & 0x3F));
+    return 4;
+}
+
+// p[i] == '"'，原地反转义，成功时 out 指向以 '\0' 结尾的内容，i 移到右引号之后
+// 转义序列的输出总不长于输入，写指针不会超过读指针
+static bool ParseString(char* p, size_t n, size_t& i, const char*& out)
+{
+    size_t r = i + 1, w = r;
+    out = p + r;
+
+    while (r < n) {
+        char c = p[r];
+        if (c == '"') {
+            p[w] = '\0';
+            i = r + 1;
+            return true;
+        }
+        if (c != '\\') {
+            p[w++] = c;
+            ++r;
+            continue;
+        }
+
+        if (r + 1 >= n) return false;
+        char e = p[r + 1];
+        r += 2;
+        switch (e) {
+        case '"':  p[w++] = '"'; break;
+        case '\\': p[w++] = '\\'; break;
+        case '/':  p[w++] = '/'; break;
+        case 'b':  p[w++] = '\b'; break;
+        case 'f':  p[w++] = '\f'; break;
+        case 'n':  p[w++] = '\n'; break;
+        case 'r':  p[w++] = '\r'; break;
+        case 't':  p[w++] = '\t'; break;
+        case 'u': {
+            u32 cp;
+            if (r + 4 > n || !ParseHex4(p + r, cp)) return false;
+            r += 4;
+            // 代理对
+            if (cp >= 0xD800 && cp <= 0xDBFF && r + 6 <= n && p[r] == '\\' && p[r + 1] == 'u') {
+                u32 lo;
+                if (ParseHex4(p + r + 2, lo) && lo >= 0xDC00 && lo <= 0xDFFF) {
+                    cp = 0x10000 + ((cp - 0xD800) << 10) + (lo - 0xDC00);
+                    r += 6;
+                }
+            }
+            w += EncodeUtf8(cp, p + w);
+            break;
+        }
+        default:
+            return false;
+        }
+    }
+    return false;
+}
+
+// 跳过嵌套对象/数组，返回右括号之后的位置 (失败返回 0)
+static size_t SkipNested(const char* p, size_t n, size_t i)
+{
+    int depth = 0;
+    bool inString = false;
+    for (; i < n; ++i) {
+        char c = p[i];
+        if (inString) {
+            if (c == '\\') ++i;
+            else if (c == '"') inString = false;
+            continue;
+        }
+        if (c == '"') inString = true;
+        else if (c == '{' || c == '[') ++depth;
+        else if (c == '}' || c == ']') {
+            if (--depth == 0) return i + 1;
+        }
+    }
+    return 0;
+}
+
+
+bool JsonMessage::Parse(char* p, size_t n)
+{
+    m_count = 0;
+    p[n] = '\0';
+
+    size_t i = 0;
+    while (i < n && IsSpace(p[i])) ++i;
+    if (i >= n || p[i] != '{') return false;
+    ++i;
+
+    for (;;) {
+        while (i < n && IsSpace(p[i])) ++i;
+        if (i >= n) return false;
+        if (p[i] == '}') return true;   // 空对象或末尾
+        if (p[i] != '"') return false;
+
+        const char* key;
+        if (!ParseString(p, n, i, key)) return false;
+
+        while (i < n && IsSpace(p[i])) ++i;
+        if (i >= n || p[i] != ':') return false;
+        ++i;
+        while (i < n && IsSpace(p[i])) ++i;
+        if (i >= n) return false;
+
+        // 值: 字符串原地反转义；其余 (数值/字面量/嵌套) 保留原文，在结尾处写 '\0'
+        const char* value;
+        char term;
+        if (p[i] == '"') {
+            if (!ParseString(p, n, i, value)) return false;
+            term = p[i];
+        }
+        else {
+            size_t s = i;
+            if (p[i] == '{' || p[i] == '[') {
+                i = SkipNested(p, n, i);
+                if (i == 0) return false;
+            }
+            else {
+                while (i < n && p[i] != ',' && p[i] != '}' && !IsSpace(p[i])) ++i;
+            }
+            value = p + s;
+            term = p[i];
+            p[i] = '\0';
+        }
+
+        if (m_count < MAX_FIELDS) {
+            m_fields[m_count].key = key;
+            m_fields[m_count].value = value;
+            ++m_count;
+        }
+
+        // 分隔符 (值结尾处的字符可能已被 '\0' 覆盖，取 term)
+        while (IsSpace(term)) {
+            ++i;
+            term = (i < n) ? p[i] : '\0';
+        }
+        if (term == ',') {
+            ++i;
+            continue;
+        }
+        return term == '}';
+    }
+}
+
+const char* JsonMessage::Get(const char* key) const
+{
+    for (int i = 0; i < m_count; ++i) {
+        if (strcmp(m_fields[i].key, key) == 0) return m_fields[i].value;
+    }
+    return nullptr;
+}
+
+bool JsonMessage::GetInt(const char* key, int& value) const
+{
+    const char* v = Get(key);
+    if (!v || !*v) return false;
+
+    char* end;
+    long n = strtol(v, &end, 10);
+    if (end == v || *end != '\0') return false;
+    value = (int)n;
+    return true;
+}
+
+
+JsonStreamParser::JsonStreamParser(size_t maxMessage, MessageHandler handler)
+    : m_handler(handler), m_buf(maxMessage + 1), m_len(0), m_start(0), m_scan(0),
+      m_discard(false), m_messages(0), m_errors(0)
+{
+}
+
+void JsonStreamParser::Reset()
+{
+    m_len = 0;
+    m_start = 0;
+    m_scan = 0;
+    m_discard = false;
+}
+
+u32 JsonStreamParser::Feed(const u8* data, u32 len)
+{
+    u64 before = m_messages;
+    char* buf = m_buf.data();
+    const size_t cap = m_buf.size() - 1;
+
+    while (len > 0) {
+        if (m_len == cap) {
+            // 缓冲已满且找不到分隔符: 丢弃当前消息，保留末尾 3 字节以识别跨次的分隔符
+            ++m_errors;
+            m_discard = true;
+            memmove(buf, buf + m_len - (DELIMITER_LEN - 1), DELIMITER_LEN - 1);
+            m_len = DELIMITER_LEN - 1;
+            m_start = 0;
+            m_scan = 0;
+        }
+
+        size_t take = cap - m_len;
+        if (take > len) take = len;
+        memcpy(buf + m_len, data, take);
+        m_len += take;
+        data += take;
+        len -= (u32)take;
+
+        // 逐条切分
+        for (;;) {
+            const char* hit = nullptr;
+            size_t pos = m_scan;
+            while (pos + DELIMITER_LEN <= m_len) {
+                const char* cr = (const char*)memchr(buf + pos, '\r', m_len - pos - (DELIMITER_LEN - 1));
+                if (!cr) break;
+                if (memcmp(cr, DELIMITER, DELIMITER_LEN) == 0) {
+                    hit = cr;
+                    break;
+                }
+                pos = (size_t)(cr - buf) + 1;
+            }
+            if (!hit) {
+                m_scan = (m_len > m_start + DELIMITER_LEN - 1) ? m_len - (DELIMITER_LEN - 1) : m_start;
+                break;
+            }
+
+            size_t end = (size_t)(hit - buf);
+            while (m_start < end && IsSpace(buf[m_start])) ++m_start;   // 多余的空行
+            if (m_discard) {
+                m_discard = false;
+            }
+            else if (end > m_start) {
+                JsonMessage msg;
+                if (msg.Parse(buf + m_start, end - m_start)) {
+                    ++m_messages;
+                    if (m_handler) m_handler(msg);
+                }
+                else {
+                    ++m_errors;
+                }
+            }
+            m_start = end + DELIMITER_LEN;
+            m_scan = m_start;
+        }
+
+        // 已处理的消息移出缓冲
+        if (m_start > 0) {
+            m_len -= m_start;
+            if (m_len > 0) memmove(buf, buf + m_start, m_len);
+            m_scan -= m_start;
+            m_start = 0;
+        }
+    }
+
+    return (u32)(m_messages - before);
+}
+
+
+ECCS_END
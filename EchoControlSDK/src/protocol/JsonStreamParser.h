@@ -0,0 +1,84 @@
+#pragma once
+#include "../global.h"
+#include <functional>
+#include <vector>
+
+ECCS_BEGIN
+
+//------------------------------------------------------
+// JsonMessage: 扁平 JSON 对象的字段视图
+// * 在消息缓冲上原地解析: 字符串值原地反转义 (含 \uXXXX -> UTF-8) 并以 '\0' 结尾，不分配内存
+// * 只保留顶层字段；嵌套对象/数组的值保留原文
+// * 字段指针仅在回调期间有效
+//------------------------------------------------------
+
+class JsonMessage
+{
+public:
+    static const int MAX_FIELDS = 32;
+
+    JsonMessage() : m_count(0) {}
+
+    // buf[len] 必须可写 (用于结尾 '\0')
+    bool Parse(char* buf, size_t len);
+
+    // 字段值 (不存在时返回 nullptr)
+    const char* Get(const char* key) const;
+    // 数值字段，"12" 与 12 均可
+    bool GetInt(const char* key, int& value) const;
+
+    int FieldCount() const { return m_count; }
+
+private:
+    struct Field {
+        const char* key;
+        const char* value;
+    };
+    Field m_fields[MAX_FIELDS];
+    int   m_count;
+};
+
+
+//------------------------------------------------------
+// JsonStreamParser: 以 "\r\n\r\n" 分隔的 JSON 消息流式分帧
+// * 接收数据拷贝进预分配的消息缓冲，跨次读取的半条消息保留到下次 Feed
+// * 分隔符扫描从上次结束处继续，不重复扫描
+// * 超过 maxMessage 的消息整条丢弃，直到下一个分隔符后恢复
+//------------------------------------------------------
+
+class JsonStreamParser
+{
+public:
+    using MessageHandler = std::function<void(const JsonMessage& msg)>;
+
+    explicit JsonStreamParser(size_t maxMessage = 8192, MessageHandler handler = nullptr);
+
+    void SetHandler(MessageHandler handler) { m_handler = handler; }
+
+    /**
+     * @brief Feed 输入一段接收数据，回调所有完整且解析成功的消息
+     * @return 本次回调的消息数
+     */
+    u32 Feed(const u8* data, u32 len);
+
+    // 丢弃半条消息 (重连后调用)
+    void Reset();
+
+    // 统计
+    u64 MessageCount() const { return m_messages; }
+    u64 ErrorCount() const { return m_errors; }
+
+private:
+    MessageHandler m_handler;
+    std::vector<char> m_buf;    // 多留 1 字节给 '\0'
+    size_t m_len;               // 已缓存字节数
+    size_t m_start;             // 当前消息起点
+    size_t m_scan;              // 下次分隔符扫描起点
+    bool   m_discard;           // 当前消息超长，丢弃到下一个分隔符
+
+    u64 m_messages;
+    u64 m_errors;
+};
+
+
+ECCS_END
@@ -0,0 +1,153 @@
+#include "JsonWriter.h"
+#include <string.h>
+
+ECCS_BEGIN
+
+
+JsonWriter::JsonWriter(size_t capacity)
+    : m_buf(capacity), m_len(0), m_overflow(false), m_needComma(false), m_afterKey(false)
+{
+}
+
+void JsonWriter::Reset()
+{
+    m_len = 0;
+    m_overflow = false;
+    m_needComma = false;
+    m_afterKey = false;
+}
+
+void JsonWriter::Put(char c)
+{
+    if (m_len < m_buf.size()) {
+        m_buf[m_len++] = c;
+    }
+    else {
+        m_overflow = true;
+    }
+}
+
+void JsonWriter::Put(const char* s, size_t n)
+{
+    if (n > m_buf.size() - m_len) {
+        m_overflow = true;
+        return;
+    }
+    memcpy(&m_buf[m_len], s, n);
+    m_len += n;
+}
+
+void JsonWriter::Separator()
+{
+    if (m_afterKey) {
+        m_afterKey = false;
+    }
+    else if (m_needComma) {
+        Put(',');
+    }
+    m_needComma = true;
+}
+
+JsonWriter& JsonWriter::BeginObject()
+{
+    Separator();
+    Put('{');
+    m_needComma = false;
+    return *this;
+}
+
+JsonWriter& JsonWriter::EndObject()
+{
+    Put('}');
+    m_needComma = true;
+    return *this;
+}
+
+JsonWriter& JsonWriter::Key(const char* key)
+{
+    String(key);
+    Put(':');
+    m_afterKey = true;
+    return *this;
+}
+
+JsonWriter& JsonWriter::String(const char* value)
+{
+    return String(value, value ? strlen(value) : 0);
+}
+
+JsonWriter& JsonWriter::String(const char* value, size_t len)
+{
+    static const char HEX[] = "0123456789abcdef";
+
+    Separator();
+    Put('"');
+
+    // 无需转义的连续片段整段拷贝
+    size_t run = 0;
+    for (size_t i = 0; i < len; ++i) {
+        u8 c = (u8)value[i];
+        if (c >= 0x20 && c != '"' && c != '\\') continue;
+
+        Put(value + run, i - run);
+        run = i + 1;
+
+        switch (c) {
+        case '"':  Put("\\\"", 2); break;
+        case '\\': Put("\\\\", 2); break;
+        case '\n': Put("\\n", 2); break;
+        case '\r': Put("\\r", 2); break;
+        case '\t': Put("\\t", 2); break;
+        case '\b': Put("\\b", 2); break;
+        case '\f': Put("\\f", 2); break;
+        default: {
+            char esc[6] = { '\\', 'u', '0', '0', HEX[c >> 4], HEX[c & 0x0F] };
+            Put(esc, 6);
+            break;
+        }
+        }
+    }
+    Put(value + run, len - run);
+
+    Put('"');
+    return *this;
+}
+
+size_t JsonWriter::FormatInt(i64 value, char* end)
+{
+    // 从缓冲末尾向前写入十进制数字
+    size_t n = 0;
+    u64 v = (value < 0) ? (u64)0 - (u64)value : (u64)value;
+    do {
+        *(end - ++n) = (char)('0' + v % 10);
+        v /= 10;
+    } while (v);
+    if (value < 0) *(end - ++n) = '-';
+    return n;
+}
+
+JsonWriter& JsonWriter::Int(i64 value)
+{
+    char tmp[24];
+    size_t n = FormatInt(value, tmp + sizeof(tmp));
+
+    Separator();
+    Put(tmp + sizeof(tmp) - n, n);
+    return *this;
+}
+
+JsonWriter& JsonWriter::FieldAsString(const char* key, i64 value)
+{
+    char tmp[24];
+    size_t n = FormatInt(value, tmp + sizeof(tmp));
+    return Key(key).String(tmp + sizeof(tmp) - n, n);
+}
+
+JsonWriter& JsonWriter::Raw(const char* data, size_t len)
+{
+    Put(data, len);
+    return *this;
+}
+
+
+ECCS_END
@@ -0,0 +1,58 @@
+#pragma once
+#include "../global.h"
+#include <vector>
+
+ECCS_BEGIN
+
+//------------------------------------------------------
+// JsonWriter: 定长缓冲的 JSON 组包
+// * 缓冲在构造时一次性分配，Reset 后复用，组包过程不再分配内存
+// * 字符串按 JSON 规则转义 (引号/反斜杠/控制字符)，>= 0x80 的字节原样输出 (UTF-8/GBK 均可)
+// * 超出容量时置溢出标志并停止写入，由调用方丢弃本次结果
+//------------------------------------------------------
+
+class JsonWriter
+{
+public:
+    explicit JsonWriter(size_t capacity = 1024);
+
+    void Reset();
+
+    JsonWriter& BeginObject();
+    JsonWriter& EndObject();
+
+    JsonWriter& Key(const char* key);
+    JsonWriter& String(const char* value);
+    JsonWriter& String(const char* value, size_t len);
+    JsonWriter& Int(i64 value);
+
+    // 键值对
+    JsonWriter& Field(const char* key, const char* value) { return Key(key).String(value); }
+    JsonWriter& Field(const char* key, i64 value) { return Key(key).Int(value); }
+    // 数值按字符串输出 (如 "cseq":"12")
+    JsonWriter& FieldAsString(const char* key, i64 value);
+
+    // 原样追加 (如帧分隔符)
+    JsonWriter& Raw(const char* data, size_t len);
+
+    const char* Data() const { return m_buf.data(); }
+    size_t Size() const { return m_len; }
+    bool Overflow() const { return m_overflow; }
+
+private:
+    void Put(char c);
+    void Put(const char* s, size_t n);
+    void Separator();
+    // 十进制格式化到 end 之前 (至少 20 字节)，返回字符数
+    static size_t FormatInt(i64 value, char* end);
+
+private:
+    std::vector<char> m_buf;
+    size_t m_len;
+    bool   m_overflow;
+    bool   m_needComma;     // 当前层级已有成员
+    bool   m_afterKey;      // 刚写完键，下一个值不加逗号
+};
+
+
+ECCS_END
@@ -0,0 +1,151 @@
+#include "ModbusTcpParser.h"
+#include "../utils/checksum.h"
+#include <string.h>
+
+ECCS_BEGIN
+
+
+ModbusTcpParser::ModbusTcpParser(FrameHandler handler)
+    : m_handler(handler), m_framing(FRAMING_TCP), m_pendLen(0), m_frames(0), m_dropped(0), m_badCrc(0)
+{
+}
+
+u32 ModbusTcpParser::Encode(u8* out, u16 tid, u8 unit, u8 func, const u8* pdu, u32 len)
+{
+    u16 length = (u16)(1 + 1 + len);    // Unit 起的后续字节数
+
+    out[0] = (tid >> 8) & 0xFF;
+    out[1] = tid & 0xFF;
+    out[2] = 0x00;                      // Protocol ID 固定为 0
+    out[3] = 0x00;
+    out[4] = (length >> 8) & 0xFF;
+    out[5] = length & 0xFF;
+    out[6] = unit;
+    out[7] = func;
+    if (len > 0) memcpy(out + 8, pdu, len);
+    return MBAP_LEN + 1 + len;
+}
+
+u32 ModbusTcpParser::EncodeRtu(u8* out, u8 unit, u8 func, const u8* pdu, u32 len)
+{
+    out[0] = unit;
+    out[1] = func;
+    if (len > 0) memcpy(out + 2, pdu, len);
+
+    u16 crc = checksum::Crc16Modbus::Compute(out, 2 + len);
+    out[2 + len] = crc & 0xFF;
+    out[3 + len] = (crc >> 8) & 0xFF;
+    return 2 + len + 2;
+}
+
+u32 ModbusTcpParser::ParseRtu(const u8* p, u32 len)
+{
+    if (len < 2) return 0;
+
+    // 应答帧长由功能码决定
+    u32 total;
+    u8 func = p[1];
+    if (func & 0x80) {
+        total = 5;                      // 异常码
+    }
+    else if (func >= 0x01 && func <= 0x04) {
+        if (len < 3) return 0;
+        if (p[2] == 0 || p[2] > MAX_PDU_LEN - 3) {     // 读应答最多 250 字节数据
+            ++m_dropped;
+            return 1;
+        }
+        total = 3 + p[2] + 2;           // ByteCount + 数据
+    }
+    else if (func == 0x05 || func == 0x06 || func == 0x0F || func == 0x10) {
+        total = 8;                      // 写应答: 地址 + 值/数量
+    }
+    else {
+        ++m_dropped;
+        return 1;
+    }
+
+    if (len < total) return 0;
+
+    u16 crc = checksum::Crc16Modbus::Compute(p, total - 2);
+    if ((p[total - 2] | ((u16)p[total - 1] << 8)) != crc) {
+        ++m_badCrc;
+        ++m_dropped;
+        return 1;
+    }
+
+    ++m_frames;
+    if (m_handler) {
+        m_handler(0, p[0], func, p + 2, total - 4);
+    }
+    return total;
+}
+
+u32 ModbusTcpParser::Parse(const u8* p, u32 len)
+{
+    if (m_framing == FRAMING_RTU) return ParseRtu(p, len);
+
+    if (len < 6) {
+        // 长度字段未到，先检查 PID 以便尽早重新同步
+        if (len >= 4 && (p[2] | p[3]) != 0) {
+            ++m_dropped;
+            return 1;
+        }
+        return 0;
+    }
+
+    u32 length = ((u32)p[4] << 8) | p[5];
+    if ((p[2] | p[3]) != 0 || length < 2 || length > MAX_PDU_LEN + 1) {
+        ++m_dropped;
+        return 1;
+    }
+
+    u32 total = 6 + length;
+    if (len < total) return 0;
+
+    ++m_frames;
+    if (m_handler) {
+        m_handler((u16)((p[0] << 8) | p[1]), p[6], p[7], p + 8, length - 2);
+    }
+    return total;
+}
+
+u32 ModbusTcpParser::Feed(const u8* data, u32 len)
+{
+    u64 before = m_frames;
+
+    // 1. 先与上次残留的半帧拼接
+    while (m_pendLen > 0 && len > 0) {
+        u32 take = MAX_ADU_LEN - m_pendLen;
+        if (take > len) take = len;
+        memcpy(m_pend + m_pendLen, data, take);
+        m_pendLen += take;
+        data += take;
+        len -= take;
+
+        u32 off = 0;
+        while (off < m_pendLen) {
+            u32 n = Parse(m_pend + off, m_pendLen - off);
+            if (n == 0) break;
+            off += n;
+        }
+        m_pendLen -= off;
+        if (m_pendLen > 0 && off > 0) memmove(m_pend, m_pend + off, m_pendLen);
+    }
+
+    // 2. 其余数据直接在输入上解析，末尾不完整的部分留待下次
+    while (len > 0) {
+        u32 n = Parse(data, len);
+        if (n == 0) {
+            memcpy(m_pend, data, len);
+            m_pendLen = len;
+            break;
+        }
+        data += n;
+        len -= n;
+    }
+
+    return (u32)(m_frames - before);
+}
+
+
+ECCS_END
@@ -0,0 +1,89 @@
+#pragma once
+#include "../global.h"
+#include <functional>
+
+ECCS_BEGIN
+
+//------------------------------------------------------
+// ModbusTcpParser: Modbus-TCP 应答流式分帧
+// 帧格式: TID(2) PID(2)=0 Length(2) Unit(1) Func(1) Data(Length-2)
+// * 跨次读取的半帧保留在内部，下次 Feed 时拼接；完整帧直接在输入数据上回调，不做拷贝
+// * MBAP 头非法 (PID != 0 或长度越界) 时前移 1 字节重新同步
+// * 只做分帧，事务匹配与功能码解析由驱动在回调中完成
+// * FRAMING_RTU: TCP 透传的 Modbus RTU (串口服务器)，帧格式 Unit(1) Func(1) Data CRC16(2, 低字节在前)
+//   帧长由功能码推出，CRC 错误时前移 1 字节重新同步；RTU 没有事务 ID，回调的 tid 固定为 0
+//   RTU 以帧间静默分帧，读取超时 (线路空闲) 时调用方应 Reset 丢弃残帧
+//------------------------------------------------------
+
+class ModbusTcpParser
+{
+public:
+    static const u32 MBAP_LEN = 7;          // TID + PID + Length + Unit
+    static const u32 MAX_PDU_LEN = 253;     // Func + Data
+    static const u32 MAX_ADU_LEN = MBAP_LEN + MAX_PDU_LEN;
+
+    // func 含异常标志 (0x80)，data/len 为功能码之后的数据
+    using FrameHandler = std::function<void(u16 tid, u8 unit, u8 func, const u8* data, u32 len)>;
+
+    enum Framing {
+        FRAMING_TCP,
+        FRAMING_RTU,
+    };
+
+    explicit ModbusTcpParser(FrameHandler handler = nullptr);
+
+    void SetHandler(FrameHandler handler) { m_handler = handler; }
+
+    // 切换分帧方式 (丢弃半帧)
+    void SetFraming(Framing framing) { m_framing = framing; m_pendLen = 0; }
+    Framing GetFraming() const { return m_framing; }
+
+    /**
+     * @brief Feed 输入一段接收数据，回调所有完整的应答帧
+     * @param data：接收数据
+     * @param len：数据长度 (任意长度)
+     * @return 本次回调的帧数
+     */
+    u32 Feed(const u8* data, u32 len);
+
+    // 丢弃半帧 (重连后调用)
+    void Reset() { m_pendLen = 0; }
+
+    /**
+     * @brief Encode 组请求帧
+     * @param out：输出缓冲 (至少 MBAP_LEN + 1 + len)
+     * @param pdu/len：功能码之后的数据
+     * @return 帧长度
+     */
+    static u32 Encode(u8* out, u16 tid, u8 unit, u8 func, const u8* pdu, u32 len);
+
+    /**
+     * @brief EncodeRtu 组 RTU 请求帧 (附 CRC16)
+     * @param out：输出缓冲 (至少 1 + 1 + len + 2)
+     * @return 帧长度
+     */
+    static u32 EncodeRtu(u8* out, u8 unit, u8 func, const u8* pdu, u32 len);
+
+    // 统计
+    u64 FrameCount() const { return m_frames; }
+    u64 DroppedBytes() const { return m_dropped; }
+    u64 CrcErrors() const { return m_badCrc; }
+
+private:
+    // 从 p 开始解析一帧: 返回消费的字节数 (完整帧或 1 字节垃圾)，0 表示数据不足
+    u32 Parse(const u8* p, u32 len);
+    u32 ParseRtu(const u8* p, u32 len);
+
+private:
+    FrameHandler m_handler;
+    Framing m_framing;
+    u8  m_pend[MAX_ADU_LEN];
+    u32 m_pendLen;
+
+    u64 m_frames;
+    u64 m_dropped;
+    u64 m_badCrc;
+};
+
+
+ECCS_END
@@ -1,5 +1,6 @@
 #pragma once
 #include "RpcPacket.h"
+#include "CompactCodec.h"
 #include <cstring>
 
 ECCS_BEGIN
@@ -11,7 +12,10 @@ namespace rpc {
         const static u32 _FACTORY_ID_ = ID;
         using Data_Type = TData;
 
-        // ƥ factory.hpp Ҫǩ
+        // 包体长度在编译期确定，空数据 (NoneData) 不占包体
+        const static u32 BODY_LEN = std::is_empty<TData>::value ? 0 : sizeof(TData);
+
+        // 必须匹配 factory.hpp 中要求的签名
         static RpcPacket* createInstance() {
             return new Packet<ID, TData>();
         }
@@ -19,25 +23,55 @@ namespace rpc {
         virtual u32 typeId() const override { return ID; }
         virtual const char* typeName() const override { return "Packet"; }
 
-        Packet() { m_header.id = ID; }
-        Packet(const TData& d) : data(d) { m_header.id = ID; }
+        Packet() { m_header.id = ID; m_header.bodyLen = BODY_LEN; }
+        Packet(const TData& d) : data(d) { m_header.id = ID; m_header.bodyLen = BODY_LEN; }
 
         TData data;
 
         virtual bool Encode(Buffer& buf) override {
-            u32 dataSize = std::is_empty<TData>::value ? 0 : sizeof(TData);
-            m_header.bodyLen = dataSize;
+            buf.reserve(sizeof(PacketHeader) + BODY_LEN);   // 一次扩容
             buf.push_back((char*)&m_header, sizeof(PacketHeader));
-            if (dataSize > 0) buf.push_back((char*)&data, dataSize);
+            if (BODY_LEN > 0) buf.push_back((char*)&data, BODY_LEN);
             return true;
         }
 
+        virtual int EncodeIov(IoVec iov[2]) const override {
+            iov[0].iov_base = (void*)&m_header;
+            iov[0].iov_len = sizeof(PacketHeader);
+            if (BODY_LEN == 0) return 1;
+            iov[1].iov_base = (void*)&data;
+            iov[1].iov_len = BODY_LEN;
+            return 2;
+        }
+
         virtual bool Decode(const u8* ptr, u32 len) override {
-            u32 dataSize = std::is_empty<TData>::value ? 0 : sizeof(TData);
-            if (len < dataSize) return false;
-            if (dataSize > 0) memcpy(&data, ptr, dataSize);
+            if (len < BODY_LEN) return false;
+            if (BODY_LEN > 0) memcpy(&data, ptr, BODY_LEN);
+            return true;
+        }
+
+        virtual bool EncodeCompact(Buffer& buf, u8 version) const override {
+            // 空数据直接发空包体，不经过写入缓冲
+            if (BODY_LEN == 0) {
+                AppendCompactFrame(buf, version, ID, m_header.cseq, NULL, 0);
+                return true;
+            }
+
+            // 紧凑包体不会超过定长包体加上每个字段的长度前缀
+            u8 body[BODY_LEN * 2 + 16];
+            CompactWriter w(body, sizeof(body));
+            CompactCodec<TData>::Write(w, data);
+            if (w.Overflow()) return false;
+
+            AppendCompactFrame(buf, version, ID, m_header.cseq, body, (u32)w.Size());
             return true;
         }
+
+        virtual bool DecodeCompact(const u8* ptr, u32 len) override {
+            CompactReader r(ptr, len);
+            CompactCodec<TData>::Read(r, data);
+            return r.Ok();
+        }
     };
 
 }
@@ -0,0 +1,145 @@
+#pragma once
+#include "Packet_Def.h"
+#include <memory>
+#include <type_traits>
+
+ECCS_BEGIN
+namespace rpc {
+
+    static const u32 PACKET_MAGIC = 0xEC55AAEE;
+
+    //------------------------------------------------------
+    // RawPacketView: 接收缓冲上的一帧 (不拥有数据，不拷贝)
+    // * Parse 只校验帧头 (magic 或紧凑 tag / 包体长度 / 数据是否收全)，包体直接指向原缓冲
+    // * 定长帧与紧凑帧 (见 CompactCodec.h) 按首字节区分
+    // * 视图在原缓冲被修改 (pop_front/resize 等) 之前有效；
+    //   需要跨线程或延后处理时用 Materialize 生成独立的包对象
+    //------------------------------------------------------
+    class RawPacketView {
+    public:
+        enum Status {
+            VIEW_OK = 0,
+            VIEW_NEED_MORE,     // 数据不足一帧
+            VIEW_BAD_HEADER,    // magic/tag/版本错误或包体超长，无法重新定位帧边界
+            VIEW_BAD_CRC,       // 紧凑 v2 帧校验失败 (FrameLen 有效，可跳过该帧)
+        };
+
+        RawPacketView() : m_body(NULL), m_id(0), m_seq(0), m_bodyLen(0), m_headerLen(0), m_trailerLen(0), m_version(0) {}
+
+        Status Parse(const u8* buf, size_t len, u32 maxBodyLen = 0xFFFFFFFF) {
+            m_body = NULL;
+            if (len == 0) return VIEW_NEED_MORE;
+
+            if (IsCompactTag(buf[0])) {
+                CompactHeader ch;
+                CompactParseResult r = ParseCompactHeader(buf, len, ch);
+                if (r == COMPACT_NEED_MORE) return VIEW_NEED_MORE;
+                if (r == COMPACT_BAD || ch.bodyLen > maxBodyLen) return VIEW_BAD_HEADER;
+                m_id = ch.id;
+                m_seq = ch.cseq;
+                m_bodyLen = ch.bodyLen;
+                m_headerLen = ch.headerLen;
+                m_trailerLen = (ch.version >= COMPACT_VERSION_CRC) ? COMPACT_CRC_LEN : 0;
+                m_version = ch.version;
+            }
+            else {
+                if (len < sizeof(PacketHeader)) return VIEW_NEED_MORE;
+
+                // PacketHeader 为 1 字节对齐，可直接在任意地址上读取
+                const PacketHeader* hdr = reinterpret_cast<const PacketHeader*>(buf);
+                if (hdr->magic != PACKET_MAGIC || hdr->bodyLen > maxBodyLen) return VIEW_BAD_HEADER;
+                m_id = hdr->id;
+                m_seq = hdr->cseq;
+                m_bodyLen = hdr->bodyLen;
+                m_headerLen = sizeof(PacketHeader);
+                m_trailerLen = 0;
+                m_version = 0;
+            }
+
+            if (len - m_headerLen < (size_t)m_bodyLen + m_trailerLen) return VIEW_NEED_MORE;
+            if (m_trailerLen > 0 && !CheckCompactCrc(buf, m_headerLen + m_bodyLen)) return VIEW_BAD_CRC;
+            m_body = buf + m_headerLen;
+            return VIEW_OK;
+        }
+
+        bool Valid() const { return m_body != NULL; }
+
+        u32 Id() const { return m_id; }
+        u32 Seq() const { return m_seq; }
+        u32 BodyLen() const { return m_bodyLen; }
+        const u8* Body() const { return m_body; }
+        size_t FrameLen() const { return (size_t)m_headerLen + m_bodyLen + m_trailerLen; }
+
+        // 紧凑帧返回 schema 版本，定长帧返回 0
+        bool IsCompact() const { return m_version != 0; }
+        u8 Version() const { return m_version; }
+
+        // 包 ID 是否已在工厂注册
+        bool IsKnown() const { return FACTORY_TYPENAME(m_id, RpcPacket) != NULL; }
+
+        template<typename TPacket>
+        bool Is() const { return Valid() && m_id == TPacket::_FACTORY_ID_; }
+
+        // 生成独立于接收缓冲的包对象，未注册或包体无法解码时返回空
+        std::shared_ptr<RpcPacket> Materialize() const {
+            std::shared_ptr<RpcPacket> pkt(FACTORY_CREATE(m_id, RpcPacket));
+            if (!pkt) return nullptr;
+            bool ok = IsCompact() ? pkt->DecodeCompact(m_body, m_bodyLen) : pkt->Decode(m_body, m_bodyLen);
+            if (!ok) return nullptr;
+            pkt->SetSeq(m_seq);
+            return pkt;
+        }
+
+    private:
+        const u8* m_body;
+        u32 m_id;
+        u32 m_seq;
+        u32 m_bodyLen;
+        u32 m_headerLen;
+        u32 m_trailerLen;
+        u8  m_version;
+    };
+
+    //------------------------------------------------------
+    // PacketView: 按包类型解释 RawPacketView 的包体，直接引用缓冲中的数据
+    // * 包 ID 与 TPacket 不符、包体短于 BODY_LEN 或为紧凑帧 (需解码) 时视图无效
+    // * 数据结构须为 1 字节对齐 (Packet_Def.h 中 pack(1) 的结构体或单字节类型)，
+    //   否则在任意偏移上引用是未定义行为
+    //------------------------------------------------------
+    template<typename TPacket>
+    class PacketView {
+    public:
+        using Data_Type = typename TPacket::Data_Type;
+
+        static_assert(std::alignment_of<Data_Type>::value == 1,
+            "PacketView requires a 1-byte aligned (packed) payload");
+
+        PacketView() : m_data(NULL), m_seq(0) {}
+
+        explicit PacketView(const RawPacketView& raw) : m_data(NULL), m_seq(0) {
+            if (raw.Is<TPacket>() && !raw.IsCompact() && raw.BodyLen() >= TPacket::BODY_LEN) {
+                m_data = reinterpret_cast<const Data_Type*>(raw.Body());
+                m_seq = raw.Seq();
+            }
+        }
+
+        bool Valid() const { return m_data != NULL; }
+
+        const Data_Type& Data() const { return *m_data; }
+        const Data_Type* operator->() const { return m_data; }
+        u32 Seq() const { return m_seq; }
+
+        // 拷贝出独立的包对象
+        std::shared_ptr<TPacket> Materialize() const {
+            auto pkt = std::make_shared<TPacket>(*m_data);
+            pkt->SetSeq(m_seq);
+            return pkt;
+        }
+
+    private:
+        const Data_Type* m_data;
+        u32 m_seq;
+    };
+
+}
+ECCS_END
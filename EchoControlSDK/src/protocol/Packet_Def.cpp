@@ -4,15 +4,89 @@ ECCS_BEGIN
 namespace rpc {
 
     // -------------------------------------------------------------
-    // ע
+    // 紧凑编码特化
     // -------------------------------------------------------------
-    // RpcPacket ǻ࣬u32  Key (Packet ID)
-    // ע˳Ӱ߼鰴ౣ
+
+    void CompactCodec<Result>::Write(CompactWriter& w, const Result& d) {
+        w.PutVarint(d.code);
+        w.PutString(d.msg, sizeof(d.msg));
+    }
+    void CompactCodec<Result>::Read(CompactReader& r, Result& d) {
+        d.code = (u32)r.GetVarint();
+        r.GetString(d.msg, sizeof(d.msg));
+    }
+
+    void CompactCodec<DeviceStatus>::Write(CompactWriter& w, const DeviceStatus& d) {
+        w.PutVarint(d.deviceID);
+        w.PutU8(d.slotID);
+        w.PutU8(d.state);
+        w.PutVarint(d.errorCode);
+        w.PutFloat(d.temperature);
+    }
+    void CompactCodec<DeviceStatus>::Read(CompactReader& r, DeviceStatus& d) {
+        d.deviceID = (u32)r.GetVarint();
+        d.slotID = r.GetU8();
+        d.state = r.GetU8();
+        d.errorCode = (u32)r.GetVarint();
+        d.temperature = r.GetFloat();
+    }
+
+    void CompactCodec<SoundPlayCtrl>::Write(CompactWriter& w, const SoundPlayCtrl& d) {
+        w.PutString(d.filename, sizeof(d.filename));
+        w.PutU8(d.loop);
+    }
+    void CompactCodec<SoundPlayCtrl>::Read(CompactReader& r, SoundPlayCtrl& d) {
+        r.GetString(d.filename, sizeof(d.filename));
+        d.loop = r.GetU8();
+    }
+
+    void CompactCodec<SoundTTSCtrl>::Write(CompactWriter& w, const SoundTTSCtrl& d) {
+        w.PutString(d.text, sizeof(d.text));
+    }
+    void CompactCodec<SoundTTSCtrl>::Read(CompactReader& r, SoundTTSCtrl& d) {
+        r.GetString(d.text, sizeof(d.text));
+    }
+
+    void CompactCodec<PtzTourCtrl>::Write(CompactWriter& w, const PtzTourCtrl& d) {
+        w.PutString(d.steps, sizeof(d.steps));
+    }
+    void CompactCodec<PtzTourCtrl>::Read(CompactReader& r, PtzTourCtrl& d) {
+        r.GetString(d.steps, sizeof(d.steps));
+    }
+
+    void CompactCodec<NetConfig>::Write(CompactWriter& w, const NetConfig& d) {
+        w.PutString(d.ip, sizeof(d.ip));
+        w.PutVarint(d.port);
+    }
+    void CompactCodec<NetConfig>::Read(CompactReader& r, NetConfig& d) {
+        r.GetString(d.ip, sizeof(d.ip));
+        d.port = (u16)r.GetVarint();
+    }
+
+    void CompactCodec<DevName>::Write(CompactWriter& w, const DevName& d) {
+        w.PutString(d.name, sizeof(d.name));
+    }
+    void CompactCodec<DevName>::Read(CompactReader& r, DevName& d) {
+        r.GetString(d.name, sizeof(d.name));
+    }
+
+    void CompactCodec<UltrasonicMask>::Write(CompactWriter& w, const UltrasonicMask& d) {
+        w.PutVarint(d.mask);
+    }
+    void CompactCodec<UltrasonicMask>::Read(CompactReader& r, UltrasonicMask& d) {
+        d.mask = (u32)r.GetVarint();
+    }
+
+    // -------------------------------------------------------------
+    // 工厂注册入口
+    // -------------------------------------------------------------
+    // RpcPacket 是基类，u32 是 Key (Packet ID)
+    // 这里的注册顺序不影响逻辑，但建议按分类保持整洁
 
     FACTORY_BEGIN(u32, RpcPacket)
 
         // #############################################################
-        // CONTROL (ʵʱ)
+        // CONTROL (实时控制)
         // #############################################################
 
         // --- Light Control ---
@@ -22,6 +96,8 @@ namespace rpc {
         FACTORY_ID_APPEND(RpLightLevel, RpcPacket)
         FACTORY_ID_APPEND(RqLightStrobe, RpcPacket)
         FACTORY_ID_APPEND(RpLightStrobe, RpcPacket)
+        FACTORY_ID_APPEND(RqLightRefresh, RpcPacket)
+        FACTORY_ID_APPEND(RpLightRefresh, RpcPacket)
 
         // --- Sound Control ---
         FACTORY_ID_APPEND(RqSoundPlay, RpcPacket)
@@ -40,14 +116,24 @@ namespace rpc {
         FACTORY_ID_APPEND(RpPtzStop, RpcPacket)
         FACTORY_ID_APPEND(RqPtzPreset, RpcPacket)
         FACTORY_ID_APPEND(RpPtzPreset, RpcPacket)
+        FACTORY_ID_APPEND(RqPtzTourStart, RpcPacket)
+        FACTORY_ID_APPEND(RpPtzTourStart, RpcPacket)
+        FACTORY_ID_APPEND(RqPtzTourStop, RpcPacket)
+        FACTORY_ID_APPEND(RpPtzTourStop, RpcPacket)
+        FACTORY_ID_APPEND(RqPtzGoto, RpcPacket)
+        FACTORY_ID_APPEND(RpPtzGoto, RpcPacket)
+        FACTORY_ID_APPEND(RqPtzVelocity, RpcPacket)
+        FACTORY_ID_APPEND(RpPtzVelocity, RpcPacket)
 
         // --- Ultrasonic Control ---
         FACTORY_ID_APPEND(RqUltrasonicSwitch, RpcPacket)
         FACTORY_ID_APPEND(RpUltrasonicSwitch, RpcPacket)
+        FACTORY_ID_APPEND(RqUltrasonicMask, RpcPacket)
+        FACTORY_ID_APPEND(RpUltrasonicMask, RpcPacket)
 
 
         // #############################################################
-        // QUERY (״̬ѯ)
+        // QUERY (状态查询)
         // #############################################################
 
         // --- Light ---
@@ -63,14 +149,14 @@ namespace rpc {
 
 
         // #############################################################
-        // SETTING ()
+        // SETTING (参数配置)
         // #############################################################
 
-        // ͨ
+        // 通用网络配置
         FACTORY_ID_APPEND(RqSetNetConfig, RpcPacket)
         FACTORY_ID_APPEND(RpSetNetConfig, RpcPacket)
 
-        // ͨ豸
+        // 通用设备名称
         FACTORY_ID_APPEND(RqSetDevName, RpcPacket)
         FACTORY_ID_APPEND(RpSetDevName, RpcPacket)
 
@@ -86,12 +172,13 @@ namespace rpc {
 
 
         // #############################################################
-        // ONEWAY ()
+        // ONEWAY (服务端主动推送)
         // #############################################################
 
         FACTORY_ID_APPEND(OwLightStatus, RpcPacket)
         FACTORY_ID_APPEND(OwSoundPlayEnd, RpcPacket)
         FACTORY_ID_APPEND(OwPtzPosition, RpcPacket)
+        FACTORY_ID_APPEND(OwPtzGotoDone, RpcPacket)
         FACTORY_ID_APPEND(OwDeviceStatus, RpcPacket)
 
         FACTORY_END(u32, RpcPacket)
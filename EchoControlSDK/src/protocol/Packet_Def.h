@@ -7,28 +7,28 @@
 ECCS_BEGIN
 namespace rpc {
 
-    using namespace did; // ʹ DeviceType ö
+    using namespace did; // 使用 DeviceType 枚举
 
     // =============================================================
-    // ͨݽṹ (1ֽڶ)
+    // 通用数据结构 (1字节对齐)
     // =============================================================
 #pragma pack(push, 1)
 
-// ͨý
+// 通用结果返回
     struct Result {
         u32 code;     // 0=Success
         char msg[64];
     };
 
-    // ͨ豸״̬
+    // 通用设备状态数据
     struct DeviceStatus {
         u32 deviceID;       // DeviceID Value
         u8  slotID;         // Slot Index
 
         u8  state;          // Value from enum DevState
 
-        u32 errorCode;      // 
-        float temperature;  // ¶
+        u32 errorCode;      // 错误码
+        float temperature;  // 温度
     };
 
     // ---------------- Light Data ----------------
@@ -41,16 +41,24 @@ namespace rpc {
 
     // ---------------- Sound Data ----------------
     struct SoundPlayCtrl {
-        char filename[128]; // ļ
-        u8 loop;            // 1=ѭ
+        char filename[128]; // 播放文件
+        u8 loop;            // 1=循环
     };
     struct SoundTTSCtrl { char text[256]; };   // TTS
-    struct SoundVolCtrl { u8 volume; };        // 
+    struct SoundVolCtrl { u8 volume; };        // 音量
 
     // ---------------- PTZ Data ------------------
-    struct PtzMotion { u8 action; u8 speed; }; // 
-    struct PtzPreset { u8 action; u8 index; }; // ɾԤλ
-    struct PtzPosition { float pan; float tilt; float zoom; }; // ǶϢ
+    struct PtzMotion { u8 action; u8 speed; }; // 上下左右
+    struct PtzPreset { u8 action; u8 index; }; // 增删调预置位
+    struct PtzPosition { float pan; float tilt; float zoom; }; // 角度信息
+    struct PtzTourCtrl { char steps[200]; };   // 巡航定义 "1:10,2:10"，为空使用配置
+    struct PtzGoto { float pan; float tilt; float tolerance; }; // 绝对定位 (度)
+    struct PtzVelocity { i8 pan; i8 tilt; };   // 带符号速度 (正: 右/上)，0 为停止该轴
+    struct PtzGotoResult {
+        float pan;      // 结束时的角度
+        float tilt;
+        u8 result;      // 0=到位, 1=超时, 2=被打断, 3=发送失败
+    };
 
     // ---------------- Setting Data --------------
     struct NetConfig { char ip[32]; u16 port; };
@@ -61,61 +69,97 @@ namespace rpc {
         u8 channel; // 0=All, 1=Channel1...
         u8 isOpen;
     };
+    struct UltrasonicMask {
+        u32 mask;   // bit0=通道1, bit1=通道2... (1=开, 0=关)
+    };
 
 #pragma pack(pop)
 
+    // 紧凑编码特化: 含字符串或宽整数的结构 (实现见 Packet_Def.cpp)，其余按原始字节
+#define COMPACT_CODEC_DECL(TData) \
+    template<> struct CompactCodec<TData> { \
+        static void Write(CompactWriter& w, const TData& d); \
+        static void Read(CompactReader& r, TData& d); \
+    };
+
+    COMPACT_CODEC_DECL(Result)
+    COMPACT_CODEC_DECL(DeviceStatus)
+    COMPACT_CODEC_DECL(SoundPlayCtrl)
+    COMPACT_CODEC_DECL(SoundTTSCtrl)
+    COMPACT_CODEC_DECL(PtzTourCtrl)
+    COMPACT_CODEC_DECL(NetConfig)
+    COMPACT_CODEC_DECL(DevName)
+    COMPACT_CODEC_DECL(UltrasonicMask)
+
 
     // =============================================================
-    // Packet  (ע)
+    // Packet 定义 (分类注册)
     // =============================================================
 
     // #############################################################
-    // CONTROL (ʵʱ)
+    // CONTROL (实时控制)
     // #############################################################
 
     // --- Light Control ---
-    // 
+    // 开关
     typedef Packet<_APP_RQ_CONTROL_ID_(DEVICE_LIGHT, 1), bool>      RqLightSwitch;
     typedef Packet<_APP_RP_CONTROL_ID_(DEVICE_LIGHT, 1), Result>    RpLightSwitch;
-    // 
+    // 亮度
     typedef Packet<_APP_RQ_CONTROL_ID_(DEVICE_LIGHT, 2), u8>        RqLightLevel;
     typedef Packet<_APP_RP_CONTROL_ID_(DEVICE_LIGHT, 2), Result>    RpLightLevel;
-    // Ƶ
+    // 频闪
     typedef Packet<_APP_RQ_CONTROL_ID_(DEVICE_LIGHT, 3), bool>      RqLightStrobe;
     typedef Packet<_APP_RP_CONTROL_ID_(DEVICE_LIGHT, 3), Result>    RpLightStrobe;
+    // 强制重发全部设置 (不做重复抑制)
+    typedef Packet<_APP_RQ_CONTROL_ID_(DEVICE_LIGHT, 4), NoneData>  RqLightRefresh;
+    typedef Packet<_APP_RP_CONTROL_ID_(DEVICE_LIGHT, 4), Result>    RpLightRefresh;
 
     // --- Sound Control ---
-    // ļ
+    // 播放文件
     typedef Packet<_APP_RQ_CONTROL_ID_(DEVICE_SOUND, 1), SoundPlayCtrl> RqSoundPlay;
     typedef Packet<_APP_RP_CONTROL_ID_(DEVICE_SOUND, 1), Result>        RpSoundPlay;
-    // ֹͣ
+    // 停止
     typedef Packet<_APP_RQ_CONTROL_ID_(DEVICE_SOUND, 2), NoneData>  RqSoundStop;
     typedef Packet<_APP_RP_CONTROL_ID_(DEVICE_SOUND, 2), Result>    RpSoundStop;
     // TTS
     typedef Packet<_APP_RQ_CONTROL_ID_(DEVICE_SOUND, 3), SoundTTSCtrl>  RqSoundTTS;
     typedef Packet<_APP_RP_CONTROL_ID_(DEVICE_SOUND, 3), Result>        RpSoundTTS;
-    // 
+    // 喊话
     typedef Packet<_APP_RQ_CONTROL_ID_(DEVICE_SOUND, 4), bool>      RqSoundMic;
     typedef Packet<_APP_RP_CONTROL_ID_(DEVICE_SOUND, 4), Result>    RpSoundMic;
 
     // --- PTZ Control ---
-    // ƶ
+    // 移动
     typedef Packet<_APP_RQ_CONTROL_ID_(DEVICE_PTZ, 1), PtzMotion> RqPtzMove;
     typedef Packet<_APP_RP_CONTROL_ID_(DEVICE_PTZ, 1), Result>    RpPtzMove;
-    // ֹͣ
+    // 停止
     typedef Packet<_APP_RQ_CONTROL_ID_(DEVICE_PTZ, 2), NoneData>  RqPtzStop;
     typedef Packet<_APP_RP_CONTROL_ID_(DEVICE_PTZ, 2), Result>    RpPtzStop;
-    // Ԥλ
+    // 预置位
     typedef Packet<_APP_RQ_CONTROL_ID_(DEVICE_PTZ, 3), PtzPreset>   RqPtzPreset;
     typedef Packet<_APP_RP_CONTROL_ID_(DEVICE_PTZ, 3), Result>      RpPtzPreset;
 
-    // ̵
+    typedef Packet<_APP_RQ_CONTROL_ID_(DEVICE_PTZ, 4), PtzTourCtrl> RqPtzTourStart;
+    typedef Packet<_APP_RP_CONTROL_ID_(DEVICE_PTZ, 4), Result>      RpPtzTourStart;
+
+    typedef Packet<_APP_RQ_CONTROL_ID_(DEVICE_PTZ, 5), NoneData>    RqPtzTourStop;
+    typedef Packet<_APP_RP_CONTROL_ID_(DEVICE_PTZ, 5), Result>      RpPtzTourStop;
+
+    typedef Packet<_APP_RQ_CONTROL_ID_(DEVICE_PTZ, 6), PtzGoto>     RqPtzGoto;
+    typedef Packet<_APP_RP_CONTROL_ID_(DEVICE_PTZ, 6), Result>      RpPtzGoto;
+
+    typedef Packet<_APP_RQ_CONTROL_ID_(DEVICE_PTZ, 7), PtzVelocity> RqPtzVelocity;
+    typedef Packet<_APP_RP_CONTROL_ID_(DEVICE_PTZ, 7), Result>      RpPtzVelocity;
+
+    // 继电器控制
     typedef Packet<_APP_RQ_CONTROL_ID_(DEVICE_ULTRASONIC, 1), UltrasonicSwitch>  RqUltrasonicSwitch;
     typedef Packet<_APP_RP_CONTROL_ID_(DEVICE_ULTRASONIC, 1), Result>            RpUltrasonicSwitch;
+    typedef Packet<_APP_RQ_CONTROL_ID_(DEVICE_ULTRASONIC, 2), UltrasonicMask>    RqUltrasonicMask;
+    typedef Packet<_APP_RP_CONTROL_ID_(DEVICE_ULTRASONIC, 2), Result>            RpUltrasonicMask;
 
 
     // #############################################################
-    // QUERY (״̬ѯ - ѯ)
+    // QUERY (状态查询 - 主动轮询用)
     // #############################################################
 
     // --- Light Query ---
@@ -130,14 +174,14 @@ namespace rpc {
 
 
     // #############################################################
-    // SETTING ()
+    // SETTING (参数配置)
     // #############################################################
 
-    // ͨã޸
+    // 通用：修改网络配置
     typedef Packet<_APP_RQ_SETTING_ID_(DEVICE_UNKNOWN, 1), NetConfig>   RqSetNetConfig;
     typedef Packet<_APP_RP_SETTING_ID_(DEVICE_UNKNOWN, 1), Result>      RpSetNetConfig;
 
-    // ͨã޸豸
+    // 通用：修改设备名称
     typedef Packet<_APP_RQ_SETTING_ID_(DEVICE_UNKNOWN, 2), DevName>     RqSetDevName;
     typedef Packet<_APP_RP_SETTING_ID_(DEVICE_UNKNOWN, 2), Result>      RpSetDevName;
 
@@ -146,7 +190,7 @@ namespace rpc {
 
     // --- Sound Setting ---
 
-    // 
+    // 音量设置
     typedef Packet<_APP_RQ_SETTING_ID_(DEVICE_SOUND, 1), SoundVolCtrl>  RqSetSoundVolume;
     typedef Packet<_APP_RP_SETTING_ID_(DEVICE_SOUND, 1), Result>        RpSetSoundVolume;
 
@@ -154,20 +198,27 @@ namespace rpc {
 
 
     // #############################################################
-    // ONEWAY ()
+    // ONEWAY (服务端主动推送)
     // #############################################################
 
-    // ǿ״̬
+    // 强光状态变更推送
     typedef Packet<_APP_OW_ID_(DEVICE_LIGHT, 1), LightStatus>  OwLightStatus;
 
-    // ǿŽ
+    // 强声播放结束推送
     typedef Packet<_APP_OW_ID_(DEVICE_SOUND, 1), NoneData>     OwSoundPlayEnd;
 
-    // ̨λʵʱش
+    // 云台位置实时回传
     typedef Packet<_APP_OW_ID_(DEVICE_PTZ, 1), PtzPosition>    OwPtzPosition;
 
-    // 豸״̬ʵʱش
+    // 云台绝对定位结束推送
+    typedef Packet<_APP_OW_ID_(DEVICE_PTZ, 2), PtzGotoResult>  OwPtzGotoDone;
+
+    // 设备状态实时回传
     typedef Packet<_APP_OW_ID_(DEVICE_UNKNOWN, 1), DeviceStatus> OwDeviceStatus;
 
+
+    // 按 Packet ID 创建包 (注册表见 Packet_Def.cpp)
+    FACTORY_DECL_EXTERN(u32, RpcPacket)
+
 }
 ECCS_END
\ No newline at end of file
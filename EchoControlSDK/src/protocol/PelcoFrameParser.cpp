@@ -0,0 +1,139 @@
+#include "PelcoFrameParser.h"
+#include "../utils/checksum.h"
+#include <string.h>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#  include <emmintrin.h>
+#  define ECCS_PELCO_SSE2 1
+#  if defined(_MSC_VER)
+#    include <intrin.h>
+#  endif
+#endif
+
+ECCS_BEGIN
+
+#if defined(ECCS_PELCO_SSE2)
+static inline u32 LowestBit(u32 mask)
+{
+#if defined(_MSC_VER)
+    unsigned long idx;
+    _BitScanForward(&idx, mask);
+    return (u32)idx;
+#else
+    return (u32)__builtin_ctz(mask);
+#endif
+}
+#endif
+
+
+PelcoFrameParser::PelcoFrameParser(FrameHandler handler)
+    : m_handler(handler), m_pendLen(0), m_frames(0), m_badSum(0), m_dropped(0)
+{
+}
+
+u8 PelcoFrameParser::Checksum(const u8* frame)
+{
+    return checksum::Sum8(frame + 1, 5);
+}
+
+u32 PelcoFrameParser::FindSync(const u8* p, u32 len)
+{
+    u32 i = 0;
+#if defined(ECCS_PELCO_SSE2)
+    const __m128i sync = _mm_set1_epi8((char)SYNC);
+    for (; i + 16 <= len; i += 16) {
+        __m128i x = _mm_loadu_si128((const __m128i*)(p + i));
+        u32 mask = (u32)_mm_movemask_epi8(_mm_cmpeq_epi8(x, sync));
+        if (mask) return i + LowestBit(mask);
+    }
+#endif
+    const void* hit = memchr(p + i, SYNC, len - i);
+    return hit ? (u32)((const u8*)hit - p) : len;
+}
+
+u32 PelcoFrameParser::Scan(const u8* p, u32 len, u32 startLimit, u32& frames)
+{
+    u32 i = 0;
+    while (i < startLimit) {
+        u32 s = i + FindSync(p + i, len - i);
+        m_dropped += s - i;
+        i = s;
+        if (i >= startLimit || i + FRAME_LEN > len) break;
+
+#if defined(ECCS_PELCO_SSE2)
+        // 批量校验: 一次载入两帧 (14 字节)，sad 分别求出两帧 Addr..Data2 的和
+        if (i + 16 <= len && i + FRAME_LEN < startLimit && p[i + FRAME_LEN] == SYNC) {
+            const __m128i sel = _mm_setr_epi8(0, -1, -1, -1, -1, -1, 0, 0,
+                                              0, -1, -1, -1, -1, -1, 0, 0);
+            __m128i x = _mm_loadu_si128((const __m128i*)(p + i));
+            // 低 8 字节为第一帧，第二帧 (偏移 7) 移入高 8 字节
+            __m128i y = _mm_unpacklo_epi64(x, _mm_srli_si128(x, FRAME_LEN));
+            __m128i sum = _mm_sad_epu8(_mm_and_si128(y, sel), _mm_setzero_si128());
+            u8 sumA = (u8)_mm_cvtsi128_si32(sum);
+            u8 sumB = (u8)_mm_cvtsi128_si32(_mm_srli_si128(sum, 8));
+            if (sumA == p[i + 6] && sumB == p[i + FRAME_LEN + 6]) {
+                if (m_handler) {
+                    m_handler(p + i);
+                    m_handler(p + i + FRAME_LEN);
+                }
+                frames += 2;
+                i += 2 * FRAME_LEN;
+                continue;
+            }
+        }
+#endif
+        if (Checksum(p + i) == p[i + 6]) {
+            if (m_handler) m_handler(p + i);
+            ++frames;
+            i += FRAME_LEN;
+        }
+        else {
+            // 0xFF 出现在数据中或帧损坏: 跳过该字节重新同步
+            ++m_badSum;
+            ++m_dropped;
+            ++i;
+        }
+    }
+    return i;
+}
+
+u32 PelcoFrameParser::Feed(const u8* data, u32 len)
+{
+    if (!data || len == 0) return 0;
+
+    u32 frames = 0;
+    u32 off = 0;
+
+    // 1. 先处理上次残留的半帧: 与新数据前 6 字节拼接后扫描
+    if (m_pendLen > 0) {
+        u8 tmp[2 * FRAME_LEN];
+        u32 take = (len < FRAME_LEN - 1) ? len : FRAME_LEN - 1;
+        memcpy(tmp, m_pend, m_pendLen);
+        memcpy(tmp + m_pendLen, data, take);
+        u32 total = m_pendLen + take;
+
+        u32 r = Scan(tmp, total, m_pendLen, frames);
+        if (r < m_pendLen) {
+            // 仍不足一帧 (新数据过短): 全部并入半帧
+            m_pendLen = total - r;
+            memmove(m_pend, tmp + r, m_pendLen);
+            m_frames += frames;
+            return frames;
+        }
+        off = r - m_pendLen;
+        m_pendLen = 0;
+    }
+
+    // 2. 扫描新数据，尾部不足一帧的部分留作半帧
+    u32 r = off + Scan(data + off, len - off, len - off, frames);
+    if (r < len) {
+        m_pendLen = len - r;
+        memcpy(m_pend, data + r, m_pendLen);
+    }
+
+    m_frames += frames;
+    return frames;
+}
+
+
+ECCS_END
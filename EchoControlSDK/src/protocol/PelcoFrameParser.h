@@ -0,0 +1,62 @@
+#pragma once
+#include "../global.h"
+#include <functional>
+
+ECCS_BEGIN
+
+//------------------------------------------------------
+// PelcoFrameParser: Pelco-D 定长帧流式重组
+// 帧格式: FF Addr Cmd1 Cmd2 Data1 Data2 Sum  (Sum = Addr..Data2 求和取低 8 位)
+// * 跨次读取的半帧保留在内部，下次 Feed 时拼接
+// * 帧头 0xFF 使用向量化扫描定位，校验失败时前移 1 字节重新同步
+// * 连续的背靠背帧两两批量校验
+// * 只做分帧与校验，地址过滤与命令解析由驱动在回调中完成
+//------------------------------------------------------
+
+class PelcoFrameParser
+{
+public:
+    static const u32 FRAME_LEN = 7;
+    static const u8  SYNC = 0xFF;
+
+    using FrameHandler = std::function<void(const u8* frame)>;
+
+    explicit PelcoFrameParser(FrameHandler handler = nullptr);
+
+    void SetHandler(FrameHandler handler) { m_handler = handler; }
+
+    /**
+     * @brief Feed 输入一段接收数据，回调所有完整且校验通过的帧
+     * @param data：接收数据
+     * @param len：数据长度 (任意长度，可为 1 字节)
+     * @return 本次回调的帧数
+     */
+    u32 Feed(const u8* data, u32 len);
+
+    // 丢弃半帧 (重连后调用)
+    void Reset() { m_pendLen = 0; }
+
+    static u8 Checksum(const u8* frame);
+
+    // 统计
+    u64 FrameCount() const { return m_frames; }
+    u64 ChecksumErrors() const { return m_badSum; }
+    u64 DroppedBytes() const { return m_dropped; }
+
+private:
+    // 扫描 [0, len) 中起始位置 < startLimit 的帧，返回第一个未消费的位置
+    u32 Scan(const u8* p, u32 len, u32 startLimit, u32& frames);
+    static u32 FindSync(const u8* p, u32 len);
+
+private:
+    FrameHandler m_handler;
+    u8  m_pend[FRAME_LEN - 1];  // 未完成的半帧 (以 0xFF 开头)
+    u32 m_pendLen;
+
+    u64 m_frames;
+    u64 m_badSum;
+    u64 m_dropped;
+};
+
+
+ECCS_END
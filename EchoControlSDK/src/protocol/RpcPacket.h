@@ -3,6 +3,10 @@
 #include "../utils/buffer.h"
 #include "../utils/factory.hpp"
 
+#ifndef _WIN32
+#include <sys/uio.h>
+#endif
+
 ECCS_BEGIN
 namespace rpc {
 
@@ -17,24 +21,44 @@ namespace rpc {
     };
 #pragma pack(pop)
 
+    // 分散写片段 (POSIX 下即 iovec，可直接用于 writev/sendmsg)
+#ifdef _WIN32
+    struct IoVec {
+        void*  iov_base;
+        size_t iov_len;
+    };
+#else
+    typedef struct iovec IoVec;
+#endif
+
     class RpcPacket {
     public:
         virtual ~RpcPacket() = default;
 
-        //  (Key = u32)
+        // 工厂基类宏 (Key = u32)
         FACTORY_ID_BASE(u32)
 
         virtual bool Encode(Buffer& buf) = 0;
+
+        // 零拷贝编码: 填充指向包内头部与数据的片段，返回片段数 (1 或 2)
+        // 片段在包对象存活且未被修改期间有效
+        virtual int EncodeIov(IoVec iov[2]) const = 0;
+
         virtual bool Decode(const u8* data, u32 len) = 0;
 
+        // 紧凑编码 (见 CompactCodec.h): EncodeCompact 按 version 追加整帧，DecodeCompact 只解包体
+        virtual bool EncodeCompact(Buffer& buf, u8 version) const = 0;
+        virtual bool DecodeCompact(const u8* data, u32 len) = 0;
+
         u32 GetID() const { return m_header.id; }
+        u32 GetSeq() const { return m_header.cseq; }
         void SetSeq(u32 seq) { m_header.cseq = seq; }
 
     protected:
         PacketHeader m_header;
     };
 
-    // ռλ
+    // 空数据占位符
     struct NoneData {};
 
 }
@@ -1,4 +1,4 @@
-﻿
+
 #include "process_singleton.h"
 #ifdef __linux__
 #include <unistd.h>
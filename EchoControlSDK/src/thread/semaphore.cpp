@@ -1,4 +1,4 @@
-﻿
+
 #include "semaphore.h"
 
 ECCS_BEGIN
@@ -1,4 +1,4 @@
-﻿
+
 #pragma once
 #include "sal_thread.h"
 
@@ -1,4 +1,4 @@
-﻿
+
 #include "thread.h"
 #include <assert.h>
 #include "../debug/Logger.h"
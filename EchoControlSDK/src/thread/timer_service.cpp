@@ -0,0 +1,114 @@
+#include "timer_service.h"
+#include "../debug/Logger.h"
+#include <algorithm>
+
+ECCS_BEGIN
+
+
+TimerService& TimerService::instance()
+{
+    static TimerService service;
+    return service;
+}
+
+TimerService::TimerService()
+    : m_nextId(INVALID_TIMER + 1), m_firing(INVALID_TIMER), m_quit(false)
+{
+    m_thread = ECCS_C11 thread(&TimerService::run, this);
+}
+
+TimerService::~TimerService()
+{
+    {
+        ECCS_C11 lock_guard<ECCS_C11 mutex> lock(m_mutex);
+        m_quit = true;
+    }
+    m_cond.notify_all();
+    if (m_thread.joinable()) {
+        m_thread.join();
+    }
+}
+
+TimerService::TimerId TimerService::schedule(u32 delayMs, Callback cb)
+{
+    if (!cb) return INVALID_TIMER;
+
+    Entry e;
+    e.due = steady_clock::now() + duration_ms(delayMs);
+
+    bool earliest;
+    {
+        ECCS_C11 lock_guard<ECCS_C11 mutex> lock(m_mutex);
+        e.id = m_nextId++;
+        m_callbacks[e.id] = cb;
+        m_heap.push_back(e);
+        std::push_heap(m_heap.begin(), m_heap.end(), std::greater<Entry>());
+        earliest = (m_heap.front().id == e.id);
+    }
+    // 只有新定时器成为堆顶时才需要唤醒线程重新计算等待时间
+    if (earliest) m_cond.notify_one();
+    return e.id;
+}
+
+bool TimerService::cancel(TimerId id)
+{
+    if (id == INVALID_TIMER) return false;
+
+    ECCS_C11 unique_lock<ECCS_C11 mutex> lock(m_mutex);
+    bool found = (m_callbacks.erase(id) > 0);
+
+    // 回调正在执行: 等待其结束 (定时器线程自身调用时不等待)
+    if (m_firing == id && current_thread() != m_thread.get_id()) {
+        m_doneCond.wait(lock, [this, id] { return m_firing != id; });
+    }
+    return found;
+}
+
+size_t TimerService::pending() const
+{
+    ECCS_C11 lock_guard<ECCS_C11 mutex> lock(m_mutex);
+    return m_callbacks.size();
+}
+
+void TimerService::run()
+{
+    ECCS_C11 unique_lock<ECCS_C11 mutex> lock(m_mutex);
+    while (!m_quit) {
+        if (m_heap.empty()) {
+            m_cond.wait(lock);
+            continue;
+        }
+
+        Entry top = m_heap.front();
+        if (steady_clock::now() < top.due) {
+            m_cond.wait_until(lock, top.due);
+            continue;
+        }
+
+        std::pop_heap(m_heap.begin(), m_heap.end(), std::greater<Entry>());
+        m_heap.pop_back();
+
+        auto it = m_callbacks.find(top.id);
+        if (it == m_callbacks.end()) continue; // 已取消
+
+        Callback cb;
+        cb.swap(it->second);
+        m_callbacks.erase(it);
+        m_firing = top.id;
+
+        lock.unlock();
+        try {
+            cb();
+        }
+        catch (std::exception& e) {
+            LOG_ERROR("TimerService: callback exception: %s", e.what());
+        }
+        lock.lock();
+
+        m_firing = INVALID_TIMER;
+        m_doneCond.notify_all();
+    }
+}
+
+
+ECCS_END
@@ -0,0 +1,67 @@
+#pragma once
+#include "sal_thread.h"
+#include <functional>
+#include <unordered_map>
+#include <vector>
+
+ECCS_BEGIN
+
+//------------------------------------------------------
+// TimerService: 进程内共享的单线程定时器
+// * 最小堆按到期时间排序，单线程可承载大量定时器
+// * 回调在定时器线程中执行，应只做投递事件等轻量操作
+// * cancel 返回后保证回调不会再执行 (回调内部调用除外)
+//------------------------------------------------------
+
+class TimerService
+{
+    NON_COPYABLE(TimerService);
+
+public:
+    typedef u64 TimerId;
+    typedef std::function<void()> Callback;
+
+    static const TimerId INVALID_TIMER = 0;
+
+    // 首次调用时启动定时器线程
+    static TimerService& instance();
+
+    /**
+     * @brief schedule 注册一次性定时器
+     * @param delayMs：延迟 (ms)
+     * @param cb：到期回调
+     * @return 定时器 ID，用于 cancel
+     */
+    TimerId schedule(u32 delayMs, Callback cb);
+
+    // 取消定时器，已到期或不存在时返回 false
+    bool cancel(TimerId id);
+
+    size_t pending() const;
+
+private:
+    TimerService();
+    ~TimerService();
+
+    void run();
+
+private:
+    struct Entry {
+        steady_clock::time_point due;
+        TimerId id;
+        bool operator>(const Entry& o) const { return due > o.due; }
+    };
+
+    mutable ECCS_C11 mutex         m_mutex;
+    ECCS_C11 condition_variable    m_cond;
+    ECCS_C11 condition_variable    m_doneCond;
+    std::vector<Entry>             m_heap;        // 最小堆 (已取消的条目出堆时跳过)
+    std::unordered_map<TimerId, Callback> m_callbacks;
+    TimerId                        m_nextId;
+    TimerId                        m_firing;      // 正在执行回调的定时器
+    bool                           m_quit;
+    ECCS_C11 thread                m_thread;
+};
+
+
+ECCS_END
@@ -1,4 +1,4 @@
-﻿
+
 #include "elapsed_timer.h"
 #include <time.h>
 
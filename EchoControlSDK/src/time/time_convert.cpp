@@ -1,4 +1,4 @@
-﻿
+
 #include "time_convert.h"
 #include <time.h>
 #include <string.h>
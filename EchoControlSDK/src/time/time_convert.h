@@ -1,4 +1,4 @@
-﻿
+
 #pragma once
 #include <time.h>
 #include "../global.h"
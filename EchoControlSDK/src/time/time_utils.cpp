@@ -1,4 +1,4 @@
-﻿
+
 #include "time_utils.h"
 #ifdef _WIN32
 #include <Windows.h>
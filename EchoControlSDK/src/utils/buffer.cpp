@@ -1,7 +1,8 @@
-﻿
+
 #include "buffer.h"
 #include <assert.h>
 #include <string.h>
+#include <utility>
 #include "../debug/exceptions.h"
 #include "../debug/Logger.h"
 
@@ -10,57 +11,97 @@ ECCS_BEGIN
 
 Buffer::Buffer()
 {
-    _capacity = 16;
-    _buf = new char[_capacity];
-    _pos = 0;
-    _count = 0;
-    //printf("Buffer()\n");
+    allocate(0);
 }
 Buffer::Buffer(size_t s)
 {
-    _capacity = (s + 4 - s % 4);
-    assert(_capacity > 1);
-    _buf = new char[_capacity];
-    _pos = 0;
-    _count = 0;
+    allocate(s);
 }
 Buffer::Buffer(const char* dat, size_t len)
 {
-    _capacity = (len + 4 - len % 4);
-    assert(_capacity > 1);
-    _buf = new char[_capacity];
-    memcpy(_buf, dat, len);
-    _pos = 0;
+    allocate(len);
+    if (len > 0) memcpy(_buf, dat, len);
     _count = len;
 }
 Buffer::Buffer(const Buffer& other)
 {
-    _capacity = other._capacity;
-    _pos = other._pos;
+    allocate(other._count);
+    if (other._count > 0) memcpy(_buf, other._buf + other._pos, other._count);
     _count = other._count;
-    assert(_capacity > 1);
-    _buf = new char[_capacity];
-    memcpy(_buf, other._buf, _count);
+}
+Buffer::Buffer(Buffer&& other) noexcept
+{
+    moveFrom(other);
 }
 Buffer& Buffer::operator=(const Buffer& other)
 {
     if(this != &other){
-        _capacity = other._capacity;
-        _pos = other._pos;
+        if (_capacity < other._count) {
+            freeStorage();
+            allocate(other._count);
+        }
+        if (other._count > 0) memcpy(_buf, other._buf + other._pos, other._count);
+        _pos = 0;
         _count = other._count;
-        delete[] _buf;
-        assert(_capacity > 1);
-        _buf = new char[_capacity];
-        memcpy(_buf, other._buf, _count);
+    }
+    return (*this);
+}
+Buffer& Buffer::operator=(Buffer&& other) noexcept
+{
+    if(this != &other){
+        freeStorage();
+        moveFrom(other);
     }
     return (*this);
 }
 Buffer::~Buffer()
 {
+    freeStorage();
+}
+
+void Buffer::allocate(size_t s)
+{
+    if (s <= INLINE_SIZE) {
+        _buf = _inline;
+        _capacity = INLINE_SIZE;
+    }
+    else {
+        _lease = BufferPool::Instance().Acquire(s);
+        _buf = (char*)_lease.Data();
+        _capacity = _lease.Capacity();
+    }
+    _pos = 0;
     _count = 0;
-    delete[] _buf;
-    _buf = NULL;
-    //printf("~Buffer()\n");
+}
+void Buffer::freeStorage()
+{
+    _lease.Reset();
+    _buf = _inline;
+    _capacity = INLINE_SIZE;
+    _pos = 0;
+    _count = 0;
+}
+// 接管 other 的数据 (本对象无存储)，other 变为空
+void Buffer::moveFrom(Buffer& other)
+{
+    if (other.isInline()) {
+        _buf = _inline;
+        _capacity = INLINE_SIZE;
+        _pos = 0;
+        _count = other._count;
+        if (_count > 0) memcpy(_inline, other._buf + other._pos, _count);
+    }
+    else {
+        _lease = std::move(other._lease);
+        _buf = other._buf;
+        _capacity = other._capacity;
+        _pos = other._pos;
+        _count = other._count;
+        other._buf = other._inline;
+        other._capacity = INLINE_SIZE;
+    }
+    other._pos = 0;
+    other._count = 0;
 }
 
 void Buffer::clear()
@@ -74,42 +115,41 @@ void Buffer::recapacity(size_t s)
         return;
     }
 
-    size_t cap = (s + 4 - s % 4);
-    char* newBuf = new char[cap];
-
     size_t cnt = s > _count ? _count : s;
-    memcpy((void*)newBuf, (void*)(&_buf[_pos]), cnt);
-    delete[] _buf;
+    if (s <= INLINE_SIZE) {
+        memmove(_inline, &_buf[_pos], cnt);
+        _lease.Reset();
+        _buf = _inline;
+        _capacity = INLINE_SIZE;
+    }
+    else {
+        BufferPool::Lease lease = BufferPool::Instance().Acquire(s);
+        memcpy(lease.Data(), &_buf[_pos], cnt);
+        _lease = std::move(lease);
+        _buf = (char*)_lease.Data();
+        _capacity = _lease.Capacity();
+    }
 
-    _buf = newBuf;
     _pos = 0;
     _count = cnt;
-    _capacity = cap;
 }
 void Buffer::reserve(size_t cnt)
 {
-    size_t front = _pos;
     size_t behind = _capacity - _pos - _count;
-    if (behind < cnt)
-    {
-        if (front + behind >= cnt)
-        {
-            /* Now front > 0 */
-            if (_count > 0)
-            {
-                if (front >= _count) {
-                    memcpy(_buf, _buf+_pos, _count);
-                }
-                else {
-                    recapacity(cnt + _count*2);
-                }
-            }
-            _pos = 0;
-        }
-        else {
-            recapacity(cnt + _count*2);
-        }
+    if (behind >= cnt) {
+        return;
+    }
+
+    // 队首空闲足够且数据不多时前移，移动量不超过容量一半，摊还为常数
+    if (_count + cnt <= _capacity && _count <= _capacity / 2) {
+        if (_count > 0) memmove(_buf, _buf + _pos, _count);
+        _pos = 0;
+        return;
     }
+
+    size_t cap = _capacity * 2;
+    if (cap < _count + cnt) cap = _count + cnt;
+    recapacity(cap);
 }
 void Buffer::resize(size_t s)
 {
@@ -122,20 +162,9 @@ void Buffer::resize(size_t s)
 void Buffer::swap(Buffer& other)
 {
     if(this != &other){
-        auto tmpCapacity = _capacity;
-        auto tmpPos = _pos;
-        auto tmpCount = _count;
-        auto tmpBuf = _buf;
-
-        _capacity = other._capacity;
-        _pos = other._pos;
-        _count = other._count;
-        _buf = other._buf;
-
-        other._capacity = tmpCapacity;
-        other._pos = tmpPos;
-        other._count = tmpCount;
-        other._buf = tmpBuf;
+        Buffer tmp(std::move(other));
+        other = std::move(*this);
+        *this = std::move(tmp);
     }
 }
 
@@ -267,5 +296,37 @@ void Buffer::push_back(const char* bs, size_t count)
     _count += count;
 }
 
+BufferPool::Lease Buffer::release(size_t& len)
+{
+    len = _count;
+    if (_count == 0) {
+        return BufferPool::Lease();
+    }
+
+    BufferPool::Lease out;
+    if (isInline()) {
+        out = BufferPool::Instance().Acquire(_count);
+        memcpy(out.Data(), _buf + _pos, _count);
+    }
+    else {
+        if (_pos > 0) memmove(_buf, _buf + _pos, _count);
+        out = std::move(_lease);
+        _buf = _inline;
+    }
+    _capacity = INLINE_SIZE;
+    _pos = 0;
+    _count = 0;
+    return out;
+}
+void Buffer::adopt(BufferPool::Lease&& lease, size_t len)
+{
+    assert(lease && len <= lease.Capacity());
+    freeStorage();
+    _lease = std::move(lease);
+    _buf = (char*)_lease.Data();
+    _capacity = _lease.Capacity();
+    _count = len;
+}
+
 
 ECCS_END
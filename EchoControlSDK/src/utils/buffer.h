@@ -1,19 +1,30 @@
-﻿
+
 #pragma once
 #include <stddef.h>
 #include "../global.h"
+#include "buffer_pool.h"
 
 ECCS_BEGIN
 
 
+//------------------------------------------------------
+// 字节队列: 队尾追加，队首弹出
+// * 不超过 INLINE_SIZE 的数据存放在对象内部 (设备指令帧均在此范围内，不分配堆内存)
+// * 空间不足时先把数据前移复用队首空间 (数据不超过容量一半时)，否则容量按 2 倍增长
+// * 堆存储从 BufferPool 租用，容量为池的级别尺寸
+//------------------------------------------------------
 class Buffer
 {
 public:
+    static const size_t INLINE_SIZE = 64;
+
     Buffer();
     Buffer(size_t s);
     Buffer(const char* dat, size_t len);
     Buffer(const Buffer& other);
+    Buffer(Buffer&& other) noexcept;
     Buffer& operator=(const Buffer& other);
+    Buffer& operator=(Buffer&& other) noexcept;
     virtual ~Buffer();
 
     void clear();
@@ -41,11 +52,24 @@ public:
     void push_back(const char b);// 数据放入队尾
     void push_back(const char* bs, size_t count);
 
+    // 交出存储 (数据从首字节开始，共 len 字节)，之后缓冲为空；无数据时返回空租约
+    BufferPool::Lease release(size_t& len);
+    // 接管租约 (前 len 字节为数据)
+    void adopt(BufferPool::Lease&& lease, size_t len);
+
+private:
+    bool isInline() const { return _buf == _inline; }
+    void allocate(size_t s);
+    void freeStorage();
+    void moveFrom(Buffer& other);
+
 private:
     char*   _buf;
     size_t  _capacity;
     size_t  _pos;
     size_t  _count;
+    BufferPool::Lease _lease;   // 堆存储 (内联时为空)
+    char    _inline[INLINE_SIZE];
 };
 
 
@@ -0,0 +1,316 @@
+#include "buffer_pool.h"
+#include <algorithm>
+
+ECCS_BEGIN
+
+//------------------------------------------------------
+// 线程缓存
+//------------------------------------------------------
+
+// 只由所属线程写入，其它线程读取统计
+static inline void Bump(std::atomic<u64>& v)
+{
+    v.store(v.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+}
+
+struct BufferPool::ThreadCache
+{
+    FreeList lists[CLASS_COUNT];
+    std::atomic<u64> hits;
+    std::atomic<u64> misses;
+    std::atomic<u64> oversize;
+    std::atomic<u64> acquired;
+    std::atomic<u64> released;
+    ThreadCache* prev;
+    ThreadCache* next;
+
+    ThreadCache();
+    ~ThreadCache();
+};
+
+// 线程缓存的状态: 0 未创建, 1 可用, 2 已析构 (线程退出阶段仍有租约归还时直接走中心池)
+static thread_local int t_cacheState = 0;
+
+BufferPool::ThreadCache::ThreadCache()
+    : hits(0), misses(0), oversize(0), acquired(0), released(0), prev(NULL), next(NULL)
+{
+    for (u32 i = 0; i < CLASS_COUNT; ++i) {
+        lists[i].head = NULL;
+        lists[i].count = 0;
+    }
+    BufferPool::Instance().Register(this);
+    t_cacheState = 1;
+}
+
+BufferPool::ThreadCache::~ThreadCache()
+{
+    BufferPool& pool = BufferPool::Instance();
+    for (u32 i = 0; i < CLASS_COUNT; ++i) {
+        pool.Spill(*this, i, 0);
+    }
+    pool.Unregister(this);
+    t_cacheState = 2;
+}
+
+static inline void* PopBlock(void*& head)
+{
+    void* p = head;
+    head = *(void**)p;
+    return p;
+}
+
+static inline void PushBlock(void*& head, void* p)
+{
+    *(void**)p = head;
+    head = p;
+}
+
+// 中心池每级保留的块数
+static inline u32 CentralLimit(u32 cls)
+{
+    size_t n = BufferPool::CENTRAL_BYTES / BufferPool::ClassSize(cls);
+    return (u32)std::max<size_t>(n, BufferPool::CACHE_BLOCKS);
+}
+
+//------------------------------------------------------
+// Lease
+//------------------------------------------------------
+
+BufferPool::Lease::Lease(Lease&& other) noexcept
+    : m_data(other.m_data), m_size(other.m_size), m_class(other.m_class)
+{
+    other.m_data = NULL;
+    other.m_size = 0;
+}
+
+BufferPool::Lease& BufferPool::Lease::operator=(Lease&& other) noexcept
+{
+    if (this != &other) {
+        Reset();
+        m_data = other.m_data;
+        m_size = other.m_size;
+        m_class = other.m_class;
+        other.m_data = NULL;
+        other.m_size = 0;
+    }
+    return *this;
+}
+
+void BufferPool::Lease::GiveBack()
+{
+    BufferPool::Instance().Release(m_data, m_class);
+    m_data = NULL;
+    m_size = 0;
+}
+
+//------------------------------------------------------
+// BufferPool
+//------------------------------------------------------
+
+BufferPool::BufferPool()
+    : m_caches(NULL), m_retiredHits(0), m_retiredMisses(0), m_retiredOversize(0),
+      m_retiredAcquired(0), m_retiredReleased(0), m_trimmed(0)
+{
+    for (u32 i = 0; i < CLASS_COUNT; ++i) {
+        m_central[i].head = NULL;
+        m_central[i].count = 0;
+    }
+}
+
+BufferPool& BufferPool::Instance()
+{
+    // 有意不释放: 静态对象与线程缓存的析构顺序不确定，池必须比它们活得久
+    static BufferPool* pool = new BufferPool();
+    return *pool;
+}
+
+BufferPool::ThreadCache& BufferPool::LocalCache()
+{
+    static thread_local ThreadCache cache;
+    return cache;
+}
+
+u32 BufferPool::ClassOf(size_t size)
+{
+    if (size > ClassSize(CLASS_COUNT - 1)) return CLASS_COUNT;
+    u32 cls = 0;
+    while (ClassSize(cls) < size) ++cls;
+    return cls;
+}
+
+BufferPool::Lease BufferPool::Acquire(size_t size)
+{
+    Lease lease;
+    if (size == 0) return lease;
+
+    u32 cls = ClassOf(size);
+    ThreadCache* tc = (t_cacheState != 2) ? &LocalCache() : NULL;
+
+    if (cls == CLASS_COUNT) {
+        lease.m_data = new u8[size];
+        lease.m_size = size;
+        lease.m_class = cls;
+        if (tc) {
+            Bump(tc->oversize);
+            Bump(tc->acquired);
+        }
+        else {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            ++m_retiredOversize;
+            ++m_retiredAcquired;
+        }
+        return lease;
+    }
+
+    void* p = NULL;
+    if (tc) {
+        FreeList& fl = tc->lists[cls];
+        if (fl.count == 0) Refill(*tc, cls);
+        if (fl.count > 0) {
+            p = PopBlock(fl.head);
+            --fl.count;
+        }
+        Bump(p ? tc->hits : tc->misses);
+        Bump(tc->acquired);
+    }
+    else {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        FreeList& fl = m_central[cls];
+        if (fl.count > 0) {
+            p = PopBlock(fl.head);
+            --fl.count;
+        }
+        ++(p ? m_retiredHits : m_retiredMisses);
+        ++m_retiredAcquired;
+    }
+
+    if (!p) p = new u8[ClassSize(cls)];
+    lease.m_data = (u8*)p;
+    lease.m_size = ClassSize(cls);
+    lease.m_class = cls;
+    return lease;
+}
+
+void BufferPool::Release(u8* data, u32 cls)
+{
+    ThreadCache* tc = (t_cacheState != 2) ? &LocalCache() : NULL;
+    if (tc) {
+        Bump(tc->released);
+    }
+
+    if (cls == CLASS_COUNT) {
+        delete[] data;
+        if (!tc) {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            ++m_retiredReleased;
+        }
+        return;
+    }
+
+    if (tc) {
+        FreeList& fl = tc->lists[cls];
+        if (fl.count >= CACHE_BLOCKS) Spill(*tc, cls, CACHE_BLOCKS / 2);
+        PushBlock(fl.head, data);
+        ++fl.count;
+        return;
+    }
+
+    std::lock_guard<std::mutex> lock(m_mutex);
+    ++m_retiredReleased;
+    FreeList& central = m_central[cls];
+    if (central.count < CentralLimit(cls)) {
+        PushBlock(central.head, data);
+        ++central.count;
+    }
+    else {
+        delete[] data;
+        ++m_trimmed;
+    }
+}
+
+u32 BufferPool::Refill(ThreadCache& tc, u32 cls)
+{
+    FreeList& fl = tc.lists[cls];
+    std::lock_guard<std::mutex> lock(m_mutex);
+    FreeList& central = m_central[cls];
+    u32 n = 0;
+    while (central.count > 0 && n < CACHE_BLOCKS / 2) {
+        PushBlock(fl.head, PopBlock(central.head));
+        --central.count;
+        ++fl.count;
+        ++n;
+    }
+    return n;
+}
+
+void BufferPool::Spill(ThreadCache& tc, u32 cls, u32 keep)
+{
+    FreeList& fl = tc.lists[cls];
+    if (fl.count <= keep) return;
+
+    std::lock_guard<std::mutex> lock(m_mutex);
+    FreeList& central = m_central[cls];
+    u32 limit = CentralLimit(cls);
+    while (fl.count > keep) {
+        void* p = PopBlock(fl.head);
+        --fl.count;
+        if (central.count < limit) {
+            PushBlock(central.head, p);
+            ++central.count;
+        }
+        else {
+            delete[] (u8*)p;
+            ++m_trimmed;
+        }
+    }
+}
+
+void BufferPool::Register(ThreadCache* tc)
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    tc->next = m_caches;
+    if (m_caches) m_caches->prev = tc;
+    m_caches = tc;
+}
+
+void BufferPool::Unregister(ThreadCache* tc)
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_retiredHits += tc->hits.load(std::memory_order_relaxed);
+    m_retiredMisses += tc->misses.load(std::memory_order_relaxed);
+    m_retiredOversize += tc->oversize.load(std::memory_order_relaxed);
+    m_retiredAcquired += tc->acquired.load(std::memory_order_relaxed);
+    m_retiredReleased += tc->released.load(std::memory_order_relaxed);
+
+    if (tc->prev) tc->prev->next = tc->next;
+    else m_caches = tc->next;
+    if (tc->next) tc->next->prev = tc->prev;
+}
+
+BufferPool::Stats BufferPool::GetStats() const
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    Stats s;
+    s.hits = m_retiredHits;
+    s.misses = m_retiredMisses;
+    s.oversize = m_retiredOversize;
+    s.trimmed = m_trimmed.load(std::memory_order_relaxed);
+    u64 acquired = m_retiredAcquired;
+    u64 released = m_retiredReleased;
+    for (ThreadCache* tc = m_caches; tc; tc = tc->next) {
+        s.hits += tc->hits.load(std::memory_order_relaxed);
+        s.misses += tc->misses.load(std::memory_order_relaxed);
+        s.oversize += tc->oversize.load(std::memory_order_relaxed);
+        acquired += tc->acquired.load(std::memory_order_relaxed);
+        released += tc->released.load(std::memory_order_relaxed);
+    }
+    s.outstanding = acquired > released ? acquired - released : 0;
+
+    s.cachedBytes = 0;
+    for (u32 i = 0; i < CLASS_COUNT; ++i) {
+        s.cachedBytes += (u64)m_central[i].count * ClassSize(i);
+    }
+    return s;
+}
+
+ECCS_END
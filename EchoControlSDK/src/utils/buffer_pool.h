@@ -0,0 +1,107 @@
+#pragma once
+#include "../global.h"
+#include <atomic>
+#include <mutex>
+
+ECCS_BEGIN
+
+//------------------------------------------------------
+// 按尺寸分级的缓冲池
+// * 64B ~ 64KB 共 11 级 (2 的幂)，超过 64KB 直接向堆申请 (计入 oversize)
+// * 每个线程缓存各级空闲块，取还不加锁；线程缓存满/空时与中心池成批交换
+// * 空闲块以块内首个指针串成链表，池本身不做额外分配
+// * Lease 为 RAII 租约，析构时归还到当前线程的缓存 (可跨线程归还)
+//------------------------------------------------------
+class BufferPool
+{
+    NON_COPYABLE(BufferPool);
+
+public:
+    static const u32 MIN_SHIFT = 6;                     // 64B
+    static const u32 MAX_SHIFT = 16;                    // 64KB
+    static const u32 CLASS_COUNT = MAX_SHIFT - MIN_SHIFT + 1;
+    static const u32 CACHE_BLOCKS = 32;                 // 线程缓存每级块数上限
+    static const size_t CENTRAL_BYTES = 1024 * 1024;    // 中心池每级保留字节上限
+
+    class Lease
+    {
+    public:
+        Lease() : m_data(NULL), m_size(0), m_class(0) {}
+        Lease(Lease&& other) noexcept;
+        Lease& operator=(Lease&& other) noexcept;
+        ~Lease() { Reset(); }
+
+        u8* Data() const { return m_data; }
+        size_t Capacity() const { return m_size; }
+        explicit operator bool() const { return m_data != NULL; }
+
+        // 提前归还
+        void Reset() { if (m_data) GiveBack(); }
+
+    private:
+        friend class BufferPool;
+        Lease(const Lease&);
+        Lease& operator=(const Lease&);
+        void GiveBack();
+
+        u8* m_data;
+        size_t m_size;
+        u32 m_class;    // CLASS_COUNT 表示超大块
+    };
+
+    struct Stats {
+        u64 hits;           // 从线程缓存或中心池取得
+        u64 misses;         // 新分配
+        u64 oversize;       // 超过最大级别
+        u64 trimmed;        // 中心池已满时释放回堆的块
+        u64 outstanding;    // 未归还的租约
+        u64 cachedBytes;    // 中心池空闲字节 (不含线程缓存)
+    };
+
+    // 进程内唯一实例 (不析构，线程退出时仍可归还)
+    static BufferPool& Instance();
+
+    // 至少 size 字节；size 为 0 时返回空租约
+    Lease Acquire(size_t size);
+
+    Stats GetStats() const;
+
+    static size_t ClassSize(u32 cls) { return (size_t)1 << (cls + MIN_SHIFT); }
+
+private:
+    struct ThreadCache;
+    struct FreeList {
+        void* head;
+        u32 count;
+    };
+
+    BufferPool();
+    ~BufferPool() {}
+
+    static u32 ClassOf(size_t size);
+    static ThreadCache& LocalCache();
+
+    void Release(u8* data, u32 cls);
+
+    // 线程缓存与中心池之间成批交换
+    u32 Refill(ThreadCache& tc, u32 cls);
+    void Spill(ThreadCache& tc, u32 cls, u32 keep);
+
+    void Register(ThreadCache* tc);
+    void Unregister(ThreadCache* tc);
+
+private:
+    mutable std::mutex m_mutex;
+    FreeList m_central[CLASS_COUNT];
+    ThreadCache* m_caches;      // 存活线程的缓存链表 (统计用)
+
+    // 已退出线程的计数
+    u64 m_retiredHits;
+    u64 m_retiredMisses;
+    u64 m_retiredOversize;
+    u64 m_retiredAcquired;
+    u64 m_retiredReleased;
+    std::atomic<u64> m_trimmed;
+};
+
+ECCS_END
@@ -0,0 +1,90 @@
+#include "checksum.h"
+
+#if defined(__SSE4_2__) || (defined(_MSC_VER) && defined(__AVX__))
+#  include <nmmintrin.h>
+#  define ECCS_CRC32C_SSE42 1
+#elif defined(__ARM_FEATURE_CRC32)
+#  include <arm_acle.h>
+#  define ECCS_CRC32C_ARM 1
+#endif
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#  include <emmintrin.h>
+#  define ECCS_SUM_SSE2 1
+#endif
+
+ECCS_BEGIN
+namespace checksum {
+
+bool HasHardwareCrc32C()
+{
+#if defined(ECCS_CRC32C_SSE42) || defined(ECCS_CRC32C_ARM)
+    return true;
+#else
+    return false;
+#endif
+}
+
+u32 Crc32C(const void* data, size_t len, u32 prev)
+{
+    const u8* p = (const u8*)data;
+
+#if defined(ECCS_CRC32C_SSE42)
+    u32 c = ~prev;
+#  if defined(_M_X64) || defined(__x86_64__)
+    u64 c64 = c;
+    for (; len >= 8; p += 8, len -= 8) {
+        u64 v;
+        memcpy(&v, p, 8);
+        c64 = _mm_crc32_u64(c64, v);
+    }
+    c = (u32)c64;
+#  endif
+    for (; len >= 4; p += 4, len -= 4) {
+        u32 v;
+        memcpy(&v, p, 4);
+        c = _mm_crc32_u32(c, v);
+    }
+    for (; len > 0; --len) c = _mm_crc32_u8(c, *p++);
+    return ~c;
+#elif defined(ECCS_CRC32C_ARM)
+    u32 c = ~prev;
+    for (; len >= 8; p += 8, len -= 8) {
+        u64 v;
+        memcpy(&v, p, 8);
+        c = __crc32cd(c, v);
+    }
+    for (; len > 0; --len) c = __crc32cb(c, *p++);
+    return ~c;
+#else
+    Crc32CTable crc;
+    crc.Continue(prev);     // Init 与 XorOut 均为全 1，prev = 0 即首段
+    crc.Update(p, len);
+    return crc.Final();
+#endif
+}
+
+u8 Sum8(const void* data, size_t len)
+{
+    const u8* p = (const u8*)data;
+    u32 sum = 0;
+
+#if defined(ECCS_SUM_SSE2)
+    // psadbw 与 0 相减求绝对值之和，即 8 字节一组的累加
+    if (len >= 16) {
+        __m128i acc = _mm_setzero_si128();
+        const __m128i zero = _mm_setzero_si128();
+        for (; len >= 16; p += 16, len -= 16) {
+            __m128i x = _mm_loadu_si128((const __m128i*)p);
+            acc = _mm_add_epi64(acc, _mm_sad_epu8(x, zero));
+        }
+        sum = (u32)_mm_cvtsi128_si32(acc) + (u32)_mm_cvtsi128_si32(_mm_srli_si128(acc, 8));
+    }
+#endif
+
+    for (; len > 0; --len) sum += *p++;
+    return (u8)sum;
+}
+
+}
+ECCS_END
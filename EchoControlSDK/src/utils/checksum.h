@@ -0,0 +1,165 @@
+#pragma once
+#include "../global.h"
+#include <string.h>
+
+ECCS_BEGIN
+namespace checksum {
+
+//------------------------------------------------------
+// 校验和模块
+// * Crc<T, Poly, Init, XorOut, Reflected>: 查找表在编译期生成 (constexpr)，
+//   反射型 (LSB 先行，如 Modbus/CRC32/CRC32C) 按 slicing-by-8 每次处理 8 字节，
+//   非反射型按字节查表
+// * Crc32C: 有 SSE4.2 (x86) 或 ARMv8 CRC 扩展时使用硬件指令，否则退回查表
+// * Sum8: 字节累加和 (Pelco-D / HL-525 校验)，SSE2 下 16 字节一组累加
+// * 参数与 CRC 目录 (reveng) 一致: Poly/Init 为非反射形式
+//------------------------------------------------------
+
+namespace detail {
+
+    // 编译期整数序列 (C++11 没有 std::index_sequence)
+    template<size_t... I> struct IndexSeq {};
+    template<size_t N, size_t... I> struct MakeSeq : MakeSeq<N - 1, N - 1, I...> {};
+    template<size_t... I> struct MakeSeq<0, I...> { typedef IndexSeq<I...> type; };
+
+    // C++11 constexpr 函数只能有一条 return，循环均写成递归
+    template<typename T>
+    constexpr T Reflect(T v, int bits, T acc = 0) {
+        return bits == 0 ? acc : Reflect<T>((T)(v >> 1), bits - 1, (T)((acc << 1) | (v & 1)));
+    }
+
+    // 反射型: 右移，多项式已反射
+    template<typename T>
+    constexpr T StepLsb(T c, T rpoly, int k) {
+        return k == 0 ? c : StepLsb<T>((c & 1) ? (T)((c >> 1) ^ rpoly) : (T)(c >> 1), rpoly, k - 1);
+    }
+
+    // 非反射型: 左移，最高位溢出时异或多项式
+    template<typename T>
+    constexpr T StepMsb(T c, T poly, int k) {
+        return k == 0 ? c : StepMsb<T>((c >> (sizeof(T) * 8 - 1)) ? (T)((c << 1) ^ poly) : (T)(c << 1), poly, k - 1);
+    }
+
+    template<typename T, T Poly, bool Reflected>
+    constexpr T ByteEntry(size_t i) {
+        return Reflected ? StepLsb<T>((T)i, Reflect<T>(Poly, sizeof(T) * 8), 8)
+                         : StepMsb<T>((T)((T)i << (sizeof(T) * 8 - 8)), Poly, 8);
+    }
+
+    // slicing 表: T[k][i] = T[k-1][i] 再过一个 0 字节
+    template<typename T, T Poly>
+    constexpr T SliceEntry(int k, size_t i) {
+        return k == 0 ? ByteEntry<T, Poly, true>(i)
+                      : (T)((SliceEntry<T, Poly>(k - 1, i) >> 8) ^ ByteEntry<T, Poly, true>(SliceEntry<T, Poly>(k - 1, i) & 0xFF));
+    }
+
+    template<typename T, T Poly, bool Reflected, typename Seq> struct ByteTable;
+    template<typename T, T Poly, bool Reflected, size_t... I>
+    struct ByteTable<T, Poly, Reflected, IndexSeq<I...>> {
+        static constexpr T data[256] = { ByteEntry<T, Poly, Reflected>(I)... };
+    };
+    template<typename T, T Poly, bool Reflected, size_t... I>
+    constexpr T ByteTable<T, Poly, Reflected, IndexSeq<I...>>::data[256];
+
+    template<typename T, T Poly, typename Seq> struct SliceTable;
+    template<typename T, T Poly, size_t... I>
+    struct SliceTable<T, Poly, IndexSeq<I...>> {
+        static constexpr T data[8][256] = {
+            { SliceEntry<T, Poly>(0, I)... }, { SliceEntry<T, Poly>(1, I)... },
+            { SliceEntry<T, Poly>(2, I)... }, { SliceEntry<T, Poly>(3, I)... },
+            { SliceEntry<T, Poly>(4, I)... }, { SliceEntry<T, Poly>(5, I)... },
+            { SliceEntry<T, Poly>(6, I)... }, { SliceEntry<T, Poly>(7, I)... },
+        };
+    };
+    template<typename T, T Poly, size_t... I>
+    constexpr T SliceTable<T, Poly, IndexSeq<I...>>::data[8][256];
+
+    inline u32 LoadLE32(const u8* p) {
+#if defined(__BYTE_ORDER__) && (__BYTE_ORDER__ == __ORDER_BIG_ENDIAN__)
+        return (u32)p[0] | ((u32)p[1] << 8) | ((u32)p[2] << 16) | ((u32)p[3] << 24);
+#else
+        u32 v;
+        memcpy(&v, p, 4);
+        return v;
+#endif
+    }
+}
+
+template<typename T, T Poly, T Init, T XorOut, bool Reflected>
+class Crc
+{
+public:
+    Crc() { Reset(); }
+
+    void Reset() { m_reg = Reflected ? detail::Reflect<T>(Init, sizeof(T) * 8) : Init; }
+
+    // 从上一段的 Final() 结果继续计算
+    void Continue(T prev) { m_reg = (T)(prev ^ XorOut); }
+
+    void Update(const void* data, size_t len) {
+        const u8* p = (const u8*)data;
+        m_reg = Reflected ? UpdateLsb(m_reg, p, len) : UpdateMsb(m_reg, p, len);
+    }
+
+    T Final() const { return (T)(m_reg ^ XorOut); }
+
+    static T Compute(const void* data, size_t len) {
+        Crc c;
+        c.Update(data, len);
+        return c.Final();
+    }
+
+private:
+    typedef detail::ByteTable<T, Poly, Reflected, typename detail::MakeSeq<256>::type> Table;
+    typedef detail::SliceTable<T, Poly, typename detail::MakeSeq<256>::type> Slices;
+
+    static T UpdateLsb(T reg, const u8* p, size_t len) {
+        const T (&t)[8][256] = Slices::data;
+        u32 c = reg;
+        while (len >= 8) {
+            // 寄存器位于低位，与前 4 字节对齐异或 (宽度 <= 32)
+            u32 lo = detail::LoadLE32(p) ^ c;
+            u32 hi = detail::LoadLE32(p + 4);
+            c = t[7][lo & 0xFF] ^ t[6][(lo >> 8) & 0xFF] ^ t[5][(lo >> 16) & 0xFF] ^ t[4][lo >> 24] ^
+                t[3][hi & 0xFF] ^ t[2][(hi >> 8) & 0xFF] ^ t[1][(hi >> 16) & 0xFF] ^ t[0][hi >> 24];
+            p += 8;
+            len -= 8;
+        }
+        while (len--) {
+            c = (c >> 8) ^ t[0][(c ^ *p++) & 0xFF];
+        }
+        return (T)c;
+    }
+
+    static T UpdateMsb(T reg, const u8* p, size_t len) {
+        const int shift = sizeof(T) * 8 - 8;
+        while (len--) {
+            reg = (T)((T)(reg << 8) ^ Table::data[((reg >> shift) ^ *p++) & 0xFF]);
+        }
+        return reg;
+    }
+
+private:
+    T m_reg;
+};
+
+// 常用算法 (check 值为 "123456789" 的结果)
+typedef Crc<u16, 0x8005, 0xFFFF, 0x0000, true>              Crc16Modbus;     // 0x4B37
+typedef Crc<u16, 0x1021, 0xFFFF, 0x0000, false>             Crc16CcittFalse; // 0x29B1
+typedef Crc<u32, 0x04C11DB7, 0xFFFFFFFF, 0xFFFFFFFF, true>  Crc32;           // 0xCBF43926
+typedef Crc<u32, 0x1EDC6F41, 0xFFFFFFFF, 0xFFFFFFFF, true>  Crc32CTable;     // 0xE3069283
+
+/**
+ * @brief CRC32C (Castagnoli)，可分段计算
+ * @param prev 上一段的结果 (首段为 0)
+ */
+u32 Crc32C(const void* data, size_t len, u32 prev = 0);
+
+// 是否使用硬件 CRC32C 指令 (编译期决定)
+bool HasHardwareCrc32C();
+
+// 字节累加和 (取低 8 位)
+u8 Sum8(const void* data, size_t len);
+
+}
+ECCS_END
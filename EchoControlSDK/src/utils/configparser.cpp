@@ -129,9 +129,9 @@ std::map<string, string> ConfigParser::GetSection(const string section)
 {
     auto it = _configValue.find(section);
     if (it != _configValue.end()) {
-        return it->second; // ظýµ map<key, value>
+        return it->second; // 返回该节下的 map<key, value>
     }
-    // ûҵؿ map
+    // 如果没找到，返回空 map
     return std::map<string, string>();
 }
 
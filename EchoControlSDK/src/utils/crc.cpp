@@ -1,3 +1,3 @@
-﻿
+
 #include "crc.h"
 
@@ -0,0 +1,132 @@
+#include "mapped_file.h"
+#ifdef _WIN32
+#include <Windows.h>
+#else
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#endif
+#include <errno.h>
+#include "../debug/Exceptions.h"
+#include "../debug/str_error.h"
+
+ECCS_BEGIN
+
+
+MappedFile::MappedFile()
+    : _data(NULL), _size(0)
+#ifdef _WIN32
+    , _file(NULL), _mapping(NULL)
+#endif
+{
+}
+
+MappedFile::MappedFile(const char* path)
+    : _data(NULL), _size(0)
+#ifdef _WIN32
+    , _file(NULL), _mapping(NULL)
+#endif
+{
+    open(path);
+}
+
+MappedFile::~MappedFile()
+{
+    close();
+}
+
+void MappedFile::open(const char* path)
+{
+    close();
+
+#ifdef _WIN32
+    HANDLE hFile = CreateFileA(path, GENERIC_READ, FILE_SHARE_READ, NULL,
+        OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL | FILE_FLAG_SEQUENTIAL_SCAN, NULL);
+    if (hFile == INVALID_HANDLE_VALUE) {
+        throw EIOException("MappedFile: open %s failed (%lu)", path, GetLastError());
+    }
+
+    LARGE_INTEGER li;
+    if (!GetFileSizeEx(hFile, &li) || li.QuadPart == 0) {
+        CloseHandle(hFile);
+        throw EIOException("MappedFile: %s is empty", path);
+    }
+
+    HANDLE hMap = CreateFileMappingA(hFile, NULL, PAGE_READONLY, 0, 0, NULL);
+    if (hMap == NULL) {
+        DWORD err = GetLastError();
+        CloseHandle(hFile);
+        throw EIOException("MappedFile: map %s failed (%lu)", path, err);
+    }
+
+    void* p = MapViewOfFile(hMap, FILE_MAP_READ, 0, 0, 0);
+    if (p == NULL) {
+        DWORD err = GetLastError();
+        CloseHandle(hMap);
+        CloseHandle(hFile);
+        throw EIOException("MappedFile: view %s failed (%lu)", path, err);
+    }
+
+    _file = hFile;
+    _mapping = hMap;
+    _data = (const u8*)p;
+    _size = (size_t)li.QuadPart;
+#else
+    int fd = ::open(path, O_RDONLY);
+    if (fd < 0) {
+        throw EIOException("MappedFile: open %s failed (%s)", path, strError(errno).c_str());
+    }
+
+    struct stat st;
+    if (fstat(fd, &st) != 0 || st.st_size == 0) {
+        ::close(fd);
+        throw EIOException("MappedFile: %s is empty", path);
+    }
+
+    void* p = mmap(NULL, (size_t)st.st_size, PROT_READ, MAP_SHARED, fd, 0);
+    ::close(fd);    // 映射建立后即可关闭描述符
+    if (p == MAP_FAILED) {
+        throw EIOException("MappedFile: mmap %s failed (%s)", path, strError(errno).c_str());
+    }
+    madvise(p, (size_t)st.st_size, MADV_SEQUENTIAL);
+
+    _data = (const u8*)p;
+    _size = (size_t)st.st_size;
+#endif
+}
+
+void MappedFile::close()
+{
+    if (!_data) return;
+
+#ifdef _WIN32
+    UnmapViewOfFile(_data);
+    CloseHandle((HANDLE)_mapping);
+    CloseHandle((HANDLE)_file);
+    _mapping = NULL;
+    _file = NULL;
+#else
+    munmap((void*)_data, _size);
+#endif
+    _data = NULL;
+    _size = 0;
+}
+
+bool MappedFile::isOpen() const
+{
+    return _data != NULL;
+}
+
+const u8* MappedFile::data() const
+{
+    return _data;
+}
+
+size_t MappedFile::size() const
+{
+    return _size;
+}
+
+
+ECCS_END
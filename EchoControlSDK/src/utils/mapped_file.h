@@ -0,0 +1,36 @@
+#pragma once
+#include <stddef.h>
+#include "../global.h"
+
+ECCS_BEGIN
+
+
+// 只读内存映射文件 (Linux: mmap, Windows: CreateFileMapping)
+// 多个实例映射同一文件时共享页缓存，适合大量并发读取
+class MappedFile
+{
+    NON_COPYABLE(MappedFile);
+
+public:
+    MappedFile();
+    MappedFile(const char* path);   // 失败抛出 EIOException
+    ~MappedFile();
+
+    void open(const char* path);    // 失败抛出 EIOException
+    void close();
+
+    bool isOpen() const;
+    const u8* data() const;
+    size_t size() const;
+
+private:
+    const u8*   _data;
+    size_t      _size;
+#ifdef _WIN32
+    void*       _file;
+    void*       _mapping;
+#endif
+};
+
+
+ECCS_END
@@ -12,7 +12,7 @@ size_t RingBuffer::Write(const u8* data, size_t len)
 {
     std::lock_guard<std::mutex> lock(m_mutex);
     size_t written = 0;
-    // ʵ֣ռ䲻Ͷֻдһ (ʵʱ鶪ݣΪֻдʣռ)
+    // 简单实现：空间不够就丢弃或只写一部分 (实时流建议丢弃旧数据，这里简化为只写剩余空间)
     size_t available = (m_capacity + m_tail - m_head - 1) % m_capacity;
     if (available < len) len = available;
 
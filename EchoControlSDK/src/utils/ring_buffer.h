@@ -10,14 +10,17 @@ class RingBuffer {
 public:
     RingBuffer(size_t size);
 
-    // д
+    // 写入数据
     size_t Write(const u8* data, size_t len);
 
-    // ȡ
+    // 读取数据
     size_t Read(u8* outData, size_t len);
 
     size_t Available();
 
+    // 可缓存的最大字节数
+    size_t Capacity() const { return m_capacity - 1; }
+
 private:
     std::vector<u8> m_buffer;
     size_t m_head, m_tail, m_capacity;
@@ -1,4 +1,4 @@
-﻿
+
 #pragma once
 #include "../global.h"
 #include "../debug/logger.h"
@@ -1,4 +1,4 @@
-﻿
+
 #include "utils.h"
 #include <assert.h>
 #ifdef _WIN32
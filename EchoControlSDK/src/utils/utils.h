@@ -1,4 +1,4 @@
-﻿
+
 #pragma once
 #ifdef linux
 #include <unistd.h>         // for getpid and usleep
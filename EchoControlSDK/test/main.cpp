@@ -8,23 +8,23 @@
 #include <atomic>
 #include <cstring>
 
-// ȫϵͳ
+// 全局系统句柄
 ECCS_HANDLE g_hSystem = nullptr;
 std::atomic<bool> g_simulatingStream(false);
 std::thread* g_streamThread = nullptr;
 
 // ---------------------------------------------------------
-// ص
+// 回调函数
 // ---------------------------------------------------------
 void SystemCallback(ECCS_HANDLE hDev, ECCS_EventType type, const void* data, int len, void* userCtx) {
-    // ע⣺hDev ﴫҲϵͳ߾豸ȡSDKʵ
-    // Ϊûֻ¼
+    // 注意：hDev 这里传回来的也是系统句柄，或者具体设备句柄，取决于SDK实现
+    // 但作为用户，我们只关心事件类型
     switch (type) {
     case ECCS_EVT_STATUS_CHANGE:
         printf("\n[Callback] Device Status Changed!\n> ");
         break;
     case ECCS_EVT_PTZ_ANGLE:
-        // data  PtzPosition ṹ
+        // data 是 PtzPosition 结构体
         printf("\n[Callback] PTZ Angle Reported.\n> ");
         break;
     case ECCS_EVT_SOUND_FINISH:
@@ -36,7 +36,7 @@ void SystemCallback(ECCS_HANDLE hDev, ECCS_EventType type, const void* data, int
 }
 
 // ---------------------------------------------------------
-// ģƵ
+// 模拟音频流推送
 // ---------------------------------------------------------
 void SimulateAudioStream() {
     printf("[Test] Audio Stream Simulation Started.\n");
@@ -45,7 +45,7 @@ void SimulateAudioStream() {
 
     while (g_simulatingStream) {
         if (g_hSystem) {
-            // ֱƸϵͳSDKڲԶ·ɸǿģ
+            // 直接推给系统句柄，SDK内部会自动路由给强声模块
             ECCS_Error err = ECCS_Sound_PushData(g_hSystem, dummyData, sizeof(dummyData));
             if (err != ECCS_SUCCESS) {
                 // printf("[Test] Push Data Failed: %d\n", err);
@@ -98,7 +98,7 @@ int main() {
         if (cmd == "init") {
             ECCS_Error err = ECCS_Init();
             if (err == ECCS_SUCCESS) {
-                // ȡΨһϵͳ
+                // 获取唯一的系统句柄
                 g_hSystem = ECCS_GetHandle();
                 if (g_hSystem) {
                     ECCS_RegisterCallback(g_hSystem, SystemCallback, nullptr);
@@ -123,13 +123,13 @@ int main() {
             continue;
         }
 
-        // Ҫ
+        // 下面的命令都需要句柄
         if (!g_hSystem) {
             std::cout << "Please 'init' first." << std::endl;
             continue;
         }
 
-        // --- ҵָ ---
+        // --- 业务指令 ---
         if (cmd == "light") {
             std::string subCmd; ss >> subCmd;
             int val; ss >> val;
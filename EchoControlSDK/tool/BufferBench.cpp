@@ -0,0 +1,123 @@
+#define _CRT_SECURE_NO_WARNINGS
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <functional>
+#include <vector>
+#include "protocol/PacketView.hpp"
+#include "utils/buffer.h"
+
+USING_ECCS
+
+// --------------------------------------------------------
+// Buffer 微基准 (以编码为主的负载)
+// * command : 每条设备指令 (7~12 字节) 使用独立的 Buffer
+// * packet  : RpcPacket 编码到新 Buffer (网关应答/推送)
+// * batch   : 一批推送追加到同一个新 Buffer (容量增长)
+// * stream  : 接收缓冲: 尾部收数据、队首逐帧弹出
+// * queue   : 编码后的帧移入 std::vector<Buffer> 发送队列
+// 最后输出 BufferPool 命中统计
+// 用法: BufferBench [iterations=2000000]
+// --------------------------------------------------------
+
+typedef std::chrono::steady_clock Clock;
+
+static volatile size_t g_sink;
+
+static void Run(const char* name, u32 ops, const std::function<size_t()>& fn)
+{
+    Clock::time_point t0 = Clock::now();
+    g_sink = fn();
+    double ns = std::chrono::duration<double, std::nano>(Clock::now() - t0).count() / ops;
+    printf("%-10s %10.1f ns/op\n", name, ns);
+}
+
+int main(int argc, char* argv[])
+{
+    u32 iterations = argc > 1 ? (u32)atoi(argv[1]) : 2000000;
+    if (iterations < 1000) {
+        printf("Usage: %s [iterations>=1000]\n", argv[0]);
+        return 1;
+    }
+
+    // Pelco-D 帧 7 字节，Modbus-TCP 写线圈 12 字节
+    const char pelco[7] = { (char)0xFF, 0x01, 0x00, 0x04, 0x20, 0x00, 0x25 };
+    const char modbus[12] = { 0x00, 0x01, 0x00, 0x00, 0x00, 0x06, 0x01, 0x05, 0x00, 0x02, (char)0xFF, 0x00 };
+
+    Run("command", iterations, [&]() {
+        size_t total = 0;
+        for (u32 i = 0; i < iterations; ++i) {
+            Buffer b;
+            if (i & 1) b.push_back(pelco, sizeof(pelco));
+            else b.push_back(modbus, sizeof(modbus));
+            total += b.size();
+        }
+        return total;
+    });
+
+    rpc::RqLightLevel level(50);
+    Run("packet", iterations, [&]() {
+        size_t total = 0;
+        for (u32 i = 0; i < iterations; ++i) {
+            Buffer b;
+            level.SetSeq(i);
+            level.Encode(b);
+            total += b.size();
+        }
+        return total;
+    });
+
+    const u32 batchSize = 256;
+    u32 batches = iterations / batchSize;
+    Run("batch", batches * batchSize, [&]() {
+        size_t total = 0;
+        for (u32 n = 0; n < batches; ++n) {
+            Buffer b;
+            for (u32 i = 0; i < batchSize; ++i) level.Encode(b);
+            total += b.size();
+        }
+        return total;
+    });
+
+    // 每次收 4 KB (含若干 12 字节帧)，处理一半帧后再收，模拟半包残留
+    Buffer rx;
+    char chunk[4096];
+    for (size_t i = 0; i < sizeof(chunk); ++i) chunk[i] = modbus[i % sizeof(modbus)];
+    u32 frames = 0;
+    Run("stream", iterations, [&]() {
+        size_t total = 0;
+        while (frames < iterations) {
+            rx.push_back(chunk, sizeof(chunk));
+            while (rx.size() >= sizeof(modbus) * 2 && frames < iterations) {
+                total += (u8)rx[0];
+                rx.pop_front(sizeof(modbus));
+                ++frames;
+            }
+        }
+        return total;
+    });
+
+    Run("queue", iterations, [&]() {
+        size_t total = 0;
+        std::vector<Buffer> q;
+        q.reserve(batchSize);
+        for (u32 i = 0; i < iterations; ++i) {
+            Buffer b(modbus, sizeof(modbus));
+            q.push_back(std::move(b));
+            if (q.size() == batchSize) {
+                for (auto& f : q) total += f.size();
+                q.clear();
+            }
+        }
+        return total;
+    });
+
+    // 以上负载均已结束，稳态下 misses 应只来自各级首次分配
+    BufferPool::Stats ps = BufferPool::Instance().GetStats();
+    printf("Pool: hits %llu, misses %llu, oversize %llu, trimmed %llu, outstanding %llu\n",
+        (unsigned long long)ps.hits, (unsigned long long)ps.misses, (unsigned long long)ps.oversize,
+        (unsigned long long)ps.trimmed, (unsigned long long)ps.outstanding);
+
+    return 0;
+}
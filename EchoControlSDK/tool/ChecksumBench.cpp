@@ -0,0 +1,89 @@
+#define _CRT_SECURE_NO_WARNINGS
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <functional>
+#include <vector>
+#include "utils/checksum.h"
+#include "utils/crc.h"
+
+USING_ECCS
+
+// --------------------------------------------------------
+// 校验和吞吐对比工具
+// 对比旧 CRC 模板 (utils/crc.hpp，逐字节查表) 与 checksum.h 的实现，
+// 并校验两者在同一数据上的结果一致
+// 用法: ChecksumBench [size=4096] [megabytes=256]
+// --------------------------------------------------------
+
+typedef std::chrono::steady_clock Clock;
+
+static volatile u32 g_sink;
+
+// 返回 GB/s
+static double Measure(const std::vector<u8>& data, u64 totalBytes, const std::function<u32(const u8*, size_t)>& fn)
+{
+    u64 rounds = std::max<u64>(1, totalBytes / data.size());
+    u32 acc = 0;
+    Clock::time_point t0 = Clock::now();
+    for (u64 i = 0; i < rounds; ++i) acc ^= fn(data.data(), data.size());
+    double sec = std::chrono::duration<double>(Clock::now() - t0).count();
+    g_sink = acc;
+    return (double)rounds * data.size() / sec / 1e9;
+}
+
+int main(int argc, char* argv[])
+{
+    size_t size = argc > 1 ? (size_t)atoi(argv[1]) : 4096;
+    u64 total = (argc > 2 ? (u64)atoi(argv[2]) : 256) << 20;
+    if (size == 0 || total == 0) {
+        printf("Usage: %s [size=4096] [megabytes=256]\n", argv[0]);
+        return 1;
+    }
+
+    std::vector<u8> data(size);
+    srand(1);
+    for (auto& b : data) b = (u8)rand();
+
+    // 结果一致性 (旧模板按 reveng 参数构造)
+    CRC16_8005 oldModbus(0xFFFF, 0, true, true);
+    CRC32_04C11DB7 oldCrc32(0xFFFFFFFF, 0xFFFFFFFF, true, true);
+    bool ok = true;
+    if (oldModbus.calc(data.data(), size) != checksum::Crc16Modbus::Compute(data.data(), size)) {
+        printf("Crc16Modbus mismatch\n");
+        ok = false;
+    }
+    if (oldCrc32.calc(data.data(), size) != checksum::Crc32::Compute(data.data(), size)) {
+        printf("Crc32 mismatch\n");
+        ok = false;
+    }
+    if (checksum::Crc32C(data.data(), size) != checksum::Crc32CTable::Compute(data.data(), size)) {
+        printf("Crc32C mismatch\n");
+        ok = false;
+    }
+
+    printf("Buffer %zu bytes, %llu MB per case, hardware CRC32C: %s\n",
+        size, (unsigned long long)(total >> 20), checksum::HasHardwareCrc32C() ? "yes" : "no");
+    printf("%-24s %8s\n", "Algorithm", "GB/s");
+
+    struct Case {
+        const char* name;
+        std::function<u32(const u8*, size_t)> fn;
+    };
+    std::vector<Case> cases = {
+        { "CRC16_8005 (old)",   [&](const u8* p, size_t n) { return (u32)oldModbus.calc((u8*)p, n); } },
+        { "Crc16Modbus",        [](const u8* p, size_t n) { return (u32)checksum::Crc16Modbus::Compute(p, n); } },
+        { "Crc16CcittFalse",    [](const u8* p, size_t n) { return (u32)checksum::Crc16CcittFalse::Compute(p, n); } },
+        { "CRC32_04C11DB7 (old)", [&](const u8* p, size_t n) { return oldCrc32.calc((u8*)p, n); } },
+        { "Crc32",              [](const u8* p, size_t n) { return checksum::Crc32::Compute(p, n); } },
+        { "Crc32CTable",        [](const u8* p, size_t n) { return checksum::Crc32CTable::Compute(p, n); } },
+        { "Crc32C",             [](const u8* p, size_t n) { return checksum::Crc32C(p, n); } },
+        { "Sum8",               [](const u8* p, size_t n) { return (u32)checksum::Sum8(p, n); } },
+    };
+
+    for (Case& c : cases) {
+        printf("%-24s %8.2f\n", c.name, Measure(data, total, c.fn));
+    }
+
+    return ok ? 0 : 2;
+}
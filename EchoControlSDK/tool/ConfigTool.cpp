@@ -7,13 +7,13 @@
 #include "device/DeviceID.h"
 
 // --------------------------------------------------------
-// ID  ( DeviceID.h һ)
+// ID 定义 (必须与 DeviceID.h 保持一致)
 // --------------------------------------------------------
 typedef unsigned int u32;
 USING_ECCS
 
 // --------------------------------------------------------
-// ߼
+// 生成逻辑
 // --------------------------------------------------------
 
 void GenerateDeviceConfig(const std::string& path) {
@@ -25,8 +25,8 @@ void GenerateDeviceConfig(const std::string& path) {
 
     file << "# EchoControl System Configuration\n\n";
 
-    // 1. ǿ豸 (Slot 1)
-    // Model: HL-525 (Ӧ Factory ע)
+    // 1. 强光设备 (Slot 1)
+    // Model: HL-525 (对应 Factory 注册名)
     // ID: 0x01000201 (Light | HL-525 | Index 1)
     u32 id1 = DeviceID(did::DeviceType::DEVICE_LIGHT, did::LightModel::LIGHT_HL_525_4W, 1).Value();
     char buf1[32]; 
@@ -37,12 +37,12 @@ void GenerateDeviceConfig(const std::string& path) {
     file << "Name=MainLight\n";
     file << "Type=Light\n";
     file << "Model=HL-525\n";
-    file << "ID=" << buf1 << "\n"; // ƥ䣬SDKУʧ
+    file << "ID=" << buf1 << "\n"; // 必须匹配，否则SDK校验失败
     file << "IP=192.168.1.100\n";
     file << "Port=8000\n";
     file << "\n";
 
-    // 2. ̨豸 (Slot 2)
+    // 2. 云台设备 (Slot 2)
     u32 id2 = DeviceID(did::DeviceType::DEVICE_PTZ, did::PTZModel::PTZ_YZ_BY010W, 1).Value();
     char buf2[32]; 
     snprintf(buf2, 32, "0x%08X", id2);
@@ -57,7 +57,7 @@ void GenerateDeviceConfig(const std::string& path) {
     file << "Port=5000\n";
     file << "\n";
 
-    // 3. ǿ豸 (Slot 3)
+    // 3. 强声设备 (Slot 3)
     u32 id3 = DeviceID(did::DeviceType::DEVICE_SOUND, did::SoundModel::SOUND_NETSPEAKER_V2, 1).Value();
     char buf3[32]; 
     snprintf(buf3, 32, "0x%08X", id3);
@@ -72,7 +72,7 @@ void GenerateDeviceConfig(const std::string& path) {
     file << "Port=9527\n";
     file << "\n";
 
-    // 豸 Slot 4
+    // 超声设备 （Slot 4）
     u32 id4 = DeviceID(did::DeviceType::DEVICE_ULTRASONIC, did::UltrasonicModel::ULTRASONIC_TAS_IO_428R2, 1).Value();
     char buf4[32];
     snprintf(buf4, 32, "0x%08X", id4);
@@ -100,7 +100,7 @@ void GenerateGlobalConfig(const std::string& path) {
 }
 
 int main() {
-    // 򵥴ļָ (Windows)
+    // 简单创建文件夹指令 (Windows)
     system("mkdir config 2>nul");
 
     GenerateGlobalConfig("./config/global.cfg");
@@ -0,0 +1,195 @@
+#define _CRT_SECURE_NO_WARNINGS
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <functional>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+#include "net/TCPSocket.h"
+#include "protocol/PacketView.hpp"
+
+USING_ECCS
+
+// --------------------------------------------------------
+// 远程控制网关压测工具
+// 每个连接保持 window 个未应答请求 (RqLightLevel)，按 cseq 匹配 Rp 应答计算往返延迟
+// format=compact 时使用紧凑编码 (CompactCodec.h)，compact-crc 为附带 CRC32C 的 v2，
+// 结果附带每条指令的线上字节数
+// 用法: GatewayBench <host> <port> [connections=4] [requests=10000] [window=32] [format=fixed|compact|compact-crc]
+// --------------------------------------------------------
+
+typedef std::chrono::steady_clock Clock;
+
+// 网关按 PacketHeader 分帧，直接 send 原始字节
+// (TcpSocket::write 对 512~1500 字节的数据会插入分包标记)
+static void SendAll(HD_SOCKET sock, const char* data, size_t len)
+{
+    while (len > 0) {
+        int n = (int)send(sock, data, (int)len, 0);
+        if (n <= 0) throw std::runtime_error("send failed");
+        data += n;
+        len -= (size_t)n;
+    }
+}
+
+struct ConnResult {
+    std::vector<u32> latencyUs;
+    u64 errors;         // 应答码非 0
+    u64 txBytes;
+    u64 rxBytes;
+    bool failed;
+    std::string what;
+
+    ConnResult() : errors(0), txBytes(0), rxBytes(0), failed(false) {}
+};
+
+// 读取应答码: 定长帧直接引用缓冲中的 Result，紧凑帧解码包体
+static bool ReadReplyCode(const rpc::RawPacketView& view, u32& code)
+{
+    if (!view.Is<rpc::RpLightLevel>()) return false;
+    if (view.IsCompact()) {
+        rpc::Result r;
+        rpc::CompactReader reader(view.Body(), view.BodyLen());
+        rpc::CompactCodec<rpc::Result>::Read(reader, r);
+        if (!reader.Ok()) throw std::runtime_error("bad compact reply");
+        code = r.code;
+        return true;
+    }
+    rpc::PacketView<rpc::RpLightLevel> rp(view);
+    if (!rp.Valid()) return false;
+    code = rp->code;
+    return true;
+}
+
+static void RunConnection(const std::string& host, int port, u32 requests, u32 window, u8 compact, ConnResult& res)
+{
+    const u32 HDR = sizeof(rpc::PacketHeader);
+
+    try {
+        TcpSocket sock(host, port);
+        sock.setConnTimeout(3000);
+        sock.setRecvTimeout(5000);
+        sock.open();
+        sock.setNoDelay(true);
+
+        std::vector<Clock::time_point> sendTime(requests);
+        res.latencyUs.reserve(requests);
+
+        Buffer out(window * (HDR + 1));
+        std::vector<u8> in(64 * 1024);
+        size_t inLen = 0;
+        u32 sent = 0, recvd = 0;
+
+        while (recvd < requests) {
+            // 补满窗口，一次写出
+            out.clear();
+            Clock::time_point now = Clock::now();
+            while (sent < requests && sent - recvd < window) {
+                rpc::RqLightLevel pkt((u8)(sent % 100));
+                pkt.SetSeq(sent);
+                if (compact) pkt.EncodeCompact(out, compact);
+                else pkt.Encode(out);
+                sendTime[sent++] = now;
+            }
+            if (out.size() > 0) SendAll(sock.socket(), out.buf(), out.size());
+            res.txBytes += out.size();
+
+            u32 n = sock.read(&in[inLen], (u32)(in.size() - inLen));
+            if (n == 0) throw std::runtime_error("connection closed by gateway");
+            inLen += n;
+            res.rxBytes += n;
+            now = Clock::now();
+
+            size_t off = 0;
+            for (;;) {
+                rpc::RawPacketView view;
+                rpc::RawPacketView::Status st = view.Parse(&in[off], inLen - off);
+                if (st == rpc::RawPacketView::VIEW_BAD_HEADER) throw std::runtime_error("bad frame magic");
+                if (st == rpc::RawPacketView::VIEW_NEED_MORE) break;
+
+                // 只统计本工具请求的应答，推送包忽略
+                u32 code;
+                if (ReadReplyCode(view, code) && view.Seq() < sent) {
+                    if (code != 0) ++res.errors;
+                    res.latencyUs.push_back((u32)std::chrono::duration_cast<std::chrono::microseconds>(
+                        now - sendTime[view.Seq()]).count());
+                    ++recvd;
+                }
+                off += view.FrameLen();
+            }
+            if (off > 0) {
+                memmove(&in[0], &in[off], inLen - off);
+                inLen -= off;
+            }
+        }
+    }
+    catch (std::exception& e) {
+        res.failed = true;
+        res.what = e.what();
+    }
+}
+
+int main(int argc, char* argv[])
+{
+    if (argc < 3) {
+        printf("Usage: %s <host> <port> [connections=4] [requests=10000] [window=32] [format=fixed|compact|compact-crc]\n", argv[0]);
+        return 1;
+    }
+
+    std::string host = argv[1];
+    int port = atoi(argv[2]);
+    int conns = argc > 3 ? atoi(argv[3]) : 4;
+    u32 requests = argc > 4 ? (u32)atoi(argv[4]) : 10000;
+    u32 window = argc > 5 ? (u32)atoi(argv[5]) : 32;
+    std::string format = argc > 6 ? argv[6] : "fixed";
+    // 0 为定长帧，否则为紧凑编码版本
+    u8 compact = format == "compact" ? rpc::COMPACT_VERSION_PLAIN : format == "compact-crc" ? rpc::COMPACT_VERSION_CRC : 0;
+    if (conns <= 0 || requests == 0 || window == 0 || (!compact && format != "fixed")) {
+        printf("Invalid arguments\n");
+        return 1;
+    }
+
+    printf("Gateway %s:%d, %d connections x %u requests, window %u, %s encoding\n",
+        host.c_str(), port, conns, requests, window, format.c_str());
+
+    std::vector<ConnResult> results(conns);
+    std::vector<std::thread> threads;
+
+    Clock::time_point start = Clock::now();
+    for (int i = 0; i < conns; ++i) {
+        threads.emplace_back(RunConnection, host, port, requests, window, compact, std::ref(results[i]));
+    }
+    for (auto& t : threads) t.join();
+    double seconds = std::chrono::duration<double>(Clock::now() - start).count();
+
+    std::vector<u32> all;
+    u64 errors = 0, tx = 0, rx = 0;
+    for (int i = 0; i < conns; ++i) {
+        if (results[i].failed) {
+            printf("Connection %d failed: %s\n", i, results[i].what.c_str());
+        }
+        all.insert(all.end(), results[i].latencyUs.begin(), results[i].latencyUs.end());
+        errors += results[i].errors;
+        tx += results[i].txBytes;
+        rx += results[i].rxBytes;
+    }
+    if (all.empty()) {
+        printf("No replies received\n");
+        return 2;
+    }
+
+    std::sort(all.begin(), all.end());
+    auto pct = [&all](double p) { return all[std::min(all.size() - 1, (size_t)(p * all.size()))]; };
+
+    printf("Completed : %zu replies in %.3f s (%zu error codes)\n", all.size(), seconds, (size_t)errors);
+    printf("Throughput: %.0f commands/sec\n", all.size() / seconds);
+    printf("Latency   : p50 %u us, p99 %u us, max %u us\n", pct(0.50), pct(0.99), all.back());
+    printf("Wire      : %.1f bytes/command sent, %.1f received (incl. pushes)\n",
+        (double)tx / all.size(), (double)rx / all.size());
+    return 0;
+}
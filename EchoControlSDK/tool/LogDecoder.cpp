@@ -0,0 +1,139 @@
+#define _CRT_SECURE_NO_WARNINGS
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <map>
+#include <string>
+#include <vector>
+#include "debug/BinaryLog.h"
+
+USING_ECCS
+
+// --------------------------------------------------------
+// 二进制日志 (.blog) 离线还原
+// 按文件中的格式定义还原每条记录，输出与文本日志相同的行
+// 用法: LogDecoder <file.blog> [out.log]  (缺省输出到 stdout)
+// --------------------------------------------------------
+
+struct Format {
+    std::string fmt;
+    std::string types;
+    std::string function;
+    binlog::FormatInfo info;
+};
+
+static bool ReadFile(const char* path, std::vector<u8>& data)
+{
+    FILE* f = fopen(path, "rb");
+    if (!f) return false;
+    u8 chunk[64 * 1024];
+    size_t n;
+    while ((n = fread(chunk, 1, sizeof(chunk), f)) > 0) {
+        data.insert(data.end(), chunk, chunk + n);
+    }
+    fclose(f);
+    return true;
+}
+
+// 格式定义: u32 ID, u32 行号, 格式串\0 参数类型\0 函数名\0
+static bool ParseFormat(const u8* body, size_t len, u8 level, std::map<u32, Format>& formats)
+{
+    if (len < 8) return false;
+    u32 id, line;
+    memcpy(&id, body, 4);
+    memcpy(&line, body + 4, 4);
+
+    const char* strs[3];
+    size_t pos = 8;
+    for (int i = 0; i < 3; ++i) {
+        const void* end = memchr(body + pos, 0, len - pos);
+        if (!end) return false;
+        strs[i] = (const char*)body + pos;
+        pos = (const u8*)end - body + 1;
+    }
+
+    Format& f = formats[id];
+    f.fmt = strs[0];
+    f.types = strs[1];
+    f.function = strs[2];
+    f.info.fmt = f.fmt.c_str();
+    f.info.types = f.types.c_str();
+    f.info.function = f.function.empty() ? NULL : f.function.c_str();
+    f.info.line = line;
+    f.info.level = (char)level;
+    return true;
+}
+
+int main(int argc, char* argv[])
+{
+    if (argc < 2) {
+        printf("Usage: %s <file.blog> [out.log]\n", argv[0]);
+        return 1;
+    }
+
+    std::vector<u8> data;
+    if (!ReadFile(argv[1], data)) {
+        fprintf(stderr, "Cannot read %s\n", argv[1]);
+        return 1;
+    }
+    binlog::FileHeader hdr;
+    if (data.size() < sizeof(hdr) || memcmp(data.data(), binlog::FILE_MAGIC, sizeof(hdr.magic)) != 0) {
+        fprintf(stderr, "%s is not a binary log\n", argv[1]);
+        return 1;
+    }
+    memcpy(&hdr, data.data(), sizeof(hdr));
+    if (hdr.version != binlog::FILE_VERSION) {
+        fprintf(stderr, "Unsupported binary log version %u\n", hdr.version);
+        return 1;
+    }
+
+    FILE* out = argc > 2 ? fopen(argv[2], "w") : stdout;
+    if (!out) {
+        fprintf(stderr, "Cannot create %s\n", argv[2]);
+        return 1;
+    }
+
+    std::map<u32, Format> formats;
+    binlog::PrefixCache prefix;
+    char line[binlog::PREFIX_LEN + 2048];
+    u64 records = 0, unknown = 0;
+    size_t pos = sizeof(hdr);
+    while (pos + sizeof(binlog::RecordHead) <= data.size()) {
+        binlog::RecordHead h;
+        memcpy(&h, data.data() + pos, sizeof(h));
+        size_t recLen = sizeof(h) + h.len;
+        if (pos + recLen > data.size()) break;
+        const u8* body = data.data() + pos + sizeof(h);
+        pos += recLen;
+
+        if (h.kind == binlog::REC_FORMAT) {
+            if (!ParseFormat(body, h.len, h.level, formats)) {
+                fprintf(stderr, "Bad format definition at offset %zu\n", pos - recLen);
+            }
+            continue;
+        }
+        if (h.kind != binlog::REC_BINARY || h.len < 4) {
+            continue;
+        }
+
+        u32 id;
+        memcpy(&id, body, 4);
+        std::map<u32, Format>::const_iterator it = formats.find(id);
+        if (it == formats.end()) {
+            ++unknown;
+            continue;
+        }
+        prefix.Format(line, h.stamp, hdr.tzSeconds, (char)h.level);
+        size_t n = binlog::FormatArgs(it->second.info, body + 4, h.len - 4,
+            line + binlog::PREFIX_LEN, sizeof(line) - binlog::PREFIX_LEN);
+        fwrite(line, 1, binlog::PREFIX_LEN + n, out);
+        ++records;
+    }
+
+    if (out != stdout) fclose(out);
+    fprintf(stderr, "%llu records, %zu formats", (unsigned long long)records, formats.size());
+    if (unknown) fprintf(stderr, ", %llu without definition", (unsigned long long)unknown);
+    if (pos < data.size()) fprintf(stderr, ", %zu trailing bytes (truncated file)", data.size() - pos);
+    fprintf(stderr, "\n");
+    return 0;
+}
@@ -0,0 +1,141 @@
+#define _CRT_SECURE_NO_WARNINGS
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <vector>
+#include "device/Sound/AudioMixer.h"
+
+USING_ECCS
+
+// --------------------------------------------------------
+// 混音吞吐工具
+// 按 1..16 路源测量 AudioMixer::Mix 每帧耗时，换算单核可实时混合的路数，
+// 并与标量参考实现 (含优先级压低) 逐采样比对
+// 用法: MixerBench [rate=16000] [frameMs=20] [frames=20000]
+// --------------------------------------------------------
+
+typedef std::chrono::steady_clock Clock;
+
+static volatile i32 g_sink;
+
+// 每次返回同一段固定数据的源，排除取数开销
+class ConstSource : public AudioSource
+{
+public:
+    ConstSource(u32 samples, int seed) : m_data(samples)
+    {
+        srand(seed);
+        for (auto& s : m_data) s = (i16)(rand() - RAND_MAX / 2);
+    }
+
+    virtual u32 Fetch(const i16*& data, u32 count) override
+    {
+        data = m_data.data();
+        return count < (u32)m_data.size() ? count : (u32)m_data.size();
+    }
+
+    const std::vector<i16>& Data() const { return m_data; }
+
+private:
+    std::vector<i16> m_data;
+};
+
+static i16 ToQ14(float gain)
+{
+    return (i16)(gain * 16384.0f + 0.5f);
+}
+
+// 标量参考: 与 AudioMixer 的定点规则一致
+static void MixReference(const std::vector<std::shared_ptr<ConstSource>>& srcs, const std::vector<u8>& prio,
+    const std::vector<float>& gain, float duck, u32 samples, std::vector<i16>& out)
+{
+    int top = -1;
+    for (u8 p : prio) if (p > top) top = p;
+
+    std::vector<i32> acc(samples, 0);
+    for (size_t k = 0; k < srcs.size(); ++k) {
+        i16 g = ToQ14(gain[k]);
+        if (prio[k] < top) g = (i16)(((i32)g * ToQ14(duck)) >> 14);
+        const std::vector<i16>& d = srcs[k]->Data();
+        for (u32 i = 0; i < samples; ++i) acc[i] += ((i32)d[i] * g) >> 14;
+    }
+
+    out.resize(samples);
+    for (u32 i = 0; i < samples; ++i) {
+        i32 v = acc[i];
+        out[i] = (i16)(v > 32767 ? 32767 : (v < -32768 ? -32768 : v));
+    }
+}
+
+int main(int argc, char* argv[])
+{
+    u32 rate = argc > 1 ? (u32)atoi(argv[1]) : 16000;
+    u32 frameMs = argc > 2 ? (u32)atoi(argv[2]) : 20;
+    u32 frames = argc > 3 ? (u32)atoi(argv[3]) : 20000;
+    u32 samples = rate * frameMs / 1000;
+    if (samples == 0 || frames == 0) {
+        printf("Usage: %s [rate=16000] [frameMs=20] [frames=20000]\n", argv[0]);
+        return 1;
+    }
+
+#if defined(__AVX2__)
+    const char* kernel = "AVX2";
+#elif defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+    const char* kernel = "SSE2";
+#else
+    const char* kernel = "scalar";
+#endif
+
+    // 结果一致性: 16 路，两档优先级，增益覆盖衰减与放大
+    bool ok = true;
+    {
+        const float duck = 0.3f;
+        std::vector<std::shared_ptr<ConstSource>> srcs;
+        std::vector<u8> prio;
+        std::vector<float> gain;
+        AudioMixer mixer(samples);
+        mixer.SetDuckGain(duck);
+        for (int k = 0; k < AudioMixer::MAX_SOURCES; ++k) {
+            srcs.push_back(std::make_shared<ConstSource>(samples, k + 1));
+            prio.push_back((u8)(k % 4 == 0 ? 10 : 1));
+            gain.push_back(0.25f + 0.1f * k);
+            mixer.AddSource(srcs.back(), prio.back(), gain.back());
+        }
+
+        std::vector<i16> out(samples), ref;
+        mixer.Mix(out.data());
+        MixReference(srcs, prio, gain, duck, samples, ref);
+        if (out != ref) {
+            printf("Mix mismatch against scalar reference\n");
+            ok = false;
+        }
+    }
+
+    printf("Kernel %s, %u Hz, %u ms frame (%u samples), %u frames per case\n",
+        kernel, rate, frameMs, samples, frames);
+    printf("%8s %12s %16s\n", "Sources", "ns/frame", "sources/core");
+
+    const int counts[] = { 1, 2, 4, 8, 16 };
+    for (int n : counts) {
+        AudioMixer mixer(samples);
+        for (int k = 0; k < n; ++k) {
+            mixer.AddSource(std::make_shared<ConstSource>(samples, k + 1), 1, 0.8f);
+        }
+
+        std::vector<i16> out(samples);
+        i32 acc = 0;
+        Clock::time_point t0 = Clock::now();
+        for (u32 i = 0; i < frames; ++i) {
+            mixer.Mix(out.data());
+            acc += out[i % samples];
+        }
+        double ns = std::chrono::duration<double, std::nano>(Clock::now() - t0).count() / frames;
+        g_sink = acc;
+
+        // 一帧的实时预算内可混合的路数 (按每路平均耗时线性外推)
+        double perCore = (double)frameMs * 1e6 / (ns / n);
+        printf("%8d %12.0f %16.0f\n", n, ns, perCore);
+    }
+
+    return ok ? 0 : 2;
+}
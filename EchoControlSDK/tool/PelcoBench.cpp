@@ -0,0 +1,152 @@
+#define _CRT_SECURE_NO_WARNINGS
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <vector>
+#include "protocol/PelcoFrameParser.h"
+
+USING_ECCS
+
+// --------------------------------------------------------
+// Pelco-D 分帧吞吐与重组校验工具
+// 对比逐字节参考实现与 PelcoFrameParser 的吞吐，
+// 并以随机切分点 (1..300 字节) 分段喂入，校验帧序列与参考实现完全一致
+// 用法: PelcoBench [megabytes=64] [trials=1000]
+// --------------------------------------------------------
+
+typedef std::chrono::steady_clock Clock;
+
+static volatile u32 g_sink;
+
+static const u32 FRAME_LEN = PelcoFrameParser::FRAME_LEN;
+
+static void PutFrame(std::vector<u8>& out)
+{
+    u8 f[FRAME_LEN];
+    f[0] = PelcoFrameParser::SYNC;
+    for (u32 i = 1; i < 6; ++i) f[i] = (u8)rand();
+    f[6] = PelcoFrameParser::Checksum(f);
+    out.insert(out.end(), f, f + FRAME_LEN);
+}
+
+// 有效帧为主，混入噪声、孤立 0xFF 与校验错误的帧
+static void MakeStream(u32 frames, bool noisy, std::vector<u8>& out)
+{
+    out.clear();
+    for (u32 n = 0; n < frames; ++n) {
+        if (noisy) {
+            int r = rand() % 16;
+            if (r == 0) {
+                for (int k = rand() % 9; k > 0; --k) out.push_back((u8)rand());
+            }
+            else if (r == 1) {
+                out.push_back(PelcoFrameParser::SYNC);
+            }
+            else if (r == 2) {
+                PutFrame(out);
+                out.back() ^= (u8)(1 + rand() % 255);
+                continue;
+            }
+        }
+        PutFrame(out);
+    }
+}
+
+// 逐字节参考实现: 遇 0xFF 且校验通过即取一帧，否则前移 1 字节
+static void ReferenceParse(const std::vector<u8>& s, std::vector<u8>& frames)
+{
+    frames.clear();
+    size_t i = 0;
+    while (i + FRAME_LEN <= s.size()) {
+        if (s[i] == PelcoFrameParser::SYNC && PelcoFrameParser::Checksum(&s[i]) == s[i + 6]) {
+            frames.insert(frames.end(), &s[i], &s[i] + FRAME_LEN);
+            i += FRAME_LEN;
+        }
+        else {
+            ++i;
+        }
+    }
+}
+
+// 随机切分喂入，返回重组出的帧序列是否与参考一致
+static bool SplitCheck(const std::vector<u8>& s, const std::vector<u8>& expect)
+{
+    std::vector<u8> got;
+    PelcoFrameParser parser([&got](const u8* f) { got.insert(got.end(), f, f + FRAME_LEN); });
+
+    size_t pos = 0;
+    while (pos < s.size()) {
+        size_t n = 1 + rand() % 300;
+        if (n > s.size() - pos) n = s.size() - pos;
+        parser.Feed(s.data() + pos, (u32)n);
+        pos += n;
+    }
+    return got == expect;
+}
+
+int main(int argc, char* argv[])
+{
+    u64 total = (argc > 1 ? (u64)atoi(argv[1]) : 64) << 20;
+    u32 trials = argc > 2 ? (u32)atoi(argv[2]) : 1000;
+    if (total == 0) {
+        printf("Usage: %s [megabytes=64] [trials=1000]\n", argv[0]);
+        return 1;
+    }
+
+    srand(1);
+
+    // 1. 随机切分点重组校验
+    u32 failed = 0;
+    std::vector<u8> stream, expect;
+    for (u32 t = 0; t < trials; ++t) {
+        MakeStream(50 + rand() % 400, t % 4 != 0, stream);
+        ReferenceParse(stream, expect);
+        if (!SplitCheck(stream, expect)) {
+            if (failed == 0) printf("Split check failed at trial %u (%zu bytes)\n", t, stream.size());
+            ++failed;
+        }
+    }
+    printf("Split check: %u/%u trials passed\n", trials - failed, trials);
+
+    // 2. 吞吐: 背靠背有效帧，一次性与按 64 字节 (串口单次读取) 分段喂入
+    MakeStream(1 << 16, false, stream);
+    u64 rounds = std::max<u64>(1, total / stream.size());
+    printf("Stream %zu bytes, %llu MB per case\n", stream.size(), (unsigned long long)(total >> 20));
+    printf("%-24s %8s %12s\n", "Parser", "GB/s", "Mframes/s");
+
+    struct Case {
+        const char* name;
+        u32 chunk;   // 0 = 参考实现
+    };
+    const Case cases[] = {
+        { "Reference (bytewise)", 0 },
+        { "PelcoFrameParser",     0xFFFFFFFF },
+        { "PelcoFrameParser/64",  64 },
+    };
+
+    for (const Case& c : cases) {
+        u32 acc = 0;
+        PelcoFrameParser parser([&acc](const u8* f) { acc += f[2]; });
+
+        Clock::time_point t0 = Clock::now();
+        for (u64 r = 0; r < rounds; ++r) {
+            if (c.chunk == 0) {
+                ReferenceParse(stream, expect);
+                acc += (u32)expect.size();
+                continue;
+            }
+            for (size_t pos = 0; pos < stream.size(); pos += c.chunk) {
+                size_t n = std::min<size_t>(c.chunk, stream.size() - pos);
+                parser.Feed(stream.data() + pos, (u32)n);
+            }
+        }
+        double sec = std::chrono::duration<double>(Clock::now() - t0).count();
+        g_sink = acc;
+
+        double bytes = (double)rounds * stream.size();
+        printf("%-24s %8.2f %12.1f\n", c.name, bytes / sec / 1e9, bytes / FRAME_LEN / sec / 1e6);
+    }
+
+    return failed == 0 ? 0 : 2;
+}
@@ -0,0 +1,214 @@
+#define _CRT_SECURE_NO_WARNINGS
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <functional>
+#include <memory>
+#include <string>
+#include <vector>
+#include "protocol/PacketView.hpp"
+
+USING_ECCS
+
+// --------------------------------------------------------
+// 线上编码体积对比工具 (不需要网关)
+// 按典型指令组合编码请求与应答，对比定长帧与紧凑帧每条指令的字节数，
+// (紧凑帧另列附带 CRC32C 的 v2)，并校验紧凑编码往返解码后与原包一致
+// 用法: WireBench [iterations=200000]
+// --------------------------------------------------------
+
+typedef std::chrono::steady_clock Clock;
+
+struct MixItem {
+    const char* name;
+    u32 weight;                                         // 占比 (%)
+    std::function<std::shared_ptr<rpc::RpcPacket>()> make;
+    bool hasReply;                                      // Query 类结果随推送返回
+};
+
+template<typename TPacket>
+static std::shared_ptr<rpc::RpcPacket> MakePacket(const typename TPacket::Data_Type& d)
+{
+    auto pkt = std::make_shared<TPacket>(d);
+    pkt->SetSeq(1234);
+    return pkt;
+}
+
+template<typename TData>
+static TData Zeroed()
+{
+    TData d;
+    memset(&d, 0, sizeof(d));
+    return d;
+}
+
+static std::vector<MixItem> TypicalMix()
+{
+    std::vector<MixItem> mix;
+
+    mix.push_back({ "PtzVelocity", 35, [] {
+        rpc::PtzVelocity v; v.pan = 24; v.tilt = -8;
+        return MakePacket<rpc::RqPtzVelocity>(v); }, true });
+    mix.push_back({ "PtzMove", 10, [] {
+        rpc::PtzMotion m; m.action = 3; m.speed = 32;
+        return MakePacket<rpc::RqPtzMove>(m); }, true });
+    mix.push_back({ "PtzPreset", 5, [] {
+        rpc::PtzPreset p; p.action = 2; p.index = 3;
+        return MakePacket<rpc::RqPtzPreset>(p); }, true });
+    mix.push_back({ "LightSwitch", 10, [] {
+        return MakePacket<rpc::RqLightSwitch>(true); }, true });
+    mix.push_back({ "LightLevel", 10, [] {
+        return MakePacket<rpc::RqLightLevel>((u8)80); }, true });
+    mix.push_back({ "SoundPlay", 10, [] {
+        auto d = Zeroed<rpc::SoundPlayCtrl>();
+        strcpy(d.filename, "alarm_01.mp3");
+        d.loop = 1;
+        return MakePacket<rpc::RqSoundPlay>(d); }, true });
+    mix.push_back({ "SoundTTS", 5, [] {
+        auto d = Zeroed<rpc::SoundTTSCtrl>();
+        strcpy(d.text, "Restricted area, please leave immediately");
+        return MakePacket<rpc::RqSoundTTS>(d); }, true });
+    mix.push_back({ "UltrasonicMask", 5, [] {
+        rpc::UltrasonicMask m; m.mask = 0x0F;
+        return MakePacket<rpc::RqUltrasonicMask>(m); }, true });
+    mix.push_back({ "QueryPtzPos", 10, [] {
+        return MakePacket<rpc::RqQueryPtzPos>(rpc::NoneData()); }, false });
+
+    return mix;
+}
+
+// 网关对成功请求的应答 (紧凑编码下不带描述文字)
+static std::shared_ptr<rpc::RpcPacket> MakeReply(bool compact)
+{
+    auto r = Zeroed<rpc::Result>();
+    if (!compact) strcpy(r.msg, "Success");
+    return MakePacket<rpc::RpLightLevel>(r);
+}
+
+static size_t FixedSize(rpc::RpcPacket& pkt)
+{
+    Buffer buf;
+    pkt.Encode(buf);
+    return buf.size();
+}
+
+static size_t CompactSize(const rpc::RpcPacket& pkt, u8 version)
+{
+    Buffer buf;
+    pkt.EncodeCompact(buf, version);
+    return buf.size();
+}
+
+// 紧凑编码往返: 解码后按定长编码比较
+static bool RoundTrip(rpc::RpcPacket& pkt, u8 version)
+{
+    Buffer compact;
+    if (!pkt.EncodeCompact(compact, version)) return false;
+
+    rpc::RawPacketView view;
+    if (view.Parse((const u8*)compact.buf(), compact.size()) != rpc::RawPacketView::VIEW_OK) return false;
+    if (view.Version() != version || view.FrameLen() != compact.size()) return false;
+
+    std::shared_ptr<rpc::RpcPacket> back = view.Materialize();
+    if (!back) return false;
+
+    Buffer a, b;
+    pkt.Encode(a);
+    back->Encode(b);
+    return a.size() == b.size() && memcmp(a.buf(), b.buf(), a.size()) == 0;
+}
+
+// 编解码耗时 (按组合轮转)
+static void TimeCodec(const std::vector<std::shared_ptr<rpc::RpcPacket>>& pkts, u32 iterations, u8 version)
+{
+    Buffer buf(64 * 1024);
+    size_t bytes = 0;
+    Clock::time_point t0 = Clock::now();
+    for (u32 i = 0; i < iterations; ++i) {
+        buf.clear();
+        pkts[i % pkts.size()]->EncodeCompact(buf, version);
+        bytes += buf.size();
+    }
+    double encNs = std::chrono::duration<double, std::nano>(Clock::now() - t0).count() / iterations;
+
+    // 预先编码一轮，再反复解码 (v2 解析时校验 CRC)
+    Buffer frames;
+    for (auto& p : pkts) p->EncodeCompact(frames, version);
+    std::vector<std::shared_ptr<rpc::RpcPacket>> decoded;
+    for (auto& p : pkts) decoded.push_back(std::shared_ptr<rpc::RpcPacket>(rpc::FACTORY_CREATE(p->GetID(), RpcPacket)));
+
+    u32 rounds = std::max<u32>(1, iterations / (u32)pkts.size());
+    u64 decodedCount = 0;
+    t0 = Clock::now();
+    for (u32 r = 0; r < rounds; ++r) {
+        const u8* p = (const u8*)frames.buf();
+        size_t left = frames.size();
+        for (size_t i = 0; left > 0; ++i) {
+            rpc::RawPacketView view;
+            if (view.Parse(p, left) != rpc::RawPacketView::VIEW_OK) break;
+            if (decoded[i]->DecodeCompact(view.Body(), view.BodyLen())) ++decodedCount;
+            p += view.FrameLen();
+            left -= view.FrameLen();
+        }
+    }
+    double decNs = std::chrono::duration<double, std::nano>(Clock::now() - t0).count() / (rounds * pkts.size());
+
+    printf("Compact v%u encode: %.0f ns/packet, decode: %.0f ns/packet (%llu decoded, %zu bytes encoded)\n",
+        (u32)version, encNs, decNs, (unsigned long long)decodedCount, bytes);
+}
+
+int main(int argc, char* argv[])
+{
+    u32 iterations = argc > 1 ? (u32)atoi(argv[1]) : 200000;
+    if (iterations == 0) {
+        printf("Usage: %s [iterations=200000]\n", argv[0]);
+        return 1;
+    }
+
+    std::vector<MixItem> mix = TypicalMix();
+    std::shared_ptr<rpc::RpcPacket> fixedReply = MakeReply(false);
+    std::shared_ptr<rpc::RpcPacket> compactReply = MakeReply(true);
+    size_t fixedRp = FixedSize(*fixedReply);
+    size_t compactRp = CompactSize(*compactReply, rpc::COMPACT_VERSION_PLAIN);
+    size_t crcRp = CompactSize(*compactReply, rpc::COMPACT_VERSION_CRC);
+
+    printf("%-16s %6s  %10s  %10s  %10s  %7s\n", "Command", "Mix", "Fixed(B)", "Compact(B)", "+CRC(B)", "Ratio");
+
+    double fixedAvg = 0, compactAvg = 0, crcAvg = 0;
+    u32 totalWeight = 0;
+    bool ok = true;
+    for (MixItem& item : mix) {
+        std::shared_ptr<rpc::RpcPacket> pkt = item.make();
+        if (!RoundTrip(*pkt, rpc::COMPACT_VERSION_PLAIN) || !RoundTrip(*pkt, rpc::COMPACT_VERSION_CRC)) {
+            printf("%s: compact round trip mismatch\n", item.name);
+            ok = false;
+        }
+
+        size_t f = FixedSize(*pkt) + (item.hasReply ? fixedRp : 0);
+        size_t c = CompactSize(*pkt, rpc::COMPACT_VERSION_PLAIN) + (item.hasReply ? compactRp : 0);
+        size_t k = CompactSize(*pkt, rpc::COMPACT_VERSION_CRC) + (item.hasReply ? crcRp : 0);
+        printf("%-16s %5u%%  %10zu  %10zu  %10zu  %6.1f%%\n", item.name, item.weight, f, c, k, 100.0 * c / f);
+
+        fixedAvg += (double)f * item.weight;
+        compactAvg += (double)c * item.weight;
+        crcAvg += (double)k * item.weight;
+        totalWeight += item.weight;
+    }
+    fixedAvg /= totalWeight;
+    compactAvg /= totalWeight;
+    crcAvg /= totalWeight;
+
+    printf("\nBytes/command (request + reply, weighted): fixed %.1f, compact %.1f (%.1f%%), compact+crc %.1f (%.1f%%)\n",
+        fixedAvg, compactAvg, 100.0 * compactAvg / fixedAvg, crcAvg, 100.0 * crcAvg / fixedAvg);
+
+    std::vector<std::shared_ptr<rpc::RpcPacket>> pkts;
+    for (MixItem& item : mix) {
+        for (u32 i = 0; i < item.weight; ++i) pkts.push_back(item.make());
+    }
+    TimeCodec(pkts, iterations, rpc::COMPACT_VERSION_PLAIN);
+    TimeCodec(pkts, iterations, rpc::COMPACT_VERSION_CRC);
+
+    return ok ? 0 : 2;
+}